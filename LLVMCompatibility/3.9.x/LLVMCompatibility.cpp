@@ -12,5 +12,22 @@ JITSymbolFlags JITSymbolFlagsFromObjectSymbol(const object::BasicSymbolRef &symb
   return orc::JITSymbol::flagsFromObjectSymbol(symbol);
 }
 
+std::unique_ptr<Module> parseLazyBitcodeFile(MemoryBufferRef buffer,
+                                             LLVMContext &context) {
+  auto moduleOrError =
+    getLazyBitcodeModule(MemoryBuffer::getMemBuffer(buffer, false), context);
+  if (!moduleOrError) {
+    return nullptr;
+  }
+  return std::move(moduleOrError.get());
 }
 
+bool materialize(GlobalValue &value) {
+  return !value.materialize();
+}
+
+bool materializeAll(Module &module) {
+  return !module.materializeAll();
+}
+
+}
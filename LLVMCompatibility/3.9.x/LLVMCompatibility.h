@@ -3,6 +3,7 @@
 #include <llvm/ExecutionEngine/RuntimeDyld.h>
 #include <llvm/ExecutionEngine/Orc/JITSymbol.h>
 #include <llvm/Bitcode/ReaderWriter.h>
+#include <llvm/IR/Module.h>
 
 namespace llvm_compat {
   using namespace llvm;
@@ -13,5 +14,10 @@ namespace llvm_compat {
 
   uint64_t JITSymbolAddress(JITSymbol &symbol);
   JITSymbolFlags JITSymbolFlagsFromObjectSymbol(const object::BasicSymbolRef &symbol);
+
+  std::unique_ptr<Module> parseLazyBitcodeFile(MemoryBufferRef buffer,
+                                               LLVMContext &context);
+  bool materialize(GlobalValue &value);
+  bool materializeAll(Module &module);
 }
 
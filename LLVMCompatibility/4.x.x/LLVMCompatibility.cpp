@@ -12,5 +12,30 @@ JITSymbolFlags JITSymbolFlagsFromObjectSymbol(const object::BasicSymbolRef &symb
   return JITSymbolFlags::fromObjectSymbol(symbol);
 }
 
+std::unique_ptr<Module> parseLazyBitcodeFile(MemoryBufferRef buffer,
+                                             LLVMContext &context) {
+  auto moduleOrError = getLazyBitcodeModule(buffer, context);
+  if (!moduleOrError) {
+    consumeError(moduleOrError.takeError());
+    return nullptr;
+  }
+  return std::move(moduleOrError.get());
 }
 
+bool materialize(GlobalValue &value) {
+  if (auto error = value.materialize()) {
+    consumeError(std::move(error));
+    return false;
+  }
+  return true;
+}
+
+bool materializeAll(Module &module) {
+  if (auto error = module.materializeAll()) {
+    consumeError(std::move(error));
+    return false;
+  }
+  return true;
+}
+
+}
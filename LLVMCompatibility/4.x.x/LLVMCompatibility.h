@@ -2,6 +2,7 @@
 
 #include <llvm/ExecutionEngine/RuntimeDyld.h>
 #include <llvm/Bitcode/BitcodeReader.h>
+#include <llvm/IR/Module.h>
 
 namespace llvm_compat {
   using namespace llvm;
@@ -12,5 +13,10 @@ namespace llvm_compat {
 
   uint64_t JITSymbolAddress(JITSymbol &symbol);
   JITSymbolFlags JITSymbolFlagsFromObjectSymbol(const object::BasicSymbolRef &symbol);
+
+  std::unique_ptr<Module> parseLazyBitcodeFile(MemoryBufferRef buffer,
+                                               LLVMContext &context);
+  bool materialize(GlobalValue &value);
+  bool materializeAll(Module &module);
 }
 
@@ -28,6 +28,8 @@ struct ParallelizationConfig {
   int workers;
   int testExecutionWorkers;
   int mutantExecutionWorkers;
+  int mutantCompilationWorkers;
+  int mutantTestWorkers;
   ParallelizationConfig();
   static ParallelizationConfig defaultConfig();
   void normalize();
@@ -70,6 +72,27 @@ public:
     Disabled,
     Enabled
   };
+  enum class ForkServerMode {
+    Disabled,
+    Enabled
+  };
+  enum class BatchedSandboxMode {
+    Disabled,
+    Enabled
+  };
+  enum class IncrementalLinking {
+    Disabled,
+    Enabled
+  };
+  enum class MutantCompilation {
+    Module,
+    Function,
+    Schemata
+  };
+  enum class TrivialCompilerEquivalenceMode {
+    Disabled,
+    Enabled
+  };
   enum class DryRunMode {
     Disabled,
     Enabled
@@ -92,13 +115,23 @@ public:
     Killed,
     All
   };
+  enum class ReportOutput {
+    All,
+    Killed
+  };
 
   static std::string forkToString(Fork fork);
+  static std::string forkServerToString(ForkServerMode forkServer);
+  static std::string batchedSandboxToString(BatchedSandboxMode batchedSandbox);
+  static std::string incrementalLinkingToString(IncrementalLinking incrementalLinking);
+  static std::string mutantCompilationToString(MutantCompilation mutantCompilation);
+  static std::string trivialCompilerEquivalenceToString(TrivialCompilerEquivalenceMode mode);
   static std::string dryRunToString(DryRunMode dryRun);
   static std::string failFastToString(FailFastMode failFast);
   static std::string cachingToString(UseCache caching);
   static std::string emitDebugInfoToString(EmitDebugInfo emitDebugInfo);
   static std::string diagnosticsToString(Diagnostics diagnostics);
+  static std::string reportOutputToString(ReportOutput reportOutput);
 private:
   std::string bitcodeFileList;
 
@@ -114,15 +147,28 @@ private:
   std::vector<CustomTestDefinition> customTests;
 
   Fork fork;
+  ForkServerMode forkServer;
+  BatchedSandboxMode batchedSandbox;
+  IncrementalLinking incrementalLinking;
+  MutantCompilation mutantCompilation;
+  TrivialCompilerEquivalenceMode trivialCompilerEquivalence;
   DryRunMode dryRun;
   FailFastMode failFast;
   UseCache caching;
   EmitDebugInfo emitDebugInfo;
   Diagnostics diagnostics;
+  ReportOutput reportOutput;
 
   int timeout;
+  int mutantTimeoutMultiplier;
+  int mutantTimeoutFloor;
   int maxDistance;
+  int maxOutputSize;
+  int cacheSizeLimit;
   std::string cacheDirectory;
+  std::string historyFile;
+  std::string journalFile;
+  bool resume;
 
   JunkDetectionConfig junkDetection;
   ParallelizationConfig parallelizationConfig;
@@ -156,6 +202,8 @@ public:
   const std::string &getProjectName() const;
   const std::string &getTestFramework() const;
   std::string getCacheDirectory() const;
+  const std::string &getHistoryFile() const;
+  const std::string &getJournalFile() const;
 
   const std::string &getBitcodeFileList() const;
   const std::string &getObjectFileList() const;
@@ -176,19 +224,33 @@ public:
 
   JunkDetectionConfig &junkDetectionConfig();
   Diagnostics getDiagnostics() const;
+  ReportOutput getReportOutput() const;
+  MutantCompilation getMutantCompilation() const;
   const ParallelizationConfig parallelization() const;
 
   int getTimeout() const;
+  int getMutantTimeoutMultiplier() const;
+  int getMutantTimeoutFloor() const;
   int getMaxDistance() const;
+  int getMaxOutputSize() const;
+  int getCacheSizeLimit() const;
 
   bool forkEnabled() const;
+  bool forkServerEnabled() const;
+  bool batchedSandboxEnabled() const;
+  bool incrementalLinkingEnabled() const;
   bool cachingEnabled() const;
+  bool historyEnabled() const;
+  bool journalEnabled() const;
+  bool resumeEnabled() const;
+  bool trivialCompilerEquivalenceEnabled() const;
   bool dryRunModeEnabled() const;
   bool failFastModeEnabled() const;
   bool shouldEmitDebugInfo() const;
   bool junkDetectionEnabled() const;
 
   void normalizeParallelizationConfig();
+  void setResume(bool enabled);
 
   std::vector<std::string> validate();
   void dump() const;
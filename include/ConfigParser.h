@@ -71,6 +71,55 @@ struct ScalarEnumerationTraits<mull::Config::Fork> {
   }
 };
 
+template <>
+struct ScalarEnumerationTraits<mull::Config::ForkServerMode> {
+  static void enumeration(IO &io, mull::Config::ForkServerMode &value) {
+    io.enumCase(value, "true",  mull::Config::ForkServerMode::Enabled);
+    io.enumCase(value, "enabled",  mull::Config::ForkServerMode::Enabled);
+    io.enumCase(value, "false",  mull::Config::ForkServerMode::Disabled);
+    io.enumCase(value, "disabled",  mull::Config::ForkServerMode::Disabled);
+  }
+};
+
+template <>
+struct ScalarEnumerationTraits<mull::Config::BatchedSandboxMode> {
+  static void enumeration(IO &io, mull::Config::BatchedSandboxMode &value) {
+    io.enumCase(value, "true",  mull::Config::BatchedSandboxMode::Enabled);
+    io.enumCase(value, "enabled",  mull::Config::BatchedSandboxMode::Enabled);
+    io.enumCase(value, "false",  mull::Config::BatchedSandboxMode::Disabled);
+    io.enumCase(value, "disabled",  mull::Config::BatchedSandboxMode::Disabled);
+  }
+};
+
+template <>
+struct ScalarEnumerationTraits<mull::Config::TrivialCompilerEquivalenceMode> {
+  static void enumeration(IO &io, mull::Config::TrivialCompilerEquivalenceMode &value) {
+    io.enumCase(value, "true",  mull::Config::TrivialCompilerEquivalenceMode::Enabled);
+    io.enumCase(value, "enabled",  mull::Config::TrivialCompilerEquivalenceMode::Enabled);
+    io.enumCase(value, "false",  mull::Config::TrivialCompilerEquivalenceMode::Disabled);
+    io.enumCase(value, "disabled",  mull::Config::TrivialCompilerEquivalenceMode::Disabled);
+  }
+};
+
+template <>
+struct ScalarEnumerationTraits<mull::Config::IncrementalLinking> {
+  static void enumeration(IO &io, mull::Config::IncrementalLinking &value) {
+    io.enumCase(value, "true",  mull::Config::IncrementalLinking::Enabled);
+    io.enumCase(value, "enabled",  mull::Config::IncrementalLinking::Enabled);
+    io.enumCase(value, "false",  mull::Config::IncrementalLinking::Disabled);
+    io.enumCase(value, "disabled",  mull::Config::IncrementalLinking::Disabled);
+  }
+};
+
+template <>
+struct ScalarEnumerationTraits<mull::Config::MutantCompilation> {
+  static void enumeration(IO &io, mull::Config::MutantCompilation &value) {
+    io.enumCase(value, "module",  mull::Config::MutantCompilation::Module);
+    io.enumCase(value, "function",  mull::Config::MutantCompilation::Function);
+    io.enumCase(value, "schemata",  mull::Config::MutantCompilation::Schemata);
+  }
+};
+
 template <>
 struct ScalarEnumerationTraits<mull::Config::DryRunMode> {
   static void enumeration(IO &io, mull::Config::DryRunMode &value) {
@@ -119,12 +168,22 @@ struct ScalarEnumerationTraits<mull::Config::Diagnostics> {
   }
 };
 
+template <>
+struct ScalarEnumerationTraits<mull::Config::ReportOutput> {
+  static void enumeration(IO &io, mull::Config::ReportOutput &value) {
+    io.enumCase(value, "all",    mull::Config::ReportOutput::All);
+    io.enumCase(value, "killed", mull::Config::ReportOutput::Killed);
+  }
+};
+
 template<>
 struct MappingTraits<mull::ParallelizationConfig> {
   static void mapping(IO &io, mull::ParallelizationConfig &config) {
     io.mapOptional("workers", config.workers);
     io.mapOptional("test_execution_workers", config.testExecutionWorkers);
     io.mapOptional("mutant_execution_workers", config.mutantExecutionWorkers);
+    io.mapOptional("mutant_compilation_workers", config.mutantCompilationWorkers);
+    io.mapOptional("mutant_test_workers", config.mutantTestWorkers);
   }
 };
 
@@ -144,14 +203,26 @@ struct MappingTraits<mull::Config>
     io.mapOptional("exclude_locations", config.excludeLocations);
     io.mapOptional("custom_tests", config.customTests);
     io.mapOptional("fork", config.fork);
+    io.mapOptional("fork_server", config.forkServer);
+    io.mapOptional("batched_sandbox", config.batchedSandbox);
+    io.mapOptional("incremental_linking", config.incrementalLinking);
+    io.mapOptional("mutant_compilation", config.mutantCompilation);
+    io.mapOptional("trivial_compiler_equivalence", config.trivialCompilerEquivalence);
     io.mapOptional("dry_run", config.dryRun);
     io.mapOptional("fail_fast", config.failFast);
     io.mapOptional("use_cache", config.caching);
     io.mapOptional("emit_debug_info", config.emitDebugInfo);
     io.mapOptional("diagnostics", config.diagnostics);
+    io.mapOptional("report_output", config.reportOutput);
     io.mapOptional("timeout", config.timeout);
+    io.mapOptional("mutant_timeout_multiplier", config.mutantTimeoutMultiplier);
+    io.mapOptional("mutant_timeout_floor", config.mutantTimeoutFloor);
     io.mapOptional("max_distance", config.maxDistance);
+    io.mapOptional("max_output_size", config.maxOutputSize);
     io.mapOptional("cache_directory", config.cacheDirectory);
+    io.mapOptional("cache_size_limit", config.cacheSizeLimit);
+    io.mapOptional("history_file", config.historyFile);
+    io.mapOptional("journal_file", config.journalFile);
     io.mapOptional("junk_detection", config.junkDetection);
     io.mapOptional("parallelization", config.parallelizationConfig);
   }
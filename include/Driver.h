@@ -33,6 +33,11 @@ class TestRunner;
 class MutationsFinder;
 class Metrics;
 class JunkDetector;
+class MutationHistory;
+class MutationJournal;
+class Reporter;
+class ResultStream;
+class Testee;
 
 class Driver {
   Config &config;
@@ -47,12 +52,24 @@ class Driver {
   IDEDiagnostics *diagnostics;
 
   std::map<llvm::Module *, llvm::object::ObjectFile *> innerCache;
+  /// Mutation points woven into each module when compiling mutant schemata
+  std::map<llvm::Module *, std::vector<MutationPoint *>> schemata;
+  std::map<MutationPoint *, int> schemataIDs;
   std::vector<llvm::object::OwningBinary<llvm::object::ObjectFile>> precompiledObjectFiles;
   std::vector<llvm::object::OwningBinary<llvm::object::ObjectFile>> instrumentedObjectFiles;
   std::vector<llvm::object::OwningBinary<llvm::object::ObjectFile>> ownedObjectFiles;
   Instrumentation instrumentation;
   Metrics &metrics;
   JunkDetector &junkDetector;
+
+  std::vector<Reporter *> reporters;
+  /// Set while the mutants run, results go through it to the reporters
+  ResultStream *resultStream;
+  MutationHistory *history;
+  MutationJournal *journal;
+  /// Results still expected for each mutant, and whether any test killed it
+  std::map<MutationPoint *, size_t> pendingResults;
+  std::map<MutationPoint *, bool> killedMutants;
 public:
   Driver(Config &C,
          ModuleLoader &ML,
@@ -68,24 +85,56 @@ public:
 
   std::unique_ptr<Result> Run();
 
+  /// Reporters get the results as the mutants complete
+  void addReporter(Reporter *reporter);
+
+  /// Called by the workers for each result they get
+  void streamResult(MutationResult *result);
+
   /// Returns cached object files for all modules excerpt one provided
   std::vector<llvm::object::ObjectFile *> AllButOne(llvm::Module *One);
+
+  /// Returns the ID of a mutant woven into its module, or 0 otherwise
+  int schemataID(MutationPoint *mutationPoint);
 private:
   void loadBitcodeFilesIntoMemory();
   void compileInstrumentedBitcodeFiles();
   void loadPrecompiledObjectFiles();
   void loadDynamicLibraries();
+  void measurePrecompiledObjectFiles();
+  void measureLoadedModules();
 
   std::vector<std::unique_ptr<Test>> findTests();
   std::vector<MutationPoint *> findMutationPoints(std::vector<std::unique_ptr<Test>> &tests);
+  std::vector<std::unique_ptr<Testee>> runOriginalTests(std::vector<std::unique_ptr<Test>> &tests);
   std::vector<MutationPoint *> filterOutJunkMutations(std::vector<MutationPoint *> mutationPoints);
 
   std::vector<std::unique_ptr<MutationResult>> runMutations(std::vector<MutationPoint *> &mutationPoints);
+  void reportMutationResult(MutationResult &result);
 
   std::vector<llvm::object::ObjectFile *> AllInstrumentedObjectFiles();
+  std::vector<llvm::object::ObjectFile *> stableObjectFiles(const std::vector<MutationPoint *> &mutationPoints);
+  void weaveSchemata(const std::vector<MutationPoint *> &mutationPoints);
 
   std::vector<std::unique_ptr<MutationResult>> dryRunMutations(const std::vector<MutationPoint *> &mutationPoints);
   std::vector<std::unique_ptr<MutationResult>> normalRunMutations(const std::vector<MutationPoint *> &mutationPoints);
+  std::vector<MutationPoint *> resumeMutationResults(MutationJournal &journal,
+                                                     const std::vector<MutationPoint *> &mutationPoints,
+                                                     std::vector<std::unique_ptr<MutationResult>> &mutationResults);
+  std::vector<MutationPoint *> reuseMutationResults(MutationHistory &history,
+                                                    const std::vector<MutationPoint *> &mutationPoints,
+                                                    std::vector<std::unique_ptr<MutationResult>> &mutationResults);
+  std::vector<std::unique_ptr<MutationResult>> executeMutations(const std::vector<MutationPoint *> &mutationPoints);
+
+public:
+  /// Sorts the mutants by the running time of their tests, longest first
+  static std::vector<MutationPoint *> longestFirst(const std::vector<MutationPoint *> &mutationPoints);
+
+  /// The candidates that need no symbol from the unstable object files,
+  /// neither directly nor through other candidates
+  static std::vector<llvm::object::ObjectFile *>
+  withoutUnstableDependencies(std::vector<llvm::object::ObjectFile *> candidates,
+                              const std::vector<llvm::object::ObjectFile *> &unstable);
 };
 
 }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <string>
 
 namespace mull {
@@ -11,16 +12,49 @@ namespace mull {
     Crashed = 4,
     AbnormalExit = 5,
     DryRun = 6,
-    FailFast = 7
+    FailFast = 7,
+    Equivalent = 8,
+    Duplicate = 9
   };
 
+  /// Mutants not run because of trivial compiler equivalence,
+  /// and the ones not run at all, are not killed by any test
+  inline bool killsMutant(ExecutionStatus status) {
+    return status != Passed && status != DryRun &&
+           status != Equivalent && status != Duplicate;
+  }
+
   struct ExecutionResult {
     ExecutionStatus status;
     int exitStatus;
     long long runningTime;
     std::string stdoutOutput;
     std::string stderrOutput;
-    ExecutionResult() : status(ExecutionStatus::Invalid), exitStatus(0), runningTime(0) {}
+    /// CPU time of the test in microseconds, timeouts of the mutants are
+    /// based on the one measured against the original program
+    long long cpuTime;
+
+    /// Where the running time went, in microseconds. Measured by
+    /// the sandbox for the metrics, never stored
+    long long forkTime;
+    long long testRunTime;
+    long long outputCaptureTime;
+
+    ExecutionResult()
+      : status(ExecutionStatus::Invalid), exitStatus(0), runningTime(0),
+        cpuTime(0), forkTime(0), testRunTime(0), outputCaptureTime(0) {}
+
+    /// Estimated cost of running the test again, in microseconds. Most unit
+    /// tests finish within a millisecond, so the precise times come first,
+    /// the running time is used only when they were not measured.
+    /// Tests that took no measurable time still count.
+    long long cost() const {
+      long long microseconds = std::max(cpuTime, testRunTime);
+      if (microseconds == 0) {
+        microseconds = runningTime * 1000;
+      }
+      return std::max(1LL, microseconds);
+    }
 
     std::string getStatusAsString() {
       switch (this->status) {
@@ -40,6 +74,10 @@ namespace mull {
           return "DryRun";
         case FailFast:
           return "FailFast";
+        case Equivalent:
+          return "Equivalent";
+        case Duplicate:
+          return "Duplicate";
       }
     }
   };
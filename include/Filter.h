@@ -8,10 +8,13 @@
 
 namespace mull {
 
+struct SourceLocation;
+
 class Filter {
 public:
   bool shouldSkipFunction(llvm::Function *function);
   bool shouldSkipInstruction(llvm::Instruction *instruction);
+  bool shouldSkipLocation(const SourceLocation &location);
   bool shouldSkipTest(const std::string &testName);
 
   void skipByName(const std::string &nameSubstring);
@@ -1,5 +1,8 @@
 
+#include <atomic>
+#include <cstddef>
 #include <functional>
+#include <vector>
 #include "ExecutionResult.h"
 
 namespace mull {
@@ -7,23 +10,47 @@ namespace mull {
 class ProcessSandbox {
 public:
   virtual ~ProcessSandbox() {}
+  /// Once the cancelled flag is raised, the run stops and gets
+  /// the FailFast status
   virtual ExecutionResult run(std::function<ExecutionStatus ()> function,
-                              long long timeoutMilliseconds) = 0;
+                              long long timeoutMilliseconds,
+                              const std::atomic<bool> *cancelled = nullptr) = 0;
+
+  /// Runs the functions one after another, each with its own timeout.
+  /// With stopOnFailure, the functions after the first failure do not run
+  /// and get the FailFast status
+  virtual std::vector<ExecutionResult>
+  runBatch(const std::vector<std::function<ExecutionStatus ()>> &functions,
+           const std::vector<long long> &timeouts,
+           bool stopOnFailure);
 };
 
 class ForkProcessSandbox : public ProcessSandbox {
 public:
   const static int MullExitCode = 227;
-  const static int MullTimeoutCode = 239;
+
+  /// The output of a child is captured through pipes, at most
+  /// maxOutputSize bytes per stream are kept (0 means unlimited)
+  explicit ForkProcessSandbox(size_t maxOutputSize = 0);
 
   ExecutionResult run(std::function<ExecutionStatus ()> function,
-                      long long timeoutMilliseconds);
+                      long long timeoutMilliseconds,
+                      const std::atomic<bool> *cancelled = nullptr);
+
+  /// Runs all the functions in a single worker
+  std::vector<ExecutionResult>
+  runBatch(const std::vector<std::function<ExecutionStatus ()>> &functions,
+           const std::vector<long long> &timeouts,
+           bool stopOnFailure);
+private:
+  size_t maxOutputSize;
 };
 
 class NullProcessSandbox : public ProcessSandbox {
 public:
   ExecutionResult run(std::function<ExecutionStatus ()> function,
-                      long long timeoutMilliseconds);
+                      long long timeoutMilliseconds,
+                      const std::atomic<bool> *cancelled = nullptr);
 };
 
 }
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "ExecutionResult.h"
+
+#include <llvm/ADT/StringRef.h>
+
+#include <cstdint>
+#include <functional>
+#include <sys/types.h>
+
+namespace mull {
+
+/// \brief A long-living child process that loads programs and runs tests
+/// on behalf of a worker.
+///
+/// The server is forked from the worker, so it shares all the state of the
+/// worker (compiled modules, test runner, etc.) at that moment. Requests carry
+/// only keys (e.g. pointers into that shared image) and small payloads, such
+/// as an object file of a mutant. The sandboxes forked from the server copy
+/// that image too, so the fork of a test is only cheaper than the one from
+/// the worker by the state the worker builds later.
+///
+/// The handlers do heavy work in the server (linking, symbol lookups), which
+/// is only safe if no other thread held a lock at the time of fork. Hence the
+/// server is only started explicitly, before the worker spawns any threads,
+/// and is never restarted by the requests. A server that fails to load a
+/// program, dies, or does not respond in time is killed and stays down.
+///
+/// The handlers are executed in the server process: the load handler is
+/// expected to link a program, the run handler is expected to run a test
+/// against that program in a sandbox, i.e. in a grandchild of the worker.
+class ForkServer {
+public:
+  typedef std::function<bool (uint64_t key, llvm::StringRef payload)> LoadHandler;
+  typedef std::function<ExecutionResult (uint64_t key,
+                                         long long timeoutMilliseconds)> RunHandler;
+
+  /// Linking a mutant takes well under a second normally
+  static const long long DefaultLoadTimeout = 60 * 1000;
+  /// Added to the timeout of a test, covers the fork of the sandbox
+  /// and sending the output back
+  static const long long DefaultRunTimeoutMargin = 5 * 1000;
+
+  ForkServer(LoadHandler loadHandler, RunHandler runHandler,
+             long long loadTimeout = DefaultLoadTimeout,
+             long long runTimeoutMargin = DefaultRunTimeoutMargin);
+  ~ForkServer();
+
+  ForkServer(const ForkServer &) = delete;
+  ForkServer &operator=(const ForkServer &) = delete;
+
+  /// Returns false if the server is not running or failed to load
+  /// the program, in which case the server is shut down.
+  bool load(uint64_t key, llvm::StringRef payload);
+  /// Returns false if the server is not running, dies, or does not respond
+  /// within the timeout and the margin. The result then tells nothing
+  /// about the test, and the server is shut down.
+  bool run(uint64_t key, long long timeoutMilliseconds, ExecutionResult &result);
+  bool start();
+  void stop();
+
+  bool isRunning() const;
+private:
+  void serve(int input, int output, pid_t parentPID);
+  void shutdown();
+
+  LoadHandler loadHandler;
+  RunHandler runHandler;
+  long long loadTimeout;
+  long long runTimeoutMargin;
+  pid_t serverPID;
+  int requestDescriptor;
+  int responseDescriptor;
+};
+
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace mull {
+
+class Config;
+class Context;
+class ObjectCache;
+class Test;
+class Testee;
+
+/// \brief Results of the instrumented run of the original tests.
+///
+/// The original tests are run to find out which functions each of them
+/// reaches, and how long each of them takes. As long as the program and the
+/// options affecting the run stay the same, so do the results. They are kept
+/// in the object cache under a key made of the module hashes and the options,
+/// so that the next run can skip the instrumented compilation and execution.
+class CallTreeCache {
+public:
+  static const int FormatVersion = 2;
+
+  CallTreeCache(ObjectCache &cache, Context &context, const Config &config);
+
+  /// Restores the execution results of the tests and their testees
+  bool load(std::vector<std::unique_ptr<Test>> &tests,
+            std::vector<std::unique_ptr<Testee>> &testees);
+  void store(std::vector<std::unique_ptr<Test>> &tests,
+             const std::vector<std::unique_ptr<Testee>> &testees);
+
+private:
+  ObjectCache &cache;
+  Context &context;
+  std::string identifier;
+};
+
+}
@@ -4,26 +4,28 @@
 
 namespace llvm {
   class Function;
+  class LLVMContext;
   class Module;
+  class StructType;
   class Value;
 }
 
 namespace mull {
 
-  extern "C" void mull_enterFunction(void **trampoline, uint32_t functionIndex);
-  extern "C" void mull_leaveFunction(void **trampoline, uint32_t functionIndex);
+  struct InstrumentationInfo;
+
+  /// Called by the instrumented code for functions that were not seen yet
+  extern "C" void mull_enterFunction(InstrumentationInfo *info, uint32_t functionIndex);
 
   class Callbacks {
   public:
     void injectCallbacks(llvm::Function *function,
                          uint32_t index,
-                         llvm::Value *infoPointer,
-                         llvm::Value *offset);
+                         llvm::Value *infoPointer);
 
     llvm::Value *injectInstrumentationInfoPointer(llvm::Module *module,
                                                   const char *variableName);
 
-    llvm::Value *injectFunctionIndexOffset(llvm::Module *module,
-                                           const char *functionIndexOffsetPrefix);
+    static llvm::StructType *instrumentationInfoType(llvm::LLVMContext &context);
   };
 }
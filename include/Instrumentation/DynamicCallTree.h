@@ -1,9 +1,9 @@
 #pragma once
 
 #include "Filter.h"
+#include "Instrumentation/InstrumentationInfo.h"
 
 #include <list>
-#include <stack>
 #include <vector>
 
 #include <llvm/IR/Function.h>
@@ -41,12 +41,11 @@ public:
                                                             int distance,
                                                             Filter &filter);
 
-  static void enterFunction(const uint32_t functionIndex,
-                            uint32_t *mapping,
-                            std::stack<uint32_t> &stack);
-  static void leaveFunction(const uint32_t functionIndex,
-                            uint32_t *mapping,
-                            std::stack<uint32_t> &stack);
+  /// The instrumented code does the same inline,
+  /// recordFunction is only called for functions that were not seen yet
+  static void enterFunction(const uint32_t functionIndex, InstrumentationInfo &info);
+  static void leaveFunction(const uint32_t functionIndex, InstrumentationInfo &info);
+  static void recordFunction(const uint32_t functionIndex, InstrumentationInfo &info);
 };
 
 }
@@ -4,6 +4,7 @@
 #include "Instrumentation/DynamicCallTree.h"
 #include "Testee.h"
 
+#include <map>
 #include <vector>
 
 namespace llvm {
@@ -23,6 +24,7 @@ namespace mull {
     void insertCallbacks(llvm::Module *instrumentedModule);
 
     std::vector<std::unique_ptr<Testee>> getTestees(Test *test, Filter &filter, int distance);
+    std::vector<llvm::Function *> getExecutedFunctions(Test *test);
 
     void setupInstrumentationInfo(Test *test);
     void cleanupInstrumentationInfo(Test *test);
@@ -30,7 +32,6 @@ namespace mull {
     std::map<std::string, uint32_t> &getFunctionOffsetMapping();
 
     const char *instrumentationInfoVariableName();
-    const char *functionIndexOffsetPrefix();
   private:
     Callbacks callbacks;
     std::vector<CallTreeFunction> functions;
@@ -1,12 +1,21 @@
 #pragma once
 
 #include <cstdint>
-#include <stack>
 
 namespace mull {
+
+/// The instrumented code accesses the fields directly, the layout must match
+/// the one built by Callbacks::instrumentationInfoType.
+///
+/// The call stack is a ring buffer: only the top MaxCallstackDepth entries
+/// are kept, which is enough to find the caller of a function at any depth.
 struct InstrumentationInfo {
-  InstrumentationInfo() : callTreeMapping(nullptr), callstack() {}
+  static const uint32_t MaxCallstackDepth = 1 << 16;
+
+  InstrumentationInfo()
+    : callTreeMapping(nullptr), callstack(nullptr), callstackDepth(0) {}
   uint32_t *callTreeMapping;
-  std::stack<uint32_t> callstack;
+  uint32_t *callstack;
+  uint32_t callstackDepth;
 };
 }
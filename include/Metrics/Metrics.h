@@ -1,7 +1,10 @@
 #pragma once
 
 #include <chrono>
+#include <cstdint>
 #include <map>
+#include <mutex>
+#include <vector>
 
 namespace llvm {
   class Module;
@@ -26,8 +29,78 @@ struct MetricsMeasure {
   static const char *precision();
 };
 
+/// Modules loaded into one LLVMContext and how much of them was parsed
+struct ContextMemory {
+  ContextMemory();
+
+  uint64_t modules;
+  uint64_t bitcodeSize;
+  uint64_t functions;
+  uint64_t materializedFunctions;
+  uint64_t instructions;
+};
+
+/// Steps of running a mutant whose cost is measured
+enum class MutantPhase {
+  Clone,
+  Mutate,
+  Codegen,
+  Link,
+  Fork,
+  TestRun,
+  OutputCapture
+};
+static const int MutantPhasesCount = 7;
+
+/// Durations in microseconds, bucketed by powers of two
+struct DurationHistogram {
+  static const int BucketsCount = 40;
+
+  DurationHistogram();
+  void add(uint64_t microseconds);
+  void merge(const DurationHistogram &other);
+  /// Upper bound of the bucket the given fraction of the samples fall into
+  uint64_t percentile(double fraction) const;
+
+  uint64_t count;
+  uint64_t total;
+  uint64_t max;
+  uint64_t buckets[BucketsCount];
+};
+
+/// \brief Where the time of running the mutants goes.
+///
+/// Each worker collects its own costs without locking and adds them to
+/// the metrics once done. The clone, mutate and codegen phases are sampled
+/// once per compiled mutant, link once per loaded mutant, and the rest
+/// once per test run.
+struct MutantCosts {
+  MutantCosts();
+  void add(MutantPhase phase, uint64_t microseconds);
+  void merge(const MutantCosts &other);
+
+  static const char *phaseName(MutantPhase phase);
+
+  DurationHistogram phases[MutantPhasesCount];
+  uint64_t cacheHits;
+  uint64_t cacheMisses;
+};
+
+/// Adds the time from construction to destruction to the given phase
+class PhaseTimer {
+public:
+  PhaseTimer(MutantCosts &costs, MutantPhase phase);
+  ~PhaseTimer();
+private:
+  MutantCosts &costs;
+  MutantPhase phase;
+  std::chrono::steady_clock::time_point start;
+};
+
 class Metrics {
 public:
+  Metrics();
+
   void beginLoadModules();
   void endLoadModules();
 
@@ -76,6 +149,15 @@ public:
   void beginRun();
   void endRun();
 
+  void setPrecompiledObjectFilesMemory(uint64_t size, uint64_t residentSize);
+  void setContextsMemory(const std::vector<ContextMemory> &contexts);
+
+  /// Called by the workers, possibly at the same time
+  void addMutantCosts(const MutantCosts &costs);
+  const MutantCosts &mutantCosts() const {
+    return costs;
+  }
+
   void beginReportResult();
   void endReportResult();
 
@@ -111,6 +193,13 @@ private:
   std::map<const MutationPoint *, MetricsMeasure> loadMutant;
 
   std::map<const MutationPoint *, std::map<const Test *, MetricsMeasure>> mutantRuns;
+
+  uint64_t precompiledObjectFilesSize;
+  uint64_t precompiledObjectFilesResidentSize;
+  std::vector<ContextMemory> contextsMemory;
+
+  std::mutex costsMutex;
+  MutantCosts costs;
 };
 
 }
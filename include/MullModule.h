@@ -3,6 +3,7 @@
 #include <string>
 
 #include <llvm/IR/Module.h>
+#include <llvm/Support/MemoryBuffer.h>
 
 namespace llvm {
 class LLVMContext;
@@ -11,6 +12,10 @@ class LLVMContext;
 namespace mull {
 
   class MullModule {
+    /// The bitcode the module was parsed from, clones are parsed from it
+    /// instead of the file on disk. Function bodies of the module itself
+    /// are read from it on demand, so it must outlive the module.
+    std::unique_ptr<llvm::MemoryBuffer> bitcode;
     std::unique_ptr<llvm::Module> module;
     std::string uniqueIdentifier;
     std::string modulePath;
@@ -19,8 +24,15 @@ namespace mull {
     MullModule(std::unique_ptr<llvm::Module> llvmModule,
                const std::string &md5,
                const std::string &path);
+    MullModule(std::unique_ptr<llvm::Module> llvmModule,
+               std::unique_ptr<llvm::MemoryBuffer> bitcode,
+               const std::string &md5,
+               const std::string &path);
 
     std::unique_ptr<MullModule> clone(llvm::LLVMContext &context);
+    /// Function bodies of a lazy clone are only parsed when materialized,
+    /// the clone must not outlive the original module
+    std::unique_ptr<MullModule> lazyClone(llvm::LLVMContext &context);
 
     llvm::Module *getModule() {
       assert(module.get());
@@ -32,6 +44,10 @@ namespace mull {
       return module.get();
     }
 
+    uint64_t getBitcodeSize() const {
+      return bitcode ? bitcode->getBufferSize() : 0;
+    }
+
     std::string getUniqueIdentifier() {
       return uniqueIdentifier;
     }
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "ExecutionResult.h"
+
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+struct sqlite3;
+struct sqlite3_stmt;
+
+namespace llvm {
+  class Function;
+  class GlobalVariable;
+}
+
+namespace mull {
+
+class MutationPoint;
+class Test;
+
+/// \brief Results of the mutants from the previous runs.
+///
+/// A mutant is identified by the code of the mutated function and the
+/// position of the mutation in it. A test is identified by the code of all
+/// the functions it has executed against the original program, including
+/// the mutated function and everything it calls. As long as both keys stay
+/// the same, running the mutant against the test gives the same result.
+///
+/// The code is hashed structurally, names of the local values and debug
+/// information do not matter.
+///
+/// Some results also depend on the settings of the run: fail-fast skips
+/// tests, the timeouts decide which tests time out. Such settings are
+/// part of the mutant key, results of runs with other settings are not used.
+class MutationHistory {
+public:
+  explicit MutationHistory(const std::string &path,
+                           const std::string &settings = std::string());
+  ~MutationHistory();
+
+  bool isEnabled() const;
+
+  const std::string &mutantKey(MutationPoint &mutationPoint);
+  const std::string &testKey(Test &test);
+
+  bool lookup(const std::string &mutantKey,
+              const std::string &testKey,
+              ExecutionResult &result);
+  void record(const std::string &mutantKey,
+              const std::string &testKey,
+              const ExecutionResult &result);
+
+  /// Commits the new results and drops the ones not used by this run
+  void save();
+
+private:
+  static const int CommitInterval = 256;
+
+  void commit();
+
+  const std::string &functionHash(llvm::Function &function);
+  const std::string &globalHash(llvm::GlobalVariable &global);
+
+  std::string settings;
+  sqlite3 *database;
+  sqlite3_stmt *lookupStatement;
+  sqlite3_stmt *insertStatement;
+  int uncommittedResults;
+
+  std::map<MutationPoint *, std::string> mutantKeys;
+  std::map<Test *, std::string> testKeys;
+  std::map<llvm::Function *, std::string> functionHashes;
+  std::map<llvm::GlobalVariable *, std::string> globalHashes;
+
+  std::set<std::pair<std::string, std::string>> usedResults;
+};
+
+}
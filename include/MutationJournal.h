@@ -0,0 +1,60 @@
+#pragma once
+
+#include "ExecutionResult.h"
+
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace llvm {
+  class raw_fd_ostream;
+}
+
+namespace mull {
+
+/// \brief Results of the mutants executed by the current run.
+///
+/// Every result is appended to the journal as soon as it is known, so that
+/// an interrupted run can be resumed: the results found in the journal are
+/// taken as they are, and only the remaining mutants are run.
+///
+/// A run that is not resumed starts with an empty journal. A record cut
+/// short by a crash is dropped, along with everything after it.
+class MutationJournal {
+public:
+  static const int FormatVersion = 1;
+
+  MutationJournal(const std::string &path, bool resume);
+  ~MutationJournal();
+
+  bool isEnabled() const;
+
+  bool lookup(const std::string &mutantKey,
+              const std::string &testKey,
+              ExecutionResult &result) const;
+  void record(const std::string &mutantKey,
+              const std::string &testKey,
+              const ExecutionResult &result);
+
+  /// Number of results restored from the previous run
+  size_t size() const;
+
+private:
+  /// The journal is flushed after every record, which is enough to survive
+  /// a crash of Mull. Syncing to disk is more expensive, and only needed
+  /// to survive a crash of the machine, so it is done less often.
+  static const int SyncInterval = 64;
+
+  /// Returns the size of the valid part of the journal
+  size_t load(const std::string &path);
+  void sync();
+
+  int descriptor;
+  std::unique_ptr<llvm::raw_fd_ostream> stream;
+  int unsyncedResults;
+
+  std::map<std::pair<std::string, std::string>, ExecutionResult> results;
+};
+
+}
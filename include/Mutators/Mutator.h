@@ -37,6 +37,10 @@ public:
   virtual std::string getUniqueIdentifier() const = 0;
   virtual MutatorKind mutatorKind()  { return MutatorKind::Unknown; }
 
+  /// Instructions with other opcodes are never passed to getMutationPoint,
+  /// so that the search does not have to try every mutator on every instruction
+  virtual bool canMutateOpcode(unsigned opcode) { return true; }
+
   virtual bool canBeApplied(llvm::Value &V) = 0;
   virtual llvm::Value *
   applyMutation(llvm::Module *module, MutationPointAddress &address) = 0;
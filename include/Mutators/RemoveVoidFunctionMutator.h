@@ -35,6 +35,7 @@ namespace mull {
       return ID;
     }
 
+    bool canMutateOpcode(unsigned opcode) override;
     bool canBeApplied(llvm::Value &V) override;
     llvm::Value *
     applyMutation(llvm::Module *module, MutationPointAddress &address) override;
@@ -26,6 +26,7 @@ public:
     return ID;
   }
 
+  bool canMutateOpcode(unsigned opcode) override;
   bool canBeApplied(llvm::Value &V) override;
   llvm::Value *
   applyMutation(llvm::Module *module, MutationPointAddress &address) override;
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+namespace mull {
+
+/// \brief Hands items over from one pool of threads to another.
+///
+/// Producers wait while the queue is full, so they never run too far ahead
+/// of the consumers. Once the queue is closed, consumers drain what is left
+/// and then stop.
+template <typename T>
+class BoundedQueue {
+public:
+  explicit BoundedQueue(size_t capacity)
+      : capacity(std::max(capacity, size_t(1))), closed(false) {}
+
+  /// Returns false if the queue was closed before the item could be added
+  bool push(T item) {
+    std::unique_lock<std::mutex> lock(mutex);
+    notFull.wait(lock, [this]() { return closed || queue.size() < capacity; });
+    if (closed) {
+      return false;
+    }
+    queue.push_back(std::move(item));
+    notEmpty.notify_one();
+    return true;
+  }
+
+  /// Returns false once the queue is closed and empty
+  bool pop(T &item) {
+    std::unique_lock<std::mutex> lock(mutex);
+    notEmpty.wait(lock, [this]() { return closed || !queue.empty(); });
+    if (queue.empty()) {
+      return false;
+    }
+    item = std::move(queue.front());
+    queue.pop_front();
+    notFull.notify_one();
+    return true;
+  }
+
+  void close() {
+    std::lock_guard<std::mutex> lock(mutex);
+    closed = true;
+    notEmpty.notify_all();
+    notFull.notify_all();
+  }
+
+private:
+  size_t capacity;
+  bool closed;
+
+  std::mutex mutex;
+  std::condition_variable notEmpty;
+  std::condition_variable notFull;
+  std::deque<T> queue;
+};
+
+}
@@ -0,0 +1,123 @@
+#pragma once
+
+#include "Logger.h"
+#include "Metrics/Metrics.h"
+#include "Parallelization/BoundedQueue.h"
+#include "Parallelization/Progress.h"
+
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace mull {
+
+/// \brief Compiles and runs mutants in two stages.
+///
+/// Compilation workers generate the machine code of the mutants and put
+/// them into a bounded queue, execution workers take them out, link them,
+/// and run the tests. Code generation of the next mutants thus overlaps with
+/// the tests of the current ones, and each stage gets its own number of
+/// threads. The queue holds a couple of mutants per execution worker, so the
+/// compiled objects waiting for their turn do not pile up in memory.
+///
+/// A compilation task provides 'Compiled compile(item)' and 'finish()',
+/// an execution task provides 'execute(Compiled &, Out &)' and 'finish()'.
+///
+/// The results come in the order in which the mutants complete.
+template <typename CompilationTask, typename ExecutionTask>
+class MutantPipeline {
+public:
+  using In = typename CompilationTask::In;
+  using Compiled = typename CompilationTask::Compiled;
+  using Out = typename ExecutionTask::Out;
+
+  static const size_t QueuedMutantsPerWorker = 2;
+
+  MutantPipeline(const std::string &name,
+                 In &in,
+                 Out &out,
+                 std::vector<CompilationTask> compilationTasks,
+                 std::vector<ExecutionTask> executionTasks)
+      : in(in), out(out), compilationTasks(std::move(compilationTasks)),
+        executionTasks(std::move(executionTasks)), name(name) {}
+
+  void execute() {
+    if (compilationTasks.empty() || executionTasks.empty() || in.empty()) {
+      return;
+    }
+
+    measure.start();
+
+    auto compilers = std::min(in.size(), compilationTasks.size());
+    auto executors = std::min(in.size(), executionTasks.size());
+
+    BoundedQueue<Compiled> queue(executors * QueuedMutantsPerWorker);
+    std::atomic<size_t> cursor(0);
+    std::atomic<size_t> runningCompilers(compilers);
+
+    std::vector<Out> storages(executors);
+    std::vector<progress_counter> counters(executors);
+    std::vector<std::thread> threads;
+
+    /// Mutants are taken one by one in the input order,
+    /// the last compiler to finish closes the queue
+    for (size_t i = 0; i < compilers; i++) {
+      CompilationTask &task = compilationTasks[i];
+      threads.emplace_back([&task, &queue, &cursor, &runningCompilers, this]() {
+        for (size_t index = cursor++; index < in.size(); index = cursor++) {
+          if (!queue.push(task.compile(in[index]))) {
+            break;
+          }
+        }
+        task.finish();
+
+        if (--runningCompilers == 0) {
+          queue.close();
+        }
+      });
+    }
+
+    for (size_t i = 0; i < executors; i++) {
+      ExecutionTask &task = executionTasks[i];
+      Out &storage = storages[i];
+      progress_counter &counter = counters[i];
+      threads.emplace_back([&task, &storage, &counter, &queue]() {
+        Compiled mutant;
+        while (queue.pop(mutant)) {
+          task.execute(mutant, storage);
+          mutant = Compiled();
+          counter.increment();
+        }
+        task.finish();
+      });
+    }
+
+    std::thread reporter(progress_reporter{ name, counters, in.size(), executors, Logger::info() });
+    threads.push_back(std::move(reporter));
+
+    for (auto &t : threads) {
+      t.join();
+    }
+
+    for (auto &storage : storages) {
+      for (auto &result : storage) {
+        out.push_back(std::move(result));
+      }
+    }
+
+    measure.finish();
+    Logger::info() << ". Finished in " << measure.duration() << MetricsMeasure::precision() << ".\n";
+  }
+
+private:
+  In &in;
+  Out &out;
+  std::vector<CompilationTask> compilationTasks;
+  std::vector<ExecutionTask> executionTasks;
+  MetricsMeasure measure;
+  std::string name;
+};
+
+}
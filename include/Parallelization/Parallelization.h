@@ -3,6 +3,7 @@
 #include "Logger.h"
 #include "Parallelization/Progress.h"
 #include "Parallelization/TaskExecutor.h"
+#include "Parallelization/MutantPipeline.h"
 
 #include "Parallelization/Tasks/ModuleLoadingTask.h"
 #include "Parallelization/Tasks/SearchMutationPointsTask.h"
@@ -12,4 +13,5 @@
 #include "Parallelization/Tasks/OriginalTestExecutionTask.h"
 #include "Parallelization/Tasks/JunkDetectionTask.h"
 #include "Parallelization/Tasks/OriginalCompilationTask.h"
+#include "Parallelization/Tasks/MutantCompilationTask.h"
 #include "Parallelization/Tasks/MutantExecutionTask.h"
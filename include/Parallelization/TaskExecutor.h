@@ -1,5 +1,8 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <mutex>
 #include <vector>
 #include <string>
 #include <thread>
@@ -10,7 +13,7 @@
 
 namespace mull {
 
-std::vector<int> taskBatches(size_t itemsCount, size_t tasks);
+size_t dynamicBatchSize(size_t remainingItems, size_t workers);
 
 template <typename Task>
 class TaskExecutor {
@@ -40,29 +43,56 @@ private:
     Logger::info() << ". Finished in " << measure.duration() << MetricsMeasure::precision() << ".\n";
   }
 
+  /// Workers do not get a fixed range of the input upfront. Instead, they
+  /// claim batches from a shared cursor until the input is exhausted.
+  /// Batches shrink as the input drains (see dynamicBatchSize), so a worker
+  /// that drew a slow item does not hold back the rest of the phase.
+  /// The results are merged in the input order, regardless of which worker
+  /// processed which batch.
   void executeInParallel() {
     assert(tasks.size() != 1);
     assert(in.size() != 1);
     auto workers = std::min(in.size(), tasks.size());
 
-    auto batches = taskBatches(in.size(), workers);
     std::vector<std::thread> threads;
-    std::vector<Out> storages;
+    std::vector<std::pair<size_t, Out>> storages;
+    std::mutex storagesMutex;
+    std::atomic<size_t> cursor(0);
+    const size_t total = in.size();
 
-    storages.reserve(workers);
     counters.reserve(workers);
 
-    auto end = in.begin();
     for (unsigned i = 0; i < workers; i++) {
-      int group = batches[i];
-      storages.push_back(Out());
       counters.push_back(progress_counter());
+    }
 
-      auto begin = end;
-      std::advance(end, group);
-      std::thread t(std::move(tasks[i]), begin, end,
-                    std::ref(storages.back()),
-                    std::ref(counters.back()));
+    for (unsigned i = 0; i < workers; i++) {
+      Task &task = tasks[i];
+      progress_counter &counter = counters[i];
+
+      std::thread t([&task, &counter, &cursor, &storages, &storagesMutex, total, workers, this]() {
+        for (;;) {
+          size_t first = cursor.load();
+          size_t size = 0;
+          do {
+            if (first >= total) {
+              return;
+            }
+            size = dynamicBatchSize(total - first, workers);
+          } while (!cursor.compare_exchange_weak(first, first + size));
+
+          auto begin = in.begin();
+          std::advance(begin, first);
+          auto end = begin;
+          std::advance(end, size);
+
+          Out storage;
+          task(begin, end, storage, counter);
+
+          std::lock_guard<std::mutex> lock(storagesMutex);
+          storages.push_back(std::make_pair(first, std::move(storage)));
+        }
+      });
       threads.push_back(std::move(t));
     }
 
@@ -73,8 +103,13 @@ private:
       t.join();
     }
 
+    std::sort(storages.begin(), storages.end(),
+              [](const std::pair<size_t, Out> &lhs, const std::pair<size_t, Out> &rhs) {
+                return lhs.first < rhs.first;
+              });
+
     for (auto &storage : storages) {
-      for (auto &m : storage) {
+      for (auto &m : storage.second) {
         out.push_back(std::move(m));
       }
     }
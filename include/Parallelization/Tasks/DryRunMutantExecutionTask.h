@@ -6,6 +6,7 @@
 namespace mull {
 class progress_counter;
 class MutationPoint;
+class Config;
 
 class DryRunMutantExecutionTask {
 public:
@@ -13,6 +14,10 @@ public:
   using Out = std::vector<std::unique_ptr<MutationResult>>;
   using iterator = In::const_iterator;
 
+  explicit DryRunMutantExecutionTask(const Config &config);
+
   void operator() (iterator begin, iterator end, Out &storage, progress_counter &counter);
+private:
+  const Config &config;
 };
 }
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "ExecutionResult.h"
+#include "Metrics/Metrics.h"
+
+#include <llvm/Object/ObjectFile.h>
+#include <llvm/Target/TargetMachine.h>
+
+#include <memory>
+#include <vector>
+
+namespace mull {
+
+class MutationPoint;
+class Driver;
+class Config;
+class Toolchain;
+class TrivialCompilerEquivalence;
+
+/// A mutant ready to be loaded. Woven mutants come without an object file,
+/// they are already in the program compiled with mutant schemata.
+struct CompiledMutant {
+  CompiledMutant();
+  CompiledMutant(MutationPoint *mutationPoint,
+                 llvm::object::OwningBinary<llvm::object::ObjectFile> object);
+
+  MutationPoint *mutationPoint;
+  llvm::object::OwningBinary<llvm::object::ObjectFile> object;
+  /// Equivalent or Duplicate if the mutant need not run, Invalid otherwise
+  ExecutionStatus status;
+};
+
+class MutantCompilationTask {
+public:
+  using In = const std::vector<MutationPoint *>;
+  using Compiled = CompiledMutant;
+
+  MutantCompilationTask(Driver &driver,
+                        Config &config,
+                        Toolchain &toolchain,
+                        Metrics &metrics,
+                        TrivialCompilerEquivalence &equivalence);
+
+  /// With trivial compiler equivalence enabled, the mutants equivalent to
+  /// the original or to another mutant come without an object file
+  CompiledMutant compile(MutationPoint *mutationPoint);
+
+  /// Adds the costs collected so far to the metrics
+  void finish();
+
+  /// Redirected mutants contain only the mutated function, the rest of the
+  /// program is the original one, compiled with redirects
+  static bool isRedirected(const Config &config, MutationPoint &mutationPoint);
+
+  Driver &driver;
+  Config &config;
+  Toolchain &toolchain;
+  Metrics &metrics;
+  TrivialCompilerEquivalence &equivalence;
+  MutantCosts costs;
+
+  /// Created on first use, on the thread of the worker
+  std::unique_ptr<llvm::TargetMachine> machine;
+
+private:
+  llvm::object::OwningBinary<llvm::object::ObjectFile>
+  compileMutant(MutationPoint *mutationPoint);
+};
+}
@@ -1,39 +1,79 @@
 #pragma once
 
 #include "MutationResult.h"
+#include "ForkServer.h"
+#include "Metrics/Metrics.h"
 #include "Toolchain/JITEngine.h"
 
+#include <llvm/Object/ObjectFile.h>
+
+#include <memory>
+
 namespace mull {
 
 class MutationPoint;
+class Test;
 class Driver;
 class ProcessSandbox;
 class TestRunner;
 class Config;
 class Toolchain;
 class Filter;
-class progress_counter;
+struct CompiledMutant;
 
 class MutantExecutionTask {
 public:
-  using In = const std::vector<MutationPoint *>;
   using Out = std::vector<std::unique_ptr<MutationResult>>;
-  using iterator = In::const_iterator;
 
   MutantExecutionTask(Driver &driver,
                       ProcessSandbox &sandbox,
                       TestRunner &runner,
                       Config &config,
                       Toolchain &toolchain,
-                      Filter &filter);
+                      Filter &filter,
+                      Metrics &metrics);
+
+  /// Forks the server of the task. Must be called before any worker threads
+  /// start, and once the task is at its final address: the handlers of the
+  /// server capture 'this'.
+  void startForkServer();
+
+  /// Links the mutant and runs the tests reaching it
+  void execute(CompiledMutant &compiledMutant, Out &storage);
+
+  /// Adds the costs collected so far to the metrics
+  void finish();
+
+  /// Time a test gets to run against a mutant, in milliseconds
+  static long long timeout(const Config &config, const ExecutionResult &originalResult);
+
+  /// Tests reaching the mutant in the order they run
+  static std::vector<std::pair<Test *, int>>
+  orderedReachableTests(MutationPoint *mutationPoint, bool failFast);
 
-  void operator() (iterator begin, iterator end, Out &storage, progress_counter &counter);
   JITEngine jit;
+
+  /// Lives as long as the task, i.e. across all the mutants of a worker.
+  /// Once the server is gone, the task runs the mutants itself.
+  std::unique_ptr<ForkServer> forkServer;
+  /// Owned by the fork server process: the mutant it has linked last
+  llvm::object::OwningBinary<llvm::object::ObjectFile> serverMutant;
+  /// Redirect pointer of the function replaced by the last loaded mutant
+  void **activeRedirect;
+  /// Active mutant ID of the module the last loaded woven mutant belongs to
+  int32_t *activeSchemata;
+  /// Whether the program with mutant schemata is currently linked
+  bool schemataLoaded;
+
   ProcessSandbox &sandbox;
   TestRunner &runner;
   Config &config;
   Toolchain &toolchain;
   Filter &filter;
   Driver &driver;
+  Metrics &metrics;
+
+  /// Costs collected since the last call to finish
+  MutantCosts costs;
 };
 }
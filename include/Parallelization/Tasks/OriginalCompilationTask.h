@@ -2,11 +2,18 @@
 
 #include "MullModule.h"
 
+#include <map>
 #include <vector>
 #include <llvm/Object/ObjectFile.h>
 
+namespace llvm {
+class Module;
+}
+
 namespace mull {
+class Config;
 class Toolchain;
+class MutationPoint;
 class progress_counter;
 
 class OriginalCompilationTask {
@@ -15,9 +22,14 @@ public:
   using Out = std::vector<llvm::object::OwningBinary<llvm::object::ObjectFile>>;
   using iterator = In::const_iterator;
 
-  explicit OriginalCompilationTask(Toolchain &toolchain);
+  using Schemata = std::map<llvm::Module *, std::vector<MutationPoint *>>;
+
+  OriginalCompilationTask(Config &config, Toolchain &toolchain,
+                          const Schemata &schemata);
 
   void operator() (iterator begin, iterator end, Out &storage, progress_counter &counter);
+  Config &config;
   Toolchain &toolchain;
+  const Schemata &schemata;
 };
 }
@@ -4,6 +4,10 @@
 #include "MutationPoint.h"
 #include "Mutators/Mutator.h"
 
+#include <llvm/ADT/DenseMap.h>
+
+#include <vector>
+
 namespace mull {
 
 class Filter;
@@ -19,8 +23,13 @@ public:
   SearchMutationPointsTask(Filter &filter, const Context &context, std::vector<std::unique_ptr<Mutator>> &mutators);
   void operator() (iterator begin, iterator end, Out &storage, progress_counter &counter);
 private:
+  int functionIndex(llvm::Function *function);
+
   Filter &filter;
   const Context &context;
   std::vector<std::unique_ptr<Mutator>> &mutators;
+  /// Indices of the mutators that can mutate instructions with a given opcode
+  std::vector<std::vector<size_t>> mutatorsByOpcode;
+  llvm::DenseMap<llvm::Function *, int> functionIndices;
 };
 }
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <string>
+
+namespace mull {
+
+/// \brief Plain text format of the files Mull keeps between runs.
+///
+/// Numbers are followed by a space,
+/// strings are prefixed with their length: "<length>:<string> "
+class RecordWriter {
+public:
+  explicit RecordWriter(llvm::raw_ostream &stream) : stream(stream) {}
+
+  void number(long long value) {
+    stream << value << ' ';
+  }
+
+  void string(llvm::StringRef value) {
+    stream << value.size() << ':' << value << ' ';
+  }
+
+private:
+  llvm::raw_ostream &stream;
+};
+
+class RecordReader {
+public:
+  explicit RecordReader(llvm::StringRef data) : data(data) {}
+
+  bool number(long long &value) {
+    size_t end = data.find(' ');
+    if (end == llvm::StringRef::npos ||
+        data.substr(0, end).getAsInteger(10, value)) {
+      return false;
+    }
+    data = data.substr(end + 1);
+    return true;
+  }
+
+  bool string(std::string &value) {
+    size_t colon = data.find(':');
+    unsigned long long size = 0;
+    if (colon == llvm::StringRef::npos ||
+        data.substr(0, colon).getAsInteger(10, size) ||
+        data.size() < colon + size + 2) {
+      return false;
+    }
+    value = data.substr(colon + 1, size).str();
+    data = data.substr(colon + size + 2);
+    return true;
+  }
+
+  bool atEnd() const {
+    return data.empty();
+  }
+
+  /// Number of bytes not read yet
+  size_t remaining() const {
+    return data.size();
+  }
+
+private:
+  llvm::StringRef data;
+};
+
+}
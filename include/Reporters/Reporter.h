@@ -1,13 +1,34 @@
 #pragma once
 
+#include <memory>
+#include <vector>
+
 namespace mull {
 
 class Result;
 class Config;
 class Metrics;
+class MutationPoint;
+class MutationResult;
+class Test;
 
 class Reporter {
 public:
+  /// Called once the tests and the mutants are known, before any mutant runs
+  virtual void beginResults(const std::vector<std::unique_ptr<Test>> &tests,
+                            const std::vector<MutationPoint *> &mutationPoints,
+                            const Config &config) {}
+
+  /// Called for each result as soon as it is known, always from one thread.
+  /// The outputs of the result are released right after the call, unless
+  /// some reporter needs them in reportResults.
+  virtual void reportMutationResult(MutationResult &result) {}
+
+  /// Whether reportResults reads the outputs of the mutation results.
+  /// Reporters that store the outputs while the results are streamed,
+  /// or do not use them at all, let the driver release them early.
+  virtual bool needsOutputsOfResults() const { return true; }
+
   virtual void reportResults(const Result &result,
                              const Config &config,
                              const Metrics &metrics) = 0;
@@ -15,4 +36,3 @@ public:
 };
 
 }
-
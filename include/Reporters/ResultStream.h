@@ -0,0 +1,47 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace mull {
+
+class MutationResult;
+
+/// \brief Hands the results of mutants over as they complete.
+///
+/// Workers push results into a bounded queue, a single thread takes them out
+/// and passes them to the consumer. A worker waits while the queue is full,
+/// so results never pile up faster than they are reported.
+class ResultStream {
+public:
+  static const size_t DefaultCapacity = 1024;
+
+  using Consumer = std::function<void (MutationResult &)>;
+
+  ResultStream(Consumer consumer, size_t capacity = DefaultCapacity);
+  ~ResultStream();
+
+  void push(MutationResult *result);
+
+  /// Waits until every pushed result is consumed
+  void finish();
+
+private:
+  void consume();
+
+  Consumer consumer;
+  size_t capacity;
+
+  std::mutex mutex;
+  std::condition_variable notEmpty;
+  std::condition_variable notFull;
+  std::deque<MutationResult *> queue;
+  bool finished;
+
+  std::thread thread;
+};
+
+}
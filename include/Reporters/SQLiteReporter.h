@@ -1,23 +1,56 @@
 #include "Reporters/Reporter.h"
+#include "Config.h"
 
+#include <map>
 #include <string>
 #include <vector>
 #include <memory>
 
+struct sqlite3;
+struct sqlite3_stmt;
+
 namespace mull {
 
 class Result;
-class Config;
 class Metrics;
 
 class SQLiteReporter : public Reporter {
 
 private:
+  /// Results are committed in batches while they are streamed
+  static const int CommitInterval = 256;
+
   std::string databasePath;
 
+  /// Open while the results are streamed
+  sqlite3 *database;
+  sqlite3_stmt *insertExecutionResultStmt;
+  sqlite3_stmt *insertMutationResultStmt;
+  sqlite3_stmt *insertOutputStmt;
+  int uncommittedResults;
+
+  Config::ReportOutput reportOutput;
+  /// IDs of the stored outputs by their MD5 hash
+  std::map<std::string, long long> outputIDs;
+
+  void prepareStatements(const Config &config);
+  void closeDatabase();
+
+  long long outputID(const std::string &output);
+  void bindOutput(sqlite3_stmt *stmt, int index, const std::string &output);
+  void insertTests(const std::vector<std::unique_ptr<Test>> &tests);
+  void insertMutationResult(MutationResult &mutationResult);
+
 public:
   SQLiteReporter(const std::string &projectName = std::string(""));
-
+  ~SQLiteReporter();
+
+  void beginResults(const std::vector<std::unique_ptr<Test>> &tests,
+                    const std::vector<MutationPoint *> &mutationPoints,
+                    const Config &config) override;
+  void reportMutationResult(MutationResult &result) override;
+  /// The outputs are stored as the results are streamed
+  bool needsOutputsOfResults() const override { return false; }
   void reportResults(const Result &result,
                      const Config &config,
                      const Metrics &metrics) override;
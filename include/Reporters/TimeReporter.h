@@ -4,6 +4,7 @@ namespace mull {
 
 class TimeReporter : public Reporter {
 public:
+  bool needsOutputsOfResults() const override { return false; }
   void reportResults(const Result &result,
                      const Config &config,
                      const Metrics &metrics) override;
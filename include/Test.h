@@ -23,6 +23,15 @@ public:
   ExecutionResult &getExecutionResult() { return executionResult; }
   InstrumentationInfo &getInstrumentationInfo() { return instrumentationInfo; }
 
+  /// All the instrumented functions the test has executed,
+  /// only recorded when the mutation history is enabled
+  void setExecutedFunctions(std::vector<llvm::Function *> functions) {
+    executedFunctions = std::move(functions);
+  }
+  const std::vector<llvm::Function *> &getExecutedFunctions() const {
+    return executedFunctions;
+  }
+
   /// Entry points into the test might be the test body, setup/teardown,
   /// before each/before all functions, and so on.
   /// TODO: entryPoints is not the best name for teardown/after each methods
@@ -43,6 +52,7 @@ public:
 private:
   ExecutionResult executionResult;
   InstrumentationInfo instrumentationInfo;
+  std::vector<llvm::Function *> executedFunctions;
 
   const TestKind Kind;
 };
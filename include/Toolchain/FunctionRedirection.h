@@ -0,0 +1,60 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace llvm {
+
+class Function;
+class Module;
+
+}
+
+namespace mull {
+
+class MutationPoint;
+
+/// \brief Support for the function-level compilation of mutants.
+///
+/// The original module is compiled once, after it was prepared:
+///  - internal symbols are made external under names unique to the module,
+///    so that the code compiled separately can still reach them;
+///  - every function starts with a check of its own redirect pointer, and if
+///    the pointer is set, the call is forwarded to the function it points to.
+///
+/// A mutant then is a tiny module with only the mutated function in it.
+/// Once it is linked, the redirect pointer of the original function
+/// is set to the mutated one.
+///
+/// With mutant schemata all the mutants of a module are woven into it
+/// instead: every mutant is a copy of the original function, and the original
+/// function dispatches to one of the copies depending on the active mutant ID.
+class FunctionRedirection {
+public:
+  FunctionRedirection() = delete;
+  ~FunctionRedirection() = delete;
+
+  static bool canRedirect(const llvm::Function &function);
+  static bool canRedirect(const MutationPoint &mutationPoint);
+
+  static void prepareModule(llvm::Module &module,
+                            const std::string &moduleIdentifier);
+  static void extractFunction(llvm::Module &module,
+                              const std::string &moduleIdentifier,
+                              int functionIndex);
+
+  /// Mutant IDs start from 1, in the order of the mutation points,
+  /// 0 stands for the original program
+  static void weaveMutants(llvm::Module &module,
+                           const std::string &moduleIdentifier,
+                           const std::vector<MutationPoint *> &mutationPoints);
+
+  /// The names are computed for functions of the original (not prepared) module
+  static std::string redirectName(const llvm::Function &function,
+                                  const std::string &moduleIdentifier);
+  static std::string mutantName(const llvm::Function &function,
+                                const std::string &moduleIdentifier);
+  static std::string activeMutantName(const std::string &moduleIdentifier);
+};
+
+}
@@ -2,6 +2,8 @@
 
 #include "LLVMCompatibility.h"
 
+#include <set>
+
 namespace mull {
 
 class JITEngine {
@@ -9,8 +11,23 @@ class JITEngine {
   llvm::StringMap<llvm_compat::JITSymbol> symbolTable;
   llvm_compat::JITSymbol symbolNotFound;
   std::unique_ptr<llvm::RuntimeDyld::MemoryManager> memoryManager;
+
+  std::set<llvm::object::ObjectFile *> stableObjectFiles;
+  llvm::StringMap<llvm_compat::JITSymbol> stableSymbolTable;
+  std::unique_ptr<llvm::RuntimeDyld::MemoryManager> stableMemoryManager;
+  bool stableObjectFilesLinked;
+
+  void linkStableObjectFiles(llvm_compat::SymbolResolver &resolver);
 public:
   JITEngine();
+
+  /// Stable object files are linked once, on the first call of addObjectFiles,
+  /// and are skipped by all further calls. Other object files resolve symbols
+  /// against them.
+  /// The caller guarantees that stable object files do not depend on the
+  /// symbols defined by any other object file.
+  void setStableObjectFiles(const std::vector<llvm::object::ObjectFile *> &files);
+
   void addObjectFiles(std::vector<llvm::object::ObjectFile *> &files,
                       llvm_compat::SymbolResolver  &resolver,
                       std::unique_ptr<llvm::RuntimeDyld::MemoryManager> memoryManager);
@@ -2,33 +2,102 @@
 
 #include <llvm/Object/ObjectFile.h>
 
+#include <atomic>
+#include <cstdint>
+#include <mutex>
 #include <string>
+#include <vector>
+
+namespace llvm {
+  class TargetMachine;
+}
 
 namespace mull {
   class MullModule;
   class MutationPoint;
 
+  /// Object files are stored under a hash of their identifier and of the
+  /// toolchain that produced them, so that several mull-driver processes,
+  /// possibly built against different LLVM versions or targets, can share
+  /// one cache directory.
+  ///
+  /// Each file is written to a temporary file first and then renamed, and
+  /// carries a checksum of its content: a reader sees either a complete
+  /// object or none at all.
   class ObjectCache {
+  public:
+    /// Bump whenever the generated code changes without a change in the
+    /// identifiers, e.g. when a mutator or the instrumentation is reworked
+    static const int FormatVersion = 1;
+
+    struct Statistics {
+      uint64_t hits;
+      uint64_t misses;
+      uint64_t writes;
+      uint64_t corrupted;
+      uint64_t evictions;
+    };
+
+  private:
     bool useOnDiskCache;
     std::string cacheDirectory;
+    std::string toolchainFingerprint;
+
+    /// Zero means no limit
+    uint64_t sizeLimit;
+    std::atomic<uint64_t> approximateSize;
+    std::mutex evictionMutex;
+
+    std::atomic<uint64_t> hits;
+    std::atomic<uint64_t> misses;
+    std::atomic<uint64_t> writes;
+    std::atomic<uint64_t> corrupted;
+    std::atomic<uint64_t> evictions;
 
   public:
-    ObjectCache(bool useCache, const std::string &cacheDir);
+    ObjectCache(bool useCache,
+                const std::string &cacheDir,
+                uint64_t sizeLimit,
+                const llvm::TargetMachine &machine);
 
-    llvm::object::OwningBinary<llvm::object::ObjectFile> getInstrumentedObject(const MullModule &module);
+    llvm::object::OwningBinary<llvm::object::ObjectFile> getInstrumentedObject(const MullModule &module,
+                                                                               uint32_t functionIndexOffset);
     llvm::object::OwningBinary<llvm::object::ObjectFile> getObject(const MullModule &module);
     llvm::object::OwningBinary<llvm::object::ObjectFile> getObject(const MutationPoint &mutationPoint);
+    llvm::object::OwningBinary<llvm::object::ObjectFile> getRedirectableObject(const MullModule &module);
+    llvm::object::OwningBinary<llvm::object::ObjectFile> getFunctionObject(const MutationPoint &mutationPoint);
+    llvm::object::OwningBinary<llvm::object::ObjectFile> getSchemataObject(const MullModule &module,
+                                                                           const std::vector<MutationPoint *> &mutationPoints);
 
     void putInstrumentedObject(llvm::object::OwningBinary<llvm::object::ObjectFile> &object,
-                               const MullModule &module);
+                               const MullModule &module,
+                               uint32_t functionIndexOffset);
     void putObject(llvm::object::OwningBinary<llvm::object::ObjectFile> &object,
                    const MullModule &module);
     void putObject(llvm::object::OwningBinary<llvm::object::ObjectFile> &object,
                    const MutationPoint &mutationPoint);
+    void putRedirectableObject(llvm::object::OwningBinary<llvm::object::ObjectFile> &object,
+                               const MullModule &module);
+    void putFunctionObject(llvm::object::OwningBinary<llvm::object::ObjectFile> &object,
+                           const MutationPoint &mutationPoint);
+    void putSchemataObject(llvm::object::OwningBinary<llvm::object::ObjectFile> &object,
+                           const MullModule &module,
+                           const std::vector<MutationPoint *> &mutationPoints);
+
+    /// Anything else worth keeping between runs, e.g. the call trees of tests
+    bool getData(const std::string &identifier, std::string &data);
+    void putData(llvm::StringRef data, const std::string &identifier);
+
+    Statistics statistics() const;
+    void printStatistics() const;
 
   private:
+    std::string cachePath(const std::string &identifier) const;
+    std::unique_ptr<llvm::MemoryBuffer> readFromDisk(const std::string &cacheName);
+    void writeToDisk(llvm::StringRef data, const std::string &identifier);
     llvm::object::OwningBinary<llvm::object::ObjectFile> getObjectFromDisk(const std::string &identifier);
     void putObjectOnDisk(llvm::object::OwningBinary<llvm::object::ObjectFile> &object,
                          const std::string &identifier);
+    uint64_t evict(uint64_t targetSize);
   };
 }
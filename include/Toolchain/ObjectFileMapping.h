@@ -0,0 +1,32 @@
+#pragma once
+
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/ErrorOr.h>
+#include <llvm/Support/MemoryBuffer.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace mull {
+
+/// \brief Read-only mapping of object files.
+///
+/// The JIT copies the sections of an object file into its own memory, the
+/// file itself is only read. Mapped object files are backed by the page
+/// cache: the pages are loaded on demand, can be dropped under memory
+/// pressure, and are shared with the forked children and other processes.
+class ObjectFileMapping {
+public:
+  ObjectFileMapping() = delete;
+  ~ObjectFileMapping() = delete;
+
+  /// Files smaller than a few pages are read into memory,
+  /// as mapping them does not pay off
+  static llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> map(const std::string &path);
+
+  /// The number of bytes of the data currently in physical memory
+  static uint64_t residentSize(llvm::StringRef data);
+};
+
+}
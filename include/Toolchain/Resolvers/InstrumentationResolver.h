@@ -19,7 +19,6 @@ class InstrumentationResolver : public llvm_compat::SymbolResolver {
   llvm::orc::LocalCXXRuntimeOverrides &overrides;
   Instrumentation &instrumentation;
   std::string instrumentationInfoName;
-  std::string functionOffsetPrefix;
   InstrumentationInfo **trampoline;
 public:
   InstrumentationResolver(llvm::orc::LocalCXXRuntimeOverrides &overrides,
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <llvm/ADT/StringRef.h>
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace mull {
+  class MutationPoint;
+
+  /// Trivial compiler equivalence: a mutant whose object file is identical
+  /// to the one compiled from the original code cannot be killed by any test,
+  /// the mutation was optimized away by the code generator. A mutant whose
+  /// object file is identical to the one of another mutant would get the
+  /// same results as that mutant.
+  ///
+  /// Objects are compared by a hash of their contents. A mutant is compared
+  /// against the mutants of the same scope only, i.e. of the same function
+  /// when the mutants are compiled per function, and of the same module
+  /// otherwise. Shared between the mutant compilation workers.
+  class TrivialCompilerEquivalence {
+  public:
+    enum class Verdict {
+      Unique,
+      Equivalent,
+      Duplicate
+    };
+
+    TrivialCompilerEquivalence();
+
+    static std::string hash(llvm::StringRef objectData);
+
+    /// Returns false if the original object of the scope is not known yet
+    bool hasOriginal(const std::string &scope);
+    void setOriginal(const std::string &scope, const std::string &originalHash);
+
+    Verdict classify(const std::string &scope,
+                     const std::string &mutantHash,
+                     MutationPoint *mutationPoint);
+
+    uint64_t equivalentCount() const;
+    uint64_t duplicateCount() const;
+
+  private:
+    std::mutex mutex;
+    std::map<std::string, std::string> originals;
+    /// The first mutant seen with each object, keyed by scope and hash
+    std::map<std::string, MutationPoint *> mutants;
+
+    std::atomic<uint64_t> equivalent;
+    std::atomic<uint64_t> duplicate;
+  };
+}
@@ -57,6 +57,69 @@ std::string Config::forkToString(Fork fork) {
   }
 }
 
+std::string Config::forkServerToString(ForkServerMode forkServer) {
+  switch (forkServer) {
+    case ForkServerMode::Enabled:
+      return "enabled";
+      break;
+
+    case ForkServerMode::Disabled:
+      return "disabled";
+      break;
+  }
+}
+
+std::string Config::batchedSandboxToString(BatchedSandboxMode batchedSandbox) {
+  switch (batchedSandbox) {
+    case BatchedSandboxMode::Enabled:
+      return "enabled";
+      break;
+
+    case BatchedSandboxMode::Disabled:
+      return "disabled";
+      break;
+  }
+}
+
+std::string Config::incrementalLinkingToString(IncrementalLinking incrementalLinking) {
+  switch (incrementalLinking) {
+    case IncrementalLinking::Enabled:
+      return "enabled";
+      break;
+
+    case IncrementalLinking::Disabled:
+      return "disabled";
+      break;
+  }
+}
+
+std::string Config::mutantCompilationToString(MutantCompilation mutantCompilation) {
+  switch (mutantCompilation) {
+    case MutantCompilation::Module:
+      return "module";
+      break;
+
+    case MutantCompilation::Function:
+      return "function";
+      break;
+
+    case MutantCompilation::Schemata:
+      return "schemata";
+      break;
+  }
+}
+
+std::string Config::trivialCompilerEquivalenceToString(TrivialCompilerEquivalenceMode mode) {
+  switch (mode) {
+    case TrivialCompilerEquivalenceMode::Enabled:
+      return "enabled";
+      break;
+
+    case TrivialCompilerEquivalenceMode::Disabled:
+      return "disabled";
+      break;
+  }
+}
 
 std::string Config::dryRunToString(DryRunMode dryRun) {
   switch (dryRun) {
@@ -120,6 +183,16 @@ std::string Config::diagnosticsToString(Diagnostics diagnostics) {
     }
   }
 }
+std::string Config::reportOutputToString(ReportOutput reportOutput) {
+  switch (reportOutput) {
+    case ReportOutput::All: {
+      return "all";
+    }
+    case ReportOutput::Killed: {
+      return "killed";
+    }
+  }
+}
 // Constructor initializes defaults.
 // TODO: Refactoring into constants.
 Config::Config() :
@@ -143,14 +216,27 @@ Config::Config() :
   excludeLocations(),
   customTests(),
   fork(Fork::Enabled),
+  forkServer(ForkServerMode::Disabled),
+  batchedSandbox(BatchedSandboxMode::Disabled),
+  incrementalLinking(IncrementalLinking::Disabled),
+  mutantCompilation(MutantCompilation::Module),
+  trivialCompilerEquivalence(TrivialCompilerEquivalenceMode::Disabled),
   dryRun(DryRunMode::Disabled),
   failFast(FailFastMode::Disabled),
   caching(UseCache::No),
   emitDebugInfo(EmitDebugInfo::No),
   diagnostics(Diagnostics::None),
+  reportOutput(ReportOutput::All),
   timeout(MullDefaultTimeoutMilliseconds),
+  mutantTimeoutMultiplier(10),
+  mutantTimeoutFloor(30),
   maxDistance(128),
+  maxOutputSize(0),
+  cacheSizeLimit(0),
   cacheDirectory("/tmp/mull_cache"),
+  historyFile(),
+  journalFile(),
+  resume(false),
   junkDetection(),
   parallelizationConfig()
 {}
@@ -187,14 +273,27 @@ tests(tests),
 excludeLocations(excludeLocations),
 customTests(definitions),
 fork(fork),
+forkServer(ForkServerMode::Disabled),
+batchedSandbox(BatchedSandboxMode::Disabled),
+incrementalLinking(IncrementalLinking::Disabled),
+mutantCompilation(MutantCompilation::Module),
+trivialCompilerEquivalence(TrivialCompilerEquivalenceMode::Disabled),
 dryRun(dryRun),
 failFast(failFast),
 caching(cache),
 emitDebugInfo(debugInfo),
 diagnostics(diagnostics),
+reportOutput(ReportOutput::All),
 timeout(timeout),
+mutantTimeoutMultiplier(10),
+mutantTimeoutFloor(30),
 maxDistance(distance),
+maxOutputSize(0),
+cacheSizeLimit(0),
 cacheDirectory(cacheDir),
+historyFile(),
+journalFile(),
+resume(false),
 junkDetection(std::move(junkDetection)),
 parallelizationConfig(parallelizationConfig)
 {
@@ -296,14 +395,56 @@ bool Config::forkEnabled() const {
   return fork == Fork::Enabled;
 }
 
+bool Config::forkServerEnabled() const {
+  return forkEnabled() && forkServer == ForkServerMode::Enabled;
+}
+
+bool Config::batchedSandboxEnabled() const {
+  return forkEnabled() && batchedSandbox == BatchedSandboxMode::Enabled;
+}
+
+bool Config::incrementalLinkingEnabled() const {
+  return forkEnabled() && incrementalLinking == IncrementalLinking::Enabled;
+}
+
 int Config::getTimeout() const {
   return timeout;
 }
 
+int Config::getMutantTimeoutMultiplier() const {
+  return mutantTimeoutMultiplier;
+}
+
+int Config::getMutantTimeoutFloor() const {
+  return mutantTimeoutFloor;
+}
+
 bool Config::cachingEnabled() const {
   return caching == UseCache::Yes;
 }
 
+bool Config::historyEnabled() const {
+  return !historyFile.empty();
+}
+
+bool Config::journalEnabled() const {
+  return !journalFile.empty();
+}
+
+bool Config::resumeEnabled() const {
+  return resume;
+}
+
+void Config::setResume(bool enabled) {
+  resume = enabled;
+}
+
+/// Woven mutants have no object file of their own to compare
+bool Config::trivialCompilerEquivalenceEnabled() const {
+  return trivialCompilerEquivalence == TrivialCompilerEquivalenceMode::Enabled &&
+         mutantCompilation != MutantCompilation::Schemata;
+}
+
 bool Config::dryRunModeEnabled() const {
   return dryRun == DryRunMode::Enabled;
 }
@@ -328,14 +469,38 @@ Config::Diagnostics Config::getDiagnostics() const {
   return diagnostics;
 }
 
+Config::ReportOutput Config::getReportOutput() const {
+  return reportOutput;
+}
+
+Config::MutantCompilation Config::getMutantCompilation() const {
+  return mutantCompilation;
+}
+
 int Config::getMaxDistance() const {
   return maxDistance;
 }
 
+int Config::getMaxOutputSize() const {
+  return maxOutputSize;
+}
+
+int Config::getCacheSizeLimit() const {
+  return cacheSizeLimit;
+}
+
 std::string Config::getCacheDirectory() const {
   return cacheDirectory;
 }
 
+const std::string &Config::getHistoryFile() const {
+  return historyFile;
+}
+
+const std::string &Config::getJournalFile() const {
+  return journalFile;
+}
+
 void Config::dump() const {
   Logger::debug() << "Config>\n"
   << "\t" << "bitcode_file_list: " << bitcodeFileList << '\n'
@@ -344,12 +509,26 @@ void Config::dump() const {
   << "\t" << "project_name: " << getProjectName() << '\n'
   << "\t" << "test_framework: " << getTestFramework() << '\n'
   << "\t" << "distance: " << getMaxDistance() << '\n'
+  << "\t" << "timeout: " << getTimeout() << '\n'
+  << "\t" << "mutant_timeout_multiplier: " << getMutantTimeoutMultiplier() << '\n'
+  << "\t" << "mutant_timeout_floor: " << getMutantTimeoutFloor() << '\n'
+  << "\t" << "max_output_size: " << getMaxOutputSize() << '\n'
   << "\t" << "dry_run: " << dryRunToString(dryRun) << '\n'
   << "\t" << "fail_fast: " << failFastToString(failFast) << '\n'
   << "\t" << "fork: " << forkToString(fork) << '\n'
+  << "\t" << "fork_server: " << forkServerToString(forkServer) << '\n'
+  << "\t" << "batched_sandbox: " << batchedSandboxToString(batchedSandbox) << '\n'
+  << "\t" << "incremental_linking: " << incrementalLinkingToString(incrementalLinking) << '\n'
+  << "\t" << "mutant_compilation: " << mutantCompilationToString(mutantCompilation) << '\n'
+  << "\t" << "trivial_compiler_equivalence: " << trivialCompilerEquivalenceToString(trivialCompilerEquivalence) << '\n'
   << "\t" << "use_cache: " << cachingToString(caching) << '\n'
+  << "\t" << "cache_size_limit: " << getCacheSizeLimit() << '\n'
+  << "\t" << "history_file: " << getHistoryFile() << '\n'
+  << "\t" << "journal_file: " << getJournalFile() << '\n'
+  << "\t" << "resume: " << (resumeEnabled() ? "yes" : "no") << '\n'
   << "\t" << "junk_detection: " << (junkDetectionEnabled() ? "enabled" : "disabled" ) << '\n'
   << "\t" << "diagnostics: " << diagnosticsToString(diagnostics) << '\n'
+  << "\t" << "report_output: " << reportOutputToString(reportOutput) << '\n'
   << "\t" << "emit_debug_info: " << emitDebugInfoToString(emitDebugInfo) << '\n';
 
   if (!mutators.empty()) {
@@ -418,6 +597,21 @@ std::vector<std::string> Config::validate() {
     }
   }
 
+  if (mutantTimeoutMultiplier <= 0) {
+    std::string error = "mutant_timeout_multiplier must be greater than zero.";
+    errors.push_back(error);
+  }
+
+  if (mutantTimeoutFloor < 0) {
+    std::string error = "mutant_timeout_floor cannot be negative.";
+    errors.push_back(error);
+  }
+
+  if (resume && journalFile.empty()) {
+    std::string error = "--resume requires the journal_file parameter.";
+    errors.push_back(error);
+  }
+
   return errors;
 }
 
@@ -430,7 +624,8 @@ void Config::normalizeParallelizationConfig() {
 }
 
 ParallelizationConfig::ParallelizationConfig()
-    : workers(0), testExecutionWorkers(0), mutantExecutionWorkers(0) {
+    : workers(0), testExecutionWorkers(0), mutantExecutionWorkers(0),
+      mutantCompilationWorkers(0), mutantTestWorkers(0) {
 }
 
 void ParallelizationConfig::normalize() {
@@ -445,6 +640,16 @@ void ParallelizationConfig::normalize() {
   if (mutantExecutionWorkers == 0) {
     mutantExecutionWorkers = workers;
   }
+
+  if (mutantCompilationWorkers == 0) {
+    mutantCompilationWorkers = workers;
+  }
+
+  /// Each mutant execution worker starts this many processes,
+  /// so it is not derived from the number of workers
+  if (mutantTestWorkers == 0) {
+    mutantTestWorkers = 1;
+  }
 }
 
 ParallelizationConfig ParallelizationConfig::defaultConfig() {
@@ -10,15 +10,25 @@
 #include "TestFinder.h"
 #include "TestRunner.h"
 #include "MutationsFinder.h"
+#include "MutationHistory.h"
+#include "MutationJournal.h"
+#include "Instrumentation/CallTreeCache.h"
 #include "Metrics/Metrics.h"
 #include "JunkDetection/JunkDetector.h"
 #include "Toolchain/JITEngine.h"
+#include "Toolchain/FunctionRedirection.h"
+#include "Toolchain/ObjectFileMapping.h"
+#include "Toolchain/TrivialCompilerEquivalence.h"
 #include "Parallelization/Parallelization.h"
+#include "Reporters/Reporter.h"
+#include "Reporters/ResultStream.h"
 
+#include <llvm/ADT/StringSet.h>
 #include <llvm/Support/DynamicLibrary.h>
 
 #include <algorithm>
 #include <fstream>
+#include <set>
 #include <vector>
 #include <sys/mman.h>
 #include <sys/types.h>
@@ -53,14 +63,20 @@ Driver::~Driver() {
 
 std::unique_ptr<Result> Driver::Run() {
   loadBitcodeFilesIntoMemory();
-  compileInstrumentedBitcodeFiles();
   loadPrecompiledObjectFiles();
   loadDynamicLibraries();
 
   auto tests = findTests();
   auto mutationPoints = findMutationPoints(tests);
   auto nonJunkMutationPoints = filterOutJunkMutations(std::move(mutationPoints));
+
+  for (auto reporter : reporters) {
+    reporter->beginResults(tests, nonJunkMutationPoints, config);
+  }
+
   auto mutationResults = runMutations(nonJunkMutationPoints);
+  measurePrecompiledObjectFiles();
+  measureLoadedModules();
 
   return make_unique<Result>(std::move(tests),
                              std::move(mutationResults),
@@ -126,6 +142,54 @@ void Driver::loadDynamicLibraries() {
   metrics.endLoadDynamicLibraries();
 }
 
+/// Precompiled object files stay loaded for the whole run, though
+/// only the pages that were actually read are kept in memory
+void Driver::measurePrecompiledObjectFiles() {
+  uint64_t size = 0;
+  uint64_t residentSize = 0;
+  for (auto &object : precompiledObjectFiles) {
+    StringRef data = object.getBinary()->getData();
+    size += data.size();
+    residentSize += ObjectFileMapping::residentSize(data);
+  }
+  metrics.setPrecompiledObjectFilesMemory(size, residentSize);
+}
+
+/// Function bodies are parsed on demand, only those reached
+/// by the tests are expected to be in memory by the end of the run
+void Driver::measureLoadedModules() {
+  std::vector<ContextMemory> contexts;
+  std::map<LLVMContext *, size_t> contextIndices;
+
+  for (auto &module : context.getModules()) {
+    LLVMContext *llvmContext = &module->getModule()->getContext();
+    if (contextIndices.count(llvmContext) == 0) {
+      contextIndices[llvmContext] = contexts.size();
+      contexts.push_back(ContextMemory());
+    }
+
+    ContextMemory &memory = contexts[contextIndices[llvmContext]];
+    memory.modules++;
+    memory.bitcodeSize += module->getBitcodeSize();
+
+    for (auto &function : *module->getModule()) {
+      if (function.isDeclaration()) {
+        continue;
+      }
+      memory.functions++;
+      if (function.isMaterializable()) {
+        continue;
+      }
+      memory.materializedFunctions++;
+      for (auto &block : function) {
+        memory.instructions += block.size();
+      }
+    }
+  }
+
+  metrics.setContextsMemory(contexts);
+}
+
 std::vector<std::unique_ptr<Test>> Driver::findTests() {
   metrics.beginFindTests();
   auto tests = finder.findTests(context, filter);
@@ -139,6 +203,26 @@ Driver::findMutationPoints(std::vector<std::unique_ptr<Test>> &tests) {
     return std::vector<MutationPoint *>();
   }
 
+  std::vector<std::unique_ptr<Testee>> testees;
+
+  /// The instrumented program is only compiled and run
+  /// if the program or the options changed since the last run
+  CallTreeCache callTreeCache(toolchain.cache(), context, config);
+  if (!callTreeCache.load(tests, testees)) {
+    testees = runOriginalTests(tests);
+    callTreeCache.store(tests, testees);
+  }
+
+  auto mergedTestees = mergeTestees(testees);
+  std::vector<MutationPoint *> mutationPoints = mutationsFinder.getMutationPoints(context, mergedTestees, filter);
+
+  return mutationPoints;
+}
+
+std::vector<std::unique_ptr<Testee>>
+Driver::runOriginalTests(std::vector<std::unique_ptr<Test>> &tests) {
+  compileInstrumentedBitcodeFiles();
+
   auto objectFiles = AllInstrumentedObjectFiles();
   JITEngine jit;
 
@@ -157,15 +241,12 @@ Driver::findMutationPoints(std::vector<std::unique_ptr<Test>> &tests) {
   testRunner.execute();
   metrics.endOriginalTestExecution();
 
-  auto mergedTestees = mergeTestees(testees);
-  std::vector<MutationPoint *> mutationPoints = mutationsFinder.getMutationPoints(context, mergedTestees, filter);
-
   {
     /// Cleans up the memory allocated for the vector itself as well
     std::vector<OwningBinary<ObjectFile>>().swap(instrumentedObjectFiles);
   }
 
-  return mutationPoints;
+  return testees;
 }
 
 std::vector<MutationPoint *>
@@ -191,6 +272,11 @@ Driver::runMutations(std::vector<MutationPoint *> &mutationPoints) {
     return std::vector<std::unique_ptr<MutationResult>>();
   }
 
+  for (auto mutationPoint : mutationPoints) {
+    pendingResults[mutationPoint] = mutationPoint->getReachableTests().size();
+    killedMutants[mutationPoint] = false;
+  }
+
   if (config.dryRunModeEnabled()) {
     return dryRunMutations(mutationPoints);
   }
@@ -198,6 +284,61 @@ Driver::runMutations(std::vector<MutationPoint *> &mutationPoints) {
   return normalRunMutations(mutationPoints);
 }
 
+void Driver::addReporter(Reporter *reporter) {
+  reporters.push_back(reporter);
+}
+
+void Driver::streamResult(MutationResult *result) {
+  if (resultStream) {
+    resultStream->push(result);
+  }
+}
+
+/// Runs on the thread of the result stream. Once reported, the outputs
+/// of the tests are not needed anymore unless a reporter reads them at
+/// the end, so usually only the statuses are kept in memory until the end
+/// of the run.
+void Driver::reportMutationResult(MutationResult &result) {
+  MutationPoint *mutationPoint = result.getMutationPoint();
+  ExecutionStatus status = result.getExecutionResult().status;
+
+  /// Equivalent and duplicate mutants were never run: a run with trivial
+  /// compiler equivalence disabled must not reuse these results, and which
+  /// one of several identical mutants runs differs from run to run
+  bool skipped = status == ExecutionStatus::Equivalent ||
+                 status == ExecutionStatus::Duplicate;
+
+  if (history && !skipped) {
+    history->record(history->mutantKey(*result.getMutationPoint()),
+                    history->testKey(*result.getTest()),
+                    result.getExecutionResult());
+  }
+  if (journal && !skipped) {
+    journal->record(result.getMutationPoint()->getUniqueIdentifier(),
+                    result.getTest()->getUniqueIdentifier(),
+                    result.getExecutionResult());
+  }
+
+  bool outputsNeeded = false;
+  for (auto reporter : reporters) {
+    reporter->reportMutationResult(result);
+    outputsNeeded = outputsNeeded || reporter->needsOutputsOfResults();
+  }
+
+  if (killsMutant(status)) {
+    killedMutants[mutationPoint] = true;
+  }
+  if (--pendingResults[mutationPoint] == 0 && !skipped) {
+    diagnostics->report(mutationPoint, killedMutants[mutationPoint]);
+  }
+
+  if (!outputsNeeded) {
+    ExecutionResult &executionResult = result.getExecutionResult();
+    std::string().swap(executionResult.stdoutOutput);
+    std::string().swap(executionResult.stderrOutput);
+  }
+}
+
 #pragma mark -
 
 std::vector<std::unique_ptr<MutationResult>>
@@ -206,20 +347,208 @@ Driver::dryRunMutations(const std::vector<MutationPoint *> &mutationPoints) {
 
   std::vector<DryRunMutantExecutionTask> tasks;
   for (int i = 0; i < config.parallelization().workers; i++) {
-    tasks.emplace_back(DryRunMutantExecutionTask());
+    tasks.emplace_back(config);
   }
   metrics.beginMutantsExecution();
   TaskExecutor<DryRunMutantExecutionTask> mutantRunner("Running mutants (dry run)", mutationPoints, mutationResults, std::move(tasks));
   mutantRunner.execute();
   metrics.endMutantsExecution();
 
+  for (auto &result : mutationResults) {
+    reportMutationResult(*result);
+  }
+
   return mutationResults;
 }
 
+/// The settings that change the results of the mutants without changing
+/// the code, see MutationHistory
+static std::string historySettings(const Config &config) {
+  std::string settings;
+  settings += "fail_fast=" + std::to_string(config.failFastModeEnabled());
+  settings += ";mutant_timeout_multiplier=" +
+              std::to_string(config.getMutantTimeoutMultiplier());
+  settings += ";mutant_timeout_floor=" +
+              std::to_string(config.getMutantTimeoutFloor());
+  return settings;
+}
+
 std::vector<std::unique_ptr<MutationResult>> Driver::normalRunMutations(const std::vector<MutationPoint *> &mutationPoints) {
+  MutationJournal journal(config.getJournalFile(), config.resumeEnabled());
+  MutationHistory history(config.getHistoryFile(), historySettings(config));
+
+  std::vector<std::unique_ptr<MutationResult>> mutationResults;
+  std::vector<MutationPoint *> unfinishedMutationPoints =
+      resumeMutationResults(journal, mutationPoints, mutationResults);
+
+  /// The interrupted run may not have committed its results to the history,
+  /// so the resumed ones are recorded there again, but not in the journal
+  if (history.isEnabled()) {
+    this->history = &history;
+  }
+  for (auto &result : mutationResults) {
+    reportMutationResult(*result);
+  }
+  this->history = nullptr;
+
+  size_t resumedResults = mutationResults.size();
+  std::vector<MutationPoint *> changedMutationPoints =
+      reuseMutationResults(history, unfinishedMutationPoints, mutationResults);
+
+  /// Reused results are journaled, but not recorded in the history again
+  if (journal.isEnabled()) {
+    this->journal = &journal;
+  }
+  for (size_t i = resumedResults; i < mutationResults.size(); i++) {
+    reportMutationResult(*mutationResults[i]);
+  }
+
+  if (history.isEnabled()) {
+    /// The keys are computed upfront, while the mutants run
+    /// the stream only looks them up
+    for (auto mutationPoint : changedMutationPoints) {
+      history.mutantKey(*mutationPoint);
+      for (auto &reachableTest : mutationPoint->getReachableTests()) {
+        history.testKey(*reachableTest.first);
+      }
+    }
+    this->history = &history;
+  }
+
+  std::vector<std::unique_ptr<MutationResult>> newResults;
+  {
+    ResultStream stream([this](MutationResult &result) {
+      reportMutationResult(result);
+    });
+    resultStream = &stream;
+    newResults = executeMutations(changedMutationPoints);
+    stream.finish();
+    resultStream = nullptr;
+  }
+  this->history = nullptr;
+  this->journal = nullptr;
+
+  for (auto &result : newResults) {
+    mutationResults.push_back(std::move(result));
+  }
+  history.save();
+
+  /// Restore the order in which the mutation points were found
+  std::map<MutationPoint *, size_t> originalOrder;
+  for (size_t i = 0; i < mutationPoints.size(); i++) {
+    originalOrder.insert(std::make_pair(mutationPoints[i], i));
+  }
+
+  std::stable_sort(mutationResults.begin(), mutationResults.end(),
+                   [&](const std::unique_ptr<MutationResult> &lhs,
+                       const std::unique_ptr<MutationResult> &rhs) {
+                     return originalOrder[lhs->getMutationPoint()] <
+                            originalOrder[rhs->getMutationPoint()];
+                   });
+
+  return mutationResults;
+}
+
+/// A mutant is resumed only if the interrupted run has finished it,
+/// a mutant with some of its tests missing is run again
+std::vector<MutationPoint *>
+Driver::resumeMutationResults(MutationJournal &journal,
+                              const std::vector<MutationPoint *> &mutationPoints,
+                              std::vector<std::unique_ptr<MutationResult>> &mutationResults) {
+  if (!config.resumeEnabled() || !journal.isEnabled()) {
+    return mutationPoints;
+  }
+
+  std::vector<MutationPoint *> unfinishedMutationPoints;
+  for (auto mutationPoint : mutationPoints) {
+    const std::string mutantKey = mutationPoint->getUniqueIdentifier();
+
+    std::vector<std::unique_ptr<MutationResult>> journaledResults;
+    for (auto &reachableTest : mutationPoint->getReachableTests()) {
+      ExecutionResult result;
+      if (!journal.lookup(mutantKey, reachableTest.first->getUniqueIdentifier(), result)) {
+        break;
+      }
+      journaledResults.push_back(make_unique<MutationResult>(result,
+                                                             mutationPoint,
+                                                             reachableTest.second,
+                                                             reachableTest.first));
+    }
+
+    if (journaledResults.size() != mutationPoint->getReachableTests().size()) {
+      unfinishedMutationPoints.push_back(mutationPoint);
+      continue;
+    }
+
+    for (auto &result : journaledResults) {
+      mutationResults.push_back(std::move(result));
+    }
+  }
+
+  Logger::info() << "Resuming: "
+                 << mutationPoints.size() - unfinishedMutationPoints.size()
+                 << " out of " << mutationPoints.size()
+                 << " mutants are already finished\n";
+
+  return unfinishedMutationPoints;
+}
+
+/// A mutant is only run again if the result of at least one
+/// of its tests cannot be reused
+std::vector<MutationPoint *>
+Driver::reuseMutationResults(MutationHistory &history,
+                             const std::vector<MutationPoint *> &mutationPoints,
+                             std::vector<std::unique_ptr<MutationResult>> &mutationResults) {
+  if (!history.isEnabled()) {
+    return mutationPoints;
+  }
+
+  std::vector<MutationPoint *> changedMutationPoints;
+  for (auto mutationPoint : mutationPoints) {
+    const std::string &mutantKey = history.mutantKey(*mutationPoint);
+
+    std::vector<std::unique_ptr<MutationResult>> previousResults;
+    for (auto &reachableTest : mutationPoint->getReachableTests()) {
+      ExecutionResult result;
+      if (!history.lookup(mutantKey, history.testKey(*reachableTest.first), result)) {
+        break;
+      }
+      previousResults.push_back(make_unique<MutationResult>(result,
+                                                            mutationPoint,
+                                                            reachableTest.second,
+                                                            reachableTest.first));
+    }
+
+    if (previousResults.size() != mutationPoint->getReachableTests().size()) {
+      changedMutationPoints.push_back(mutationPoint);
+      continue;
+    }
+
+    for (auto &result : previousResults) {
+      mutationResults.push_back(std::move(result));
+    }
+  }
+
+  Logger::info() << "Reusing the results of "
+                 << mutationPoints.size() - changedMutationPoints.size()
+                 << " out of " << mutationPoints.size() << " mutants\n";
+
+  return changedMutationPoints;
+}
+
+std::vector<std::unique_ptr<MutationResult>>
+Driver::executeMutations(const std::vector<MutationPoint *> &mutationPoints) {
+  if (mutationPoints.empty()) {
+    return std::vector<std::unique_ptr<MutationResult>>();
+  }
+
+  if (config.getMutantCompilation() == Config::MutantCompilation::Schemata) {
+    weaveSchemata(mutationPoints);
+  }
+
   std::vector<OriginalCompilationTask> compilationTasks;
   for (int i = 0; i < config.parallelization().workers; i++) {
-    compilationTasks.emplace_back(toolchain);
+    compilationTasks.emplace_back(config, toolchain, schemata);
   }
   TaskExecutor<OriginalCompilationTask> mutantCompiler("Compiling original code", context.getModules(), ownedObjectFiles, std::move(compilationTasks));
   mutantCompiler.execute();
@@ -232,18 +561,86 @@ std::vector<std::unique_ptr<MutationResult>> Driver::normalRunMutations(const st
 
   std::vector<std::unique_ptr<MutationResult>> mutationResults;
 
-  std::vector<MutantExecutionTask> tasks;
+  /// Mutants are scheduled longest-first, so that the most expensive ones
+  /// do not end up on a single worker at the very end of the phase.
+  std::vector<MutationPoint *> scheduledMutationPoints =
+      longestFirst(mutationPoints);
+
+  std::vector<llvm::object::ObjectFile *> stableObjects;
+  if (config.incrementalLinkingEnabled()) {
+    stableObjects = stableObjectFiles(mutationPoints);
+  }
+
+  TrivialCompilerEquivalence equivalence;
+  std::vector<MutantCompilationTask> mutantCompilationTasks;
+  for (int i = 0; i < config.parallelization().mutantCompilationWorkers; i++) {
+    mutantCompilationTasks.emplace_back(*this, config, toolchain, metrics, equivalence);
+  }
+
+  std::vector<MutantExecutionTask> mutantExecutionTasks;
   for (int i = 0; i < config.parallelization().mutantExecutionWorkers; i++) {
-    tasks.emplace_back(*this, *sandbox, runner, config, toolchain, filter);
+    mutantExecutionTasks.emplace_back(*this, *sandbox, runner, config, toolchain, filter, metrics);
+    mutantExecutionTasks.back().jit.setStableObjectFiles(stableObjects);
+  }
+
+  /// The servers are forked while the result stream is the only other
+  /// thread, and it is idle. Moving the vector into the pipeline keeps
+  /// the tasks at their addresses.
+  if (config.forkServerEnabled()) {
+    for (auto &task : mutantExecutionTasks) {
+      task.startForkServer();
+    }
   }
+
   metrics.beginMutantsExecution();
-  TaskExecutor<MutantExecutionTask> mutantRunner("Running mutants", mutationPoints, mutationResults, std::move(tasks));
+  MutantPipeline<MutantCompilationTask, MutantExecutionTask>
+    mutantRunner("Running mutants", scheduledMutationPoints, mutationResults,
+                 std::move(mutantCompilationTasks), std::move(mutantExecutionTasks));
   mutantRunner.execute();
   metrics.endMutantsExecution();
 
+  if (config.trivialCompilerEquivalenceEnabled()) {
+    Logger::info() << "Skipped " << equivalence.equivalentCount()
+                   << " equivalent and " << equivalence.duplicateCount()
+                   << " duplicate mutants\n";
+  }
+
   return mutationResults;
 }
 
+/// The cost of a mutant is estimated as the time it took to run the tests
+/// reaching the mutant against the original program.
+static long long estimatedCost(MutationPoint *mutationPoint) {
+  long long cost = 0;
+  for (auto &reachableTest : mutationPoint->getReachableTests()) {
+    Test *test = reachableTest.first;
+    cost += test->getExecutionResult().cost();
+  }
+  return cost;
+}
+
+std::vector<MutationPoint *>
+Driver::longestFirst(const std::vector<MutationPoint *> &mutationPoints) {
+  std::vector<std::pair<long long, MutationPoint *>> costs;
+  costs.reserve(mutationPoints.size());
+  for (auto point : mutationPoints) {
+    costs.push_back(std::make_pair(estimatedCost(point), point));
+  }
+
+  std::stable_sort(costs.begin(), costs.end(),
+                   [](const std::pair<long long, MutationPoint *> &lhs,
+                      const std::pair<long long, MutationPoint *> &rhs) {
+                     return lhs.first > rhs.first;
+                   });
+
+  std::vector<MutationPoint *> sorted;
+  sorted.reserve(costs.size());
+  for (auto &pair : costs) {
+    sorted.push_back(pair.second);
+  }
+  return sorted;
+}
+
 std::vector<llvm::object::ObjectFile *> Driver::AllButOne(llvm::Module *One) {
   std::vector<llvm::object::ObjectFile *> Objects;
 
@@ -260,6 +657,121 @@ std::vector<llvm::object::ObjectFile *> Driver::AllButOne(llvm::Module *One) {
   return Objects;
 }
 
+int Driver::schemataID(MutationPoint *mutationPoint) {
+  auto it = schemataIDs.find(mutationPoint);
+  if (it == schemataIDs.end()) {
+    return 0;
+  }
+  return it->second;
+}
+
+/// Mutants that can be redirected are woven into their modules,
+/// the rest are compiled separately as whole modules
+void Driver::weaveSchemata(const std::vector<MutationPoint *> &mutationPoints) {
+  for (auto point : mutationPoints) {
+    if (!FunctionRedirection::canRedirect(*point)) {
+      continue;
+    }
+    auto &woven = schemata[point->getOriginalModule()->getModule()];
+    woven.push_back(point);
+    schemataIDs.insert(std::make_pair(point, int(woven.size())));
+  }
+}
+
+/// Stable object files never change between mutants, so they can be linked
+/// once per worker: these are precompiled object files and modules without
+/// mutation points. An object file is only stable if all the symbols it needs
+/// come from other stable object files or from the process, otherwise it
+/// would keep pointing to the original version of a mutated module.
+/// With function-level compilation and mutant schemata, modules are not
+/// relinked for the mutants that can be redirected.
+std::vector<llvm::object::ObjectFile *>
+Driver::stableObjectFiles(const std::vector<MutationPoint *> &mutationPoints) {
+  bool functionCompilation =
+    config.getMutantCompilation() != Config::MutantCompilation::Module;
+
+  std::set<llvm::Module *> mutatedModules;
+  for (auto point : mutationPoints) {
+    if (functionCompilation && FunctionRedirection::canRedirect(*point)) {
+      continue;
+    }
+    mutatedModules.insert(point->getOriginalModule()->getModule());
+  }
+
+  std::vector<llvm::object::ObjectFile *> candidates;
+  std::vector<llvm::object::ObjectFile *> unstable;
+  for (auto &cachedEntry : innerCache) {
+    if (mutatedModules.count(cachedEntry.first)) {
+      unstable.push_back(cachedEntry.second);
+    } else {
+      candidates.push_back(cachedEntry.second);
+    }
+  }
+  for (auto &object : precompiledObjectFiles) {
+    candidates.push_back(object.getBinary());
+  }
+
+  return withoutUnstableDependencies(candidates, unstable);
+}
+
+/// Repeats until no candidate depends on a symbol defined by an unstable
+/// object file, since dropping a candidate makes its symbols unstable too
+std::vector<llvm::object::ObjectFile *>
+Driver::withoutUnstableDependencies(std::vector<llvm::object::ObjectFile *> candidates,
+                                    const std::vector<llvm::object::ObjectFile *> &unstable) {
+  llvm::StringSet<> unstableSymbols;
+  auto collectDefinedSymbols = [&](llvm::object::ObjectFile *object) {
+    for (auto symbol : object->symbols()) {
+      if (symbol.getFlags() & llvm::object::SymbolRef::SF_Undefined) {
+        continue;
+      }
+      auto name = symbol.getName();
+      if (!name) {
+        consumeError(name.takeError());
+        continue;
+      }
+      unstableSymbols.insert(name.get());
+    }
+  };
+  auto dependsOnUnstableSymbols = [&](llvm::object::ObjectFile *object) {
+    for (auto symbol : object->symbols()) {
+      if (!(symbol.getFlags() & llvm::object::SymbolRef::SF_Undefined)) {
+        continue;
+      }
+      auto name = symbol.getName();
+      if (!name) {
+        consumeError(name.takeError());
+        continue;
+      }
+      if (unstableSymbols.count(name.get())) {
+        return true;
+      }
+    }
+    return false;
+  };
+
+  for (auto object : unstable) {
+    collectDefinedSymbols(object);
+  }
+
+  bool changed = true;
+  while (changed) {
+    changed = false;
+    std::vector<llvm::object::ObjectFile *> stable;
+    for (auto object : candidates) {
+      if (dependsOnUnstableSymbols(object)) {
+        collectDefinedSymbols(object);
+        changed = true;
+      } else {
+        stable.push_back(object);
+      }
+    }
+    candidates.swap(stable);
+  }
+
+  return candidates;
+}
+
 std::vector<llvm::object::ObjectFile *> Driver::AllInstrumentedObjectFiles() {
   std::vector<llvm::object::ObjectFile *> objects;
 
@@ -284,10 +796,11 @@ Driver::Driver(Config &C,
                Metrics &metrics,
                JunkDetector &junkDetector)
     : config(C), loader(ML), finder(TF), runner(TR), toolchain(t), filter(f), mutationsFinder(mutationsFinder),
-      precompiledObjectFiles(), instrumentation(), metrics(metrics), junkDetector(junkDetector) {
+      precompiledObjectFiles(), instrumentation(), metrics(metrics), junkDetector(junkDetector),
+      resultStream(nullptr), history(nullptr), journal(nullptr) {
 
   if (C.forkEnabled()) {
-    this->sandbox = new ForkProcessSandbox();
+    this->sandbox = new ForkProcessSandbox(C.getMaxOutputSize());
   } else {
     this->sandbox = new NullProcessSandbox();
   }
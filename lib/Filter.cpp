@@ -10,7 +10,16 @@ using namespace llvm;
 using namespace mull;
 
 bool Filter::shouldSkipInstruction(llvm::Instruction *instruction) {
+  /// Computing the location is not free
+  if (locations.empty()) {
+    return false;
+  }
+
   SourceLocation location = SourceLocation::sourceLocationFromInstruction(instruction);
+  return shouldSkipLocation(location);
+}
+
+bool Filter::shouldSkipLocation(const SourceLocation &location) {
   if (location.isNull()) {
     return false;
   }
@@ -3,20 +3,41 @@
 #include "Logger.h"
 #include "ExecutionResult.h"
 
+#include <algorithm>
 #include <cerrno>
 #include <chrono>
 #include <csignal>
 #include <cstring>
+#include <fcntl.h>
+#include <poll.h>
 #include <sys/mman.h>
 #include <sys/types.h>
 #include <sys/wait.h>
-#include <sys/time.h>
 #include <thread>
+#include <time.h>
 #include <unistd.h>
-#include <llvm/Support/FileSystem.h>
+
+#ifdef __linux__
+#include <sys/prctl.h>
+#endif
 
 using namespace std::chrono;
 
+/// Written by the child, read by the parent once the child exits
+struct SharedState {
+  mull::ExecutionStatus status;
+  long long testRunTime;
+  long long cpuTime;
+};
+
+static long long cpuTimeMicroseconds(clockid_t clock) {
+  struct timespec time;
+  if (clock_gettime(clock, &time) != 0) {
+    return 0;
+  }
+  return (long long)time.tv_sec * 1000000 + time.tv_nsec / 1000;
+}
+
 static pid_t mullFork(const char *processName) {
 //  static int childrenCount = 0;
 //  childrenCount++;
@@ -33,104 +54,223 @@ static pid_t mullFork(const char *processName) {
   return pid;
 }
 
-static std::string readFileAndUnlink(const char *filename) {
-  FILE *file = fopen(filename, "r");
-  if (!file) {
-    perror("fopen");
-    printf("fopen: %s\n", filename);
-    return std::string("Mull error: could not read output");
+/// Appends what is available in the pipe to the output, but keeps at most
+/// maxOutputSize bytes (0 means unlimited). The rest is read and dropped,
+/// otherwise a chatty child would block on a full pipe.
+/// Returns false once the pipe is closed.
+static bool drainPipe(int descriptor, std::string &output, size_t maxOutputSize) {
+  char buffer[4096];
+  ssize_t bytesRead = read(descriptor, buffer, sizeof(buffer));
+  if (bytesRead == -1) {
+    return errno == EINTR || errno == EAGAIN;
   }
-  if (unlink(filename) == -1) {
-    perror("unlink");
-    printf("unlink: %s\n", filename);
+  if (bytesRead == 0) {
+    return false;
   }
 
-  fseek(file, 0, SEEK_END);
-  int size = ftell(file);
-  rewind(file);
-
-  char *buffer = (char *)malloc(sizeof(char) * (size + 1));
-  fread(buffer, sizeof(char), size, file);
-  buffer[size] = '\0';
-  std::string output(buffer);
-  free(buffer);
-  fclose(file);
-
-  return output;
+  size_t bytesToKeep = size_t(bytesRead);
+  if (maxOutputSize != 0) {
+    size_t room = maxOutputSize > output.size() ? maxOutputSize - output.size() : 0;
+    bytesToKeep = std::min(bytesToKeep, room);
+  }
+  output.append(buffer, bytesToKeep);
+  return true;
 }
 
-void handle_alarm_signal(int signal, siginfo_t *info, void *context) {
-  _exit(mull::ForkProcessSandbox::MullTimeoutCode);
+/// Checks whether the worker has exited, but leaves it a zombie: while it is
+/// not reaped, its process group cannot be reused by an unrelated process
+static bool workerExited(pid_t workerPID) {
+  siginfo_t info;
+  memset(&info, 0, sizeof(info));
+  if (waitid(P_PID, workerPID, &info, WEXITED | WNOHANG | WNOWAIT) == -1) {
+    return errno != EINTR;
+  }
+  return info.si_pid == workerPID;
 }
 
-void handle_timeout(long long timeoutMilliseconds) {
-  struct sigaction action;
-  memset(&action, 0, sizeof(action));
-  action.sa_sigaction = &handle_alarm_signal;
-  if (sigaction(SIGALRM, &action, nullptr) != 0) {
-    perror("sigaction");
-    abort();
+/// The worker and everything it starts can be killed at once.
+/// Outside of the terminal's process group, the worker does not get
+/// the interrupt, so it has to go away along with its parent instead.
+static void detachWorker(pid_t parentPID) {
+  setpgid(0, 0);
+#ifdef __linux__
+  prctl(PR_SET_PDEATHSIG, SIGKILL);
+  if (getppid() != parentPID) {
+    _exit(1);
   }
+#endif
+}
+
+enum class WorkerEnd { Exited, TimedOut, Cancelled };
+
+/// Collects the output of the worker until it exits. The deadline is
+/// enforced here rather than in the worker, where the test could block or
+/// override the signal. Once the worker is out of time, cancelled, or has
+/// exited, its whole process group is killed, so the processes started by
+/// the test do not outlive it.
+static WorkerEnd watchWorker(pid_t workerPID, steady_clock::time_point deadline,
+                             const std::atomic<bool> *cancelled,
+                             int stdoutDescriptor, int stderrDescriptor,
+                             std::string &stdoutOutput, std::string &stderrOutput,
+                             size_t maxOutputSize, long long &captureTime) {
+  struct pollfd pipes[2];
+  pipes[0].fd = stdoutDescriptor;
+  pipes[0].events = POLLIN;
+  pipes[1].fd = stderrDescriptor;
+  pipes[1].events = POLLIN;
+  std::string *outputs[2] = { &stdoutOutput, &stderrOutput };
 
-  struct itimerval timer;
-  timer.it_value.tv_sec = timeoutMilliseconds / 1000;
-  /// Cut off seconds, and convert what's left into microseconds
-  timer.it_value.tv_usec = (timeoutMilliseconds % 1000) * 1000;
+  /// A cancelled worker should stop soon, its siblings are waiting for it
+  const long long checkInterval = cancelled ? 10 : 100;
 
-  /// Do not repeat
-  timer.it_interval.tv_sec = 0;
-  timer.it_interval.tv_usec = 0;
+  bool exited = false;
+  WorkerEnd end = WorkerEnd::Exited;
+  while (!exited || pipes[0].fd != -1 || pipes[1].fd != -1) {
+    pipes[0].revents = 0;
+    pipes[1].revents = 0;
+
+    /// The pipes may be inherited by processes that left the process group
+    /// and stay open after the worker exits, so the worker is checked
+    /// periodically. Once the pipes are closed, the worker is about to exit.
+    long long waitTime = 0;
+    if (!exited) {
+      bool pipesOpen = pipes[0].fd != -1 || pipes[1].fd != -1;
+      waitTime = duration_cast<milliseconds>(deadline - steady_clock::now()).count();
+      waitTime = std::max(0LL, std::min(pipesOpen ? checkInterval : 1LL, waitTime));
+    }
+
+    int ready = poll(pipes, 2, int(waitTime));
+    if (ready == -1) {
+      ready = 0;
+    }
 
-  if (setitimer(ITIMER_REAL, &timer, nullptr) != 0) {
-    perror("setitimer");
-    abort();
+    for (int i = 0; i < 2; i++) {
+      if (pipes[i].fd == -1 || pipes[i].revents == 0) {
+        continue;
+      }
+      auto readStart = steady_clock::now();
+      bool open = drainPipe(pipes[i].fd, *outputs[i], maxOutputSize);
+      captureTime += duration_cast<microseconds>(steady_clock::now() - readStart).count();
+      if (!open) {
+        close(pipes[i].fd);
+        pipes[i].fd = -1;
+      }
+    }
+
+    if (exited) {
+      if (ready == 0) {
+        break;
+      }
+      continue;
+    }
+
+    if (workerExited(workerPID)) {
+      exited = true;
+      kill(-workerPID, SIGKILL);
+    } else if (end == WorkerEnd::Exited) {
+      if (steady_clock::now() >= deadline) {
+        end = WorkerEnd::TimedOut;
+        kill(-workerPID, SIGKILL);
+      } else if (cancelled && cancelled->load()) {
+        end = WorkerEnd::Cancelled;
+        kill(-workerPID, SIGKILL);
+      }
+    }
+  }
+
+  for (int i = 0; i < 2; i++) {
+    if (pipes[i].fd != -1) {
+      close(pipes[i].fd);
+    }
   }
+
+  return end;
 }
 
+mull::ForkProcessSandbox::ForkProcessSandbox(size_t maxOutputSize)
+  : maxOutputSize(maxOutputSize) {}
+
 mull::ExecutionResult
 mull::ForkProcessSandbox::run(std::function<ExecutionStatus (void)> function,
-                              long long timeoutMilliseconds) {
-  llvm::SmallString<32> stderrFilename;
-  llvm::sys::fs::createUniqueFile("/tmp/mull.stderr.%%%%%%", stderrFilename);
+                              long long timeoutMilliseconds,
+                              const std::atomic<bool> *cancelled) {
+  if (cancelled && cancelled->load()) {
+    ExecutionResult result;
+    result.status = FailFast;
+    return result;
+  }
 
-  llvm::SmallString<32> stdoutFilename;
-  llvm::sys::fs::createUniqueFile("/tmp/mull.stdout.%%%%%%", stdoutFilename);
+  int stdoutPipe[2];
+  int stderrPipe[2];
+  if (pipe(stdoutPipe) == -1 || pipe(stderrPipe) == -1) {
+    mull::Logger::error() << "Failed to create pipes: " << strerror(errno) << "\n";
+    mull::Logger::error() << "Shutting down\n";
+    exit(1);
+  }
 
   /// Creating a memory to be shared between child and parent.
-  ExecutionStatus *sharedStatus = (ExecutionStatus *)mmap(nullptr,
-                                                          sizeof(ExecutionStatus),
-                                                          PROT_READ | PROT_WRITE,
-                                                          MAP_SHARED | MAP_ANONYMOUS,
-                                                          -1,
-                                                          0);
+  SharedState *sharedState = (SharedState *)mmap(nullptr,
+                                                 sizeof(SharedState),
+                                                 PROT_READ | PROT_WRITE,
+                                                 MAP_SHARED | MAP_ANONYMOUS,
+                                                 -1,
+                                                 0);
+  sharedState->status = Invalid;
+  sharedState->testRunTime = 0;
+  sharedState->cpuTime = 0;
 
+  const pid_t parentPID = getpid();
   auto start = high_resolution_clock::now();
   const pid_t workerPID = mullFork("worker");
+  auto forked = high_resolution_clock::now();
   if (workerPID == 0) {
-    freopen(stderrFilename.c_str(), "w", stderr);
-    freopen(stdoutFilename.c_str(), "w", stdout);
+    detachWorker(parentPID);
 
-    handle_timeout(timeoutMilliseconds);
+    fflush(stderr);
+    fflush(stdout);
+    dup2(stderrPipe[1], STDERR_FILENO);
+    dup2(stdoutPipe[1], STDOUT_FILENO);
+    close(stderrPipe[0]);
+    close(stderrPipe[1]);
+    close(stdoutPipe[0]);
+    close(stdoutPipe[1]);
 
-    *sharedStatus = function();
+    auto testStart = steady_clock::now();
+    auto cpuStart = cpuTimeMicroseconds(CLOCK_PROCESS_CPUTIME_ID);
+    sharedState->status = function();
+    sharedState->cpuTime = cpuTimeMicroseconds(CLOCK_PROCESS_CPUTIME_ID) - cpuStart;
+    sharedState->testRunTime =
+      duration_cast<microseconds>(steady_clock::now() - testStart).count();
 
     fflush(stderr);
     fflush(stdout);
     _exit(MullExitCode);
   } else {
+    /// Also set here, so that the group exists by the time it is killed
+    setpgid(workerPID, workerPID);
+
+    close(stderrPipe[1]);
+    close(stdoutPipe[1]);
+
+    ExecutionResult result;
+    auto deadline = steady_clock::now() + milliseconds(timeoutMilliseconds);
+    WorkerEnd end = watchWorker(workerPID, deadline, cancelled,
+                                stdoutPipe[0], stderrPipe[0],
+                                result.stdoutOutput, result.stderrOutput,
+                                maxOutputSize, result.outputCaptureTime);
+
     int status = 0;
-    pid_t pid = 0;
-    while ( (pid = waitpid(workerPID, &status, 0)) == -1 ) {}
+    while (waitpid(workerPID, &status, 0) == -1 && errno == EINTR) {}
 
     auto elapsed = high_resolution_clock::now() - start;
-    ExecutionResult result;
     result.runningTime = duration_cast<std::chrono::milliseconds>(elapsed).count();
+    result.forkTime = duration_cast<microseconds>(forked - start).count();
+    result.testRunTime = sharedState->testRunTime;
+    result.cpuTime = sharedState->cpuTime;
     result.exitStatus = WEXITSTATUS(status);
-    result.stderrOutput = readFileAndUnlink(stderrFilename.c_str());
-    result.stdoutOutput = readFileAndUnlink(stdoutFilename.c_str());
-    result.status = *sharedStatus;
+    result.status = sharedState->status;
 
-    int munmapResult = munmap(sharedStatus, sizeof(ExecutionStatus));
+    int munmapResult = munmap(sharedState, sizeof(SharedState));
 
     /// Check that mummap succeeds:
     /// "On success, munmap() returns 0, on failure -1, and errno is set (probably to EINVAL)."
@@ -138,14 +278,18 @@ mull::ForkProcessSandbox::run(std::function<ExecutionStatus (void)> function,
     assert(munmapResult == 0);
     (void)munmapResult;
 
-    if (WIFSIGNALED(status)) {
-      result.status = Crashed;
+    if (end == WorkerEnd::Cancelled) {
+      result.status = FailFast;
     }
 
-    else if (WIFEXITED(status) && WEXITSTATUS(status) == MullTimeoutCode) {
+    else if (end == WorkerEnd::TimedOut) {
       result.status = Timedout;
     }
 
+    else if (WIFSIGNALED(status)) {
+      result.status = Crashed;
+    }
+
     else if (WIFEXITED(status) && WEXITSTATUS(status) != MullExitCode) {
       result.status = AbnormalExit;
     }
@@ -154,9 +298,346 @@ mull::ForkProcessSandbox::run(std::function<ExecutionStatus (void)> function,
   }
 }
 
+std::vector<mull::ExecutionResult>
+mull::ProcessSandbox::runBatch(const std::vector<std::function<ExecutionStatus ()>> &functions,
+                               const std::vector<long long> &timeouts,
+                               bool stopOnFailure) {
+  std::vector<ExecutionResult> results(functions.size());
+  bool failed = false;
+  for (size_t i = 0; i < functions.size(); i++) {
+    if (stopOnFailure && failed) {
+      results[i].status = FailFast;
+      continue;
+    }
+    results[i] = run(functions[i], timeouts[i]);
+    failed = results[i].status != Passed;
+  }
+  return results;
+}
+
+/// Written by the batch worker after each test, read by the parent once
+/// the worker exits
+struct BatchEntry {
+  mull::ExecutionStatus status;
+  long long testRunTime;
+  long long cpuTime;
+};
+
+/// Reads the progress bytes left in the pipe without blocking.
+/// The worker may write its last bytes right before it exits.
+static size_t drainProgress(int progressDescriptor) {
+  if (progressDescriptor == -1) {
+    return 0;
+  }
+
+  struct pollfd progress;
+  progress.fd = progressDescriptor;
+  progress.events = POLLIN;
+
+  size_t drained = 0;
+  for (;;) {
+    progress.revents = 0;
+    if (poll(&progress, 1, 0) <= 0) {
+      break;
+    }
+    char buffer[256];
+    ssize_t bytesRead = read(progressDescriptor, buffer, sizeof(buffer));
+    if (bytesRead == -1 && errno == EINTR) {
+      continue;
+    }
+    if (bytesRead <= 0) {
+      break;
+    }
+    drained += size_t(bytesRead);
+  }
+  return drained;
+}
+
+/// Reads everything that is already in the output pipes without blocking,
+/// closes the pipes that reached the end
+static void drainOutputs(struct pollfd *pipes, mull::ExecutionResult &result,
+                         size_t maxOutputSize) {
+  std::string *outputs[2] = { &result.stdoutOutput, &result.stderrOutput };
+  auto captureStart = steady_clock::now();
+  while (pipes[0].fd != -1 || pipes[1].fd != -1) {
+    pipes[0].revents = 0;
+    pipes[1].revents = 0;
+    if (poll(pipes, 2, 0) <= 0) {
+      break;
+    }
+    for (int i = 0; i < 2; i++) {
+      if (pipes[i].fd == -1 || pipes[i].revents == 0) {
+        continue;
+      }
+      if (!drainPipe(pipes[i].fd, *outputs[i], maxOutputSize)) {
+        close(pipes[i].fd);
+        pipes[i].fd = -1;
+      }
+    }
+  }
+  result.outputCaptureTime +=
+    duration_cast<microseconds>(steady_clock::now() - captureStart).count();
+}
+
+/// Waits for the batch worker to exit, and collects the output of each test
+/// into its result. The worker writes a byte into the progress pipe after
+/// each test, and waits for the acknowledgement before the next one, so the
+/// output in the pipes at that moment belongs to the finished test, and
+/// every test gets its own deadline.
+/// Returns the number of tests the worker has reported as finished.
+static size_t watchBatch(pid_t workerPID, int progressDescriptor,
+                         int acknowledgeDescriptor,
+                         int stdoutDescriptor, int stderrDescriptor,
+                         const std::vector<long long> &timeouts,
+                         const BatchEntry *entries, bool stopOnFailure,
+                         size_t maxOutputSize,
+                         std::vector<mull::ExecutionResult> &results,
+                         bool &timedOut) {
+  /// Progress, then the outputs
+  struct pollfd pipes[3];
+  pipes[0].fd = progressDescriptor;
+  pipes[1].fd = stdoutDescriptor;
+  pipes[2].fd = stderrDescriptor;
+  for (auto &pipe : pipes) {
+    pipe.events = POLLIN;
+  }
+  struct pollfd *outputPipes = pipes + 1;
+
+  size_t finished = 0;
+  timedOut = false;
+  auto deadline = steady_clock::now() + milliseconds(timeouts.front());
+
+  for (;;) {
+    /// The test that is running, or the last one once all have finished
+    mull::ExecutionResult &current = results[std::min(finished, results.size() - 1)];
+
+    for (auto &pipe : pipes) {
+      pipe.revents = 0;
+    }
+    long long waitTime = duration_cast<milliseconds>(deadline - steady_clock::now()).count();
+    waitTime = std::max(0LL, std::min(pipes[0].fd != -1 ? 100LL : 1LL, waitTime));
+    if (timedOut) {
+      waitTime = 1;
+    }
+
+    if (poll(pipes, 3, int(waitTime)) > 0) {
+      if (outputPipes[0].revents != 0 || outputPipes[1].revents != 0) {
+        drainOutputs(outputPipes, current, maxOutputSize);
+      }
+
+      if (pipes[0].revents != 0) {
+        char done = 0;
+        ssize_t bytesRead = read(pipes[0].fd, &done, 1);
+        if (bytesRead == 1 && !timedOut && finished < results.size()) {
+          /// The worker has flushed the output of the test before
+          /// reporting it, and is not running the next one yet
+          drainOutputs(outputPipes, current, maxOutputSize);
+          finished++;
+
+          bool stopped = stopOnFailure && entries[finished - 1].status != mull::Passed;
+          if (finished < results.size() && !stopped) {
+            deadline = steady_clock::now() + milliseconds(timeouts[finished]);
+            while (write(acknowledgeDescriptor, &done, 1) == -1 && errno == EINTR) {}
+          }
+        } else if (bytesRead == 0) {
+          close(pipes[0].fd);
+          pipes[0].fd = -1;
+        }
+      }
+    }
+
+    if (workerExited(workerPID)) {
+      kill(-workerPID, SIGKILL);
+      drainOutputs(outputPipes, results[std::min(finished, results.size() - 1)],
+                   maxOutputSize);
+      size_t drained = drainProgress(pipes[0].fd);
+      if (!timedOut) {
+        finished = std::min(finished + drained, results.size());
+      }
+      break;
+    }
+
+    if (!timedOut && steady_clock::now() >= deadline) {
+      timedOut = true;
+      kill(-workerPID, SIGKILL);
+    }
+  }
+
+  for (auto &pipe : pipes) {
+    if (pipe.fd != -1) {
+      close(pipe.fd);
+    }
+  }
+
+  return finished;
+}
+
+/// All the tests run in one worker, which saves a fork per test. The output
+/// goes through pipes as with a single test: the worker waits for the parent
+/// to collect the output of each test before it starts the next one. Once the
+/// worker crashes, times out, or exits in the middle of the batch, the tests
+/// it has not finished are run again in a worker each, so that the culprit
+/// gets a result of its own.
+std::vector<mull::ExecutionResult>
+mull::ForkProcessSandbox::runBatch(const std::vector<std::function<ExecutionStatus ()>> &functions,
+                                   const std::vector<long long> &timeouts,
+                                   bool stopOnFailure) {
+  if (functions.size() < 2) {
+    return ProcessSandbox::runBatch(functions, timeouts, stopOnFailure);
+  }
+
+  /// Each pipe is created separately, so that the ones
+  /// already created can be closed if the next one fails
+  int pipes[4][2];
+  int createdPipes = 0;
+  while (createdPipes < 4 && pipe(pipes[createdPipes]) == 0) {
+    createdPipes++;
+  }
+  if (createdPipes < 4) {
+    for (int i = 0; i < createdPipes; i++) {
+      close(pipes[i][0]);
+      close(pipes[i][1]);
+    }
+    return ProcessSandbox::runBatch(functions, timeouts, stopOnFailure);
+  }
+  int *stdoutPipe = pipes[0];
+  int *stderrPipe = pipes[1];
+  int *progressPipe = pipes[2];
+  int *acknowledgePipe = pipes[3];
+
+  const size_t entriesSize = sizeof(BatchEntry) * functions.size();
+  BatchEntry *entries = (BatchEntry *)mmap(nullptr,
+                                           entriesSize,
+                                           PROT_READ | PROT_WRITE,
+                                           MAP_SHARED | MAP_ANONYMOUS,
+                                           -1,
+                                           0);
+
+  const pid_t parentPID = getpid();
+  auto start = high_resolution_clock::now();
+  const pid_t workerPID = mullFork("batch worker");
+  auto forked = high_resolution_clock::now();
+  if (workerPID == 0) {
+    detachWorker(parentPID);
+
+    fflush(stderr);
+    fflush(stdout);
+    dup2(stderrPipe[1], STDERR_FILENO);
+    dup2(stdoutPipe[1], STDOUT_FILENO);
+    close(stderrPipe[0]);
+    close(stderrPipe[1]);
+    close(stdoutPipe[0]);
+    close(stdoutPipe[1]);
+    close(progressPipe[0]);
+    close(acknowledgePipe[1]);
+
+    for (size_t i = 0; i < functions.size(); i++) {
+      auto testStart = steady_clock::now();
+      auto cpuStart = cpuTimeMicroseconds(CLOCK_PROCESS_CPUTIME_ID);
+      ExecutionStatus status = functions[i]();
+      entries[i].cpuTime = cpuTimeMicroseconds(CLOCK_PROCESS_CPUTIME_ID) - cpuStart;
+      entries[i].testRunTime =
+        duration_cast<microseconds>(steady_clock::now() - testStart).count();
+
+      fflush(stderr);
+      fflush(stdout);
+      entries[i].status = status;
+
+      char done = 1;
+      if (write(progressPipe[1], &done, 1) != 1 ||
+          (stopOnFailure && status != Passed) ||
+          i + 1 == functions.size()) {
+        break;
+      }
+
+      ssize_t bytesRead = 0;
+      while ((bytesRead = read(acknowledgePipe[0], &done, 1)) == -1 && errno == EINTR) {}
+      if (bytesRead != 1) {
+        break;
+      }
+    }
+
+    _exit(MullExitCode);
+  }
+
+  /// Also set here, so that the group exists by the time it is killed
+  setpgid(workerPID, workerPID);
+  close(stderrPipe[1]);
+  close(stdoutPipe[1]);
+  close(progressPipe[1]);
+  close(acknowledgePipe[0]);
+  fcntl(stdoutPipe[0], F_SETFL, fcntl(stdoutPipe[0], F_GETFL) | O_NONBLOCK);
+  fcntl(stderrPipe[0], F_SETFL, fcntl(stderrPipe[0], F_GETFL) | O_NONBLOCK);
+
+  std::vector<ExecutionResult> results(functions.size());
+  bool timedOut = false;
+  size_t finished = watchBatch(workerPID, progressPipe[0], acknowledgePipe[1],
+                               stdoutPipe[0], stderrPipe[0], timeouts,
+                               entries, stopOnFailure, maxOutputSize,
+                               results, timedOut);
+  close(acknowledgePipe[1]);
+
+  int status = 0;
+  while (waitpid(workerPID, &status, 0) == -1 && errno == EINTR) {}
+
+  bool failed = false;
+  for (size_t i = 0; i < finished; i++) {
+    ExecutionResult &result = results[i];
+    BatchEntry &entry = entries[i];
+
+    result.status = entry.status;
+    result.exitStatus = MullExitCode;
+    result.testRunTime = entry.testRunTime;
+    result.cpuTime = entry.cpuTime;
+    result.runningTime = entry.testRunTime / 1000;
+    failed = failed || result.status != Passed;
+  }
+
+  /// The test that ran out of time already had its own deadline,
+  /// running it again would only take as long
+  if (timedOut && finished < functions.size()) {
+    ExecutionResult &result = results[finished];
+    result.status = Timedout;
+    result.runningTime = timeouts[finished];
+    finished++;
+    failed = true;
+  }
+
+  /// The cost of the fork goes to the first test, the tests after it
+  /// did not need one
+  results.front().forkTime = duration_cast<microseconds>(forked - start).count();
+
+  munmap(entries, entriesSize);
+
+  for (size_t i = finished; i < functions.size(); i++) {
+    if (stopOnFailure && failed) {
+      results[i] = ExecutionResult();
+      results[i].status = FailFast;
+      continue;
+    }
+
+    long long forkTime = results[i].forkTime;
+    results[i] = run(functions[i], timeouts[i]);
+    results[i].forkTime += forkTime;
+    failed = results[i].status != Passed;
+  }
+
+  return results;
+}
+
 mull::ExecutionResult mull::NullProcessSandbox::run(std::function<ExecutionStatus (void)> function,
-                                                    long long timeoutMilliseconds) {
+                                                    long long timeoutMilliseconds,
+                                                    const std::atomic<bool> *cancelled) {
   ExecutionResult result;
+  if (cancelled && cancelled->load()) {
+    result.status = FailFast;
+    return result;
+  }
+
+  auto start = steady_clock::now();
+  auto cpuStart = cpuTimeMicroseconds(CLOCK_THREAD_CPUTIME_ID);
   result.status = function();
+  result.cpuTime = cpuTimeMicroseconds(CLOCK_THREAD_CPUTIME_ID) - cpuStart;
+  result.testRunTime = duration_cast<microseconds>(steady_clock::now() - start).count();
   return result;
 }
@@ -0,0 +1,423 @@
+#include "ForkServer.h"
+
+#include "Logger.h"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <string>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+using namespace mull;
+using namespace std::chrono;
+
+namespace {
+
+typedef steady_clock::time_point Deadline;
+
+enum class RequestKind : uint32_t {
+  Load = 1,
+  Run = 2,
+  Stop = 3
+};
+
+struct RequestHeader {
+  RequestKind kind;
+  uint64_t key;
+  int64_t timeout;
+  uint64_t payloadSize;
+};
+
+struct ResponseHeader {
+  int32_t status;
+  int32_t exitStatus;
+  int64_t runningTime;
+  int64_t cpuTime;
+  int64_t forkTime;
+  int64_t testRunTime;
+  int64_t outputCaptureTime;
+  uint64_t stdoutSize;
+  uint64_t stderrSize;
+};
+
+}
+
+static bool writeAll(int descriptor, const void *data, size_t size) {
+  const char *bytes = static_cast<const char *>(data);
+  while (size != 0) {
+    ssize_t written = write(descriptor, bytes, size);
+    if (written == -1) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    bytes += written;
+    size -= written;
+  }
+  return true;
+}
+
+static bool readAll(int descriptor, void *data, size_t size) {
+  char *bytes = static_cast<char *>(data);
+  while (size != 0) {
+    ssize_t bytesRead = read(descriptor, bytes, size);
+    if (bytesRead == -1) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    if (bytesRead == 0) {
+      return false;
+    }
+    bytes += bytesRead;
+    size -= bytesRead;
+  }
+  return true;
+}
+
+static bool readString(int descriptor, std::string &string, size_t size) {
+  string.resize(size);
+  if (size == 0) {
+    return true;
+  }
+  return readAll(descriptor, &string[0], size);
+}
+
+/// Waits until the descriptor is ready for the events,
+/// returns false if the deadline passes first
+static bool waitUntil(int descriptor, short events, Deadline deadline) {
+  struct pollfd ready;
+  ready.fd = descriptor;
+  ready.events = events;
+  for (;;) {
+    long long remaining = duration_cast<milliseconds>(deadline - steady_clock::now()).count();
+    if (remaining <= 0) {
+      return false;
+    }
+    ready.revents = 0;
+    int count = poll(&ready, 1, static_cast<int>(std::min(remaining, 1000LL)));
+    if (count > 0 || (count == -1 && errno != EINTR)) {
+      /// Errors and hangups are reported by the following read or write
+      return true;
+    }
+  }
+}
+
+/// The worker's ends of the pipes are non-blocking: a server stuck in
+/// a handler neither reads the payload nor writes the response, and
+/// the worker must not wait for it longer than the deadline.
+static bool writeAll(int descriptor, const void *data, size_t size,
+                     Deadline deadline, bool &timedOut) {
+  const char *bytes = static_cast<const char *>(data);
+  while (size != 0) {
+    ssize_t written = write(descriptor, bytes, size);
+    if (written == -1) {
+      if (errno == EINTR) {
+        continue;
+      }
+      if (errno == EAGAIN || errno == EWOULDBLOCK) {
+        if (!waitUntil(descriptor, POLLOUT, deadline)) {
+          timedOut = true;
+          return false;
+        }
+        continue;
+      }
+      return false;
+    }
+    bytes += written;
+    size -= written;
+  }
+  return true;
+}
+
+static bool readAll(int descriptor, void *data, size_t size,
+                    Deadline deadline, bool &timedOut) {
+  char *bytes = static_cast<char *>(data);
+  while (size != 0) {
+    ssize_t bytesRead = read(descriptor, bytes, size);
+    if (bytesRead == -1) {
+      if (errno == EINTR) {
+        continue;
+      }
+      if (errno == EAGAIN || errno == EWOULDBLOCK) {
+        if (!waitUntil(descriptor, POLLIN, deadline)) {
+          timedOut = true;
+          return false;
+        }
+        continue;
+      }
+      return false;
+    }
+    if (bytesRead == 0) {
+      return false;
+    }
+    bytes += bytesRead;
+    size -= bytesRead;
+  }
+  return true;
+}
+
+static bool readString(int descriptor, std::string &string, size_t size,
+                       Deadline deadline, bool &timedOut) {
+  string.resize(size);
+  if (size == 0) {
+    return true;
+  }
+  return readAll(descriptor, &string[0], size, deadline, timedOut);
+}
+
+/// The sandboxes of the tests are forked from the server, and each fork
+/// copies the page tables of the whole address space. The heap the driver
+/// has freed after the earlier phases is still mapped, so it is given back
+/// to the system once, before the first test.
+static void releaseFreedMemory() {
+#ifdef __GLIBC__
+  malloc_trim(0);
+#endif
+}
+
+/// The server polls its input with a timeout so that it can notice
+/// that the worker process has gone away without sending the Stop request.
+static bool waitForRequest(int descriptor, pid_t parentPID) {
+  struct pollfd request;
+  request.fd = descriptor;
+  request.events = POLLIN;
+  for (;;) {
+    request.revents = 0;
+    int ready = poll(&request, 1, 1000);
+    if (ready == -1 && errno != EINTR) {
+      return false;
+    }
+    if (ready > 0) {
+      return true;
+    }
+    if (getppid() != parentPID) {
+      return false;
+    }
+  }
+}
+
+const long long ForkServer::DefaultLoadTimeout;
+const long long ForkServer::DefaultRunTimeoutMargin;
+
+ForkServer::ForkServer(LoadHandler loadHandler, RunHandler runHandler,
+                       long long loadTimeout, long long runTimeoutMargin)
+  : loadHandler(loadHandler),
+    runHandler(runHandler),
+    loadTimeout(loadTimeout),
+    runTimeoutMargin(runTimeoutMargin),
+    serverPID(0),
+    requestDescriptor(-1),
+    responseDescriptor(-1) {}
+
+ForkServer::~ForkServer() {
+  stop();
+}
+
+bool ForkServer::isRunning() const {
+  return serverPID != 0;
+}
+
+bool ForkServer::start() {
+  assert(!isRunning());
+
+  int requestPipe[2];
+  int responsePipe[2];
+  if (pipe(requestPipe) == -1) {
+    Logger::error() << "ForkServer> Cannot create pipe: " << strerror(errno) << "\n";
+    return false;
+  }
+  if (pipe(responsePipe) == -1) {
+    Logger::error() << "ForkServer> Cannot create pipe: " << strerror(errno) << "\n";
+    close(requestPipe[0]);
+    close(requestPipe[1]);
+    return false;
+  }
+
+  const pid_t parentPID = getpid();
+  const pid_t pid = fork();
+  if (pid == -1) {
+    Logger::error() << "ForkServer> Cannot fork: " << strerror(errno) << "\n";
+    close(requestPipe[0]);
+    close(requestPipe[1]);
+    close(responsePipe[0]);
+    close(responsePipe[1]);
+    return false;
+  }
+
+  if (pid == 0) {
+    close(requestPipe[1]);
+    close(responsePipe[0]);
+    releaseFreedMemory();
+    serve(requestPipe[0], responsePipe[1], parentPID);
+    _exit(0);
+  }
+
+  close(requestPipe[0]);
+  close(responsePipe[1]);
+  serverPID = pid;
+  requestDescriptor = requestPipe[1];
+  responseDescriptor = responsePipe[0];
+  fcntl(requestDescriptor, F_SETFL, fcntl(requestDescriptor, F_GETFL) | O_NONBLOCK);
+  fcntl(responseDescriptor, F_SETFL, fcntl(responseDescriptor, F_GETFL) | O_NONBLOCK);
+  return true;
+}
+
+void ForkServer::serve(int input, int output, pid_t parentPID) {
+  while (waitForRequest(input, parentPID)) {
+    RequestHeader request;
+    std::string payload;
+    if (!readAll(input, &request, sizeof(request)) ||
+        !readString(input, payload, request.payloadSize)) {
+      return;
+    }
+
+    ResponseHeader response;
+    memset(&response, 0, sizeof(response));
+    ExecutionResult result;
+
+    switch (request.kind) {
+      case RequestKind::Load: {
+        response.status = loadHandler(request.key, payload) ? 1 : 0;
+      } break;
+
+      case RequestKind::Run: {
+        result = runHandler(request.key, request.timeout);
+        response.status = result.status;
+        response.exitStatus = result.exitStatus;
+        response.runningTime = result.runningTime;
+        response.cpuTime = result.cpuTime;
+        response.forkTime = result.forkTime;
+        response.testRunTime = result.testRunTime;
+        response.outputCaptureTime = result.outputCaptureTime;
+        response.stdoutSize = result.stdoutOutput.size();
+        response.stderrSize = result.stderrOutput.size();
+      } break;
+
+      case RequestKind::Stop:
+        return;
+    }
+
+    if (!writeAll(output, &response, sizeof(response)) ||
+        !writeAll(output, result.stdoutOutput.data(), response.stdoutSize) ||
+        !writeAll(output, result.stderrOutput.data(), response.stderrSize)) {
+      return;
+    }
+  }
+}
+
+bool ForkServer::load(uint64_t key, llvm::StringRef payload) {
+  if (!isRunning()) {
+    return false;
+  }
+
+  RequestHeader request;
+  memset(&request, 0, sizeof(request));
+  request.kind = RequestKind::Load;
+  request.key = key;
+  request.payloadSize = payload.size();
+
+  Deadline deadline = steady_clock::now() + milliseconds(loadTimeout);
+  bool timedOut = false;
+  ResponseHeader response;
+  if (!writeAll(requestDescriptor, &request, sizeof(request), deadline, timedOut) ||
+      !writeAll(requestDescriptor, payload.data(), payload.size(), deadline, timedOut) ||
+      !readAll(responseDescriptor, &response, sizeof(response), deadline, timedOut)) {
+    if (timedOut) {
+      Logger::error() << "ForkServer> The server did not load the program in "
+                      << loadTimeout << "ms, killing it\n";
+    } else {
+      Logger::error() << "ForkServer> Lost connection to the server\n";
+    }
+    shutdown();
+    return false;
+  }
+
+  if (response.status == 0) {
+    shutdown();
+    return false;
+  }
+
+  return true;
+}
+
+bool ForkServer::run(uint64_t key, long long timeoutMilliseconds,
+                     ExecutionResult &result) {
+  if (!isRunning()) {
+    return false;
+  }
+
+  RequestHeader request;
+  memset(&request, 0, sizeof(request));
+  request.kind = RequestKind::Run;
+  request.key = key;
+  request.timeout = timeoutMilliseconds;
+
+  /// The sandbox of the server enforces the timeout itself,
+  /// the margin covers forking the test and sending its output back
+  Deadline deadline = steady_clock::now() +
+                      milliseconds(timeoutMilliseconds + runTimeoutMargin);
+  bool timedOut = false;
+  ResponseHeader response;
+  if (!writeAll(requestDescriptor, &request, sizeof(request), deadline, timedOut) ||
+      !readAll(responseDescriptor, &response, sizeof(response), deadline, timedOut) ||
+      !readString(responseDescriptor, result.stdoutOutput, response.stdoutSize, deadline, timedOut) ||
+      !readString(responseDescriptor, result.stderrOutput, response.stderrSize, deadline, timedOut)) {
+    if (timedOut) {
+      Logger::error() << "ForkServer> The server did not respond in time, killing it\n";
+    } else {
+      Logger::error() << "ForkServer> Lost connection to the server\n";
+    }
+    shutdown();
+    return false;
+  }
+
+  result.status = static_cast<ExecutionStatus>(response.status);
+  result.exitStatus = response.exitStatus;
+  result.runningTime = response.runningTime;
+  result.cpuTime = response.cpuTime;
+  result.forkTime = response.forkTime;
+  result.testRunTime = response.testRunTime;
+  result.outputCaptureTime = response.outputCaptureTime;
+  return true;
+}
+
+void ForkServer::stop() {
+  if (!isRunning()) {
+    return;
+  }
+
+  RequestHeader request;
+  memset(&request, 0, sizeof(request));
+  request.kind = RequestKind::Stop;
+  writeAll(requestDescriptor, &request, sizeof(request));
+
+  shutdown();
+}
+
+void ForkServer::shutdown() {
+  close(requestDescriptor);
+  close(responseDescriptor);
+  requestDescriptor = -1;
+  responseDescriptor = -1;
+
+  /// Closed pipe makes the server leave the loop, but if it is stuck
+  /// in a handler there is no point in waiting for it
+  kill(serverPID, SIGKILL);
+  int status = 0;
+  while (waitpid(serverPID, &status, 0) == -1 && errno == EINTR) {}
+  serverPID = 0;
+}
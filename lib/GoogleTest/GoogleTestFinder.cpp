@@ -3,6 +3,7 @@
 #include "Context.h"
 #include "Filter.h"
 #include "Logger.h"
+#include "LLVMCompatibility.h"
 
 #include <llvm/IR/CallSite.h>
 #include <llvm/IR/Constants.h>
@@ -96,6 +97,13 @@ std::vector<std::unique_ptr<Test>> GoogleTestFinder::findTests(Context &context,
         continue;
       }
 
+      /// Tests are registered from static constructors, bodies of which
+      /// are not parsed yet if the module was loaded lazily
+      if (!llvm_compat::materializeAll(*currentModule->getModule())) {
+        Logger::error() << "GoogleTestFinder> Can't materialize module "
+                        << currentModule->getModule()->getModuleIdentifier() << '\n';
+      }
+
       /// Normally the globalValue has only one usage, ut LLVM could add
       /// intrinsics such as @llvm.invariant.start
       /// We need to find a user that is a store instruction, which is
@@ -0,0 +1,261 @@
+#include "Instrumentation/CallTreeCache.h"
+
+#include "Config.h"
+#include "Context.h"
+#include "Logger.h"
+#include "MullModule.h"
+#include "RecordFormat.h"
+#include "Test.h"
+#include "Testee.h"
+#include "Toolchain/ObjectCache.h"
+
+#include <llvm/ADT/DenseMap.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Support/MD5.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <algorithm>
+#include <map>
+#include <sys/stat.h>
+
+using namespace mull;
+using namespace llvm;
+
+namespace {
+
+/// Functions are referenced by the module and the position in it,
+/// which are the same as long as the module hash is the same
+class FunctionTable {
+public:
+  explicit FunctionTable(Context &context) {
+    for (auto &module : context.getModules()) {
+      int moduleIndex = int(modules.size());
+      modules.push_back(module->getUniqueIdentifier());
+      moduleIndices[module->getUniqueIdentifier()] = moduleIndex;
+      functions.emplace_back();
+
+      for (auto &function : *module->getModule()) {
+        positions[&function] = std::make_pair(moduleIndex, int(functions.back().size()));
+        functions.back().push_back(&function);
+      }
+    }
+  }
+
+  void write(RecordWriter &writer, Function *function) {
+    auto position = positions.lookup(function);
+    writer.string(modules[position.first]);
+    writer.number(position.second);
+  }
+
+  Function *read(RecordReader &reader) {
+    std::string module;
+    long long index = 0;
+    if (!reader.string(module) || !reader.number(index)) {
+      return nullptr;
+    }
+    auto moduleIndex = moduleIndices.find(module);
+    if (moduleIndex == moduleIndices.end()) {
+      return nullptr;
+    }
+    auto &moduleFunctions = functions[moduleIndex->second];
+    if (index < 0 || index >= (long long)moduleFunctions.size()) {
+      return nullptr;
+    }
+    return moduleFunctions[index];
+  }
+
+private:
+  std::vector<std::string> modules;
+  std::map<std::string, int> moduleIndices;
+  std::vector<std::vector<Function *>> functions;
+  DenseMap<Function *, std::pair<int, int>> positions;
+};
+
+}
+
+/// Precompiled code is not hashed, a change in size or modification time
+/// is taken as a change in the code
+static std::string fileStamp(const std::string &path) {
+  struct stat status;
+  if (stat(path.c_str(), &status) != 0) {
+    return path + " missing";
+  }
+  return path + " " + std::to_string(status.st_size) + " " +
+         std::to_string(status.st_mtime);
+}
+
+static std::string programKey(Context &context, const Config &config) {
+  std::vector<std::string> modules;
+  for (auto &module : context.getModules()) {
+    modules.push_back(module->getUniqueIdentifier());
+  }
+  /// Modules are loaded in parallel, their order may differ between runs
+  std::sort(modules.begin(), modules.end());
+
+  std::string key;
+  raw_string_ostream stream(key);
+  RecordWriter writer(stream);
+
+  writer.number(CallTreeCache::FormatVersion);
+  for (auto &module : modules) {
+    writer.string(module);
+  }
+  for (auto &path : config.getObjectFilesPaths()) {
+    writer.string(fileStamp(path));
+  }
+  for (auto &path : config.getDynamicLibrariesPaths()) {
+    writer.string(fileStamp(path));
+  }
+
+  writer.string(config.getTestFramework());
+  for (auto &test : config.getTests()) {
+    writer.string(test);
+  }
+  for (auto &location : config.getExcludeLocations()) {
+    writer.string(location);
+  }
+  for (auto &definition : config.getCustomTests()) {
+    writer.string(definition.testName);
+    writer.string(definition.methodName);
+    writer.string(definition.programName);
+    for (auto &argument : definition.callArguments) {
+      writer.string(argument);
+    }
+  }
+  writer.number(config.getMaxDistance());
+  writer.number(config.getTimeout());
+  writer.number(config.historyEnabled());
+
+  MD5 hasher;
+  hasher.update(stream.str());
+  MD5::MD5Result hash;
+  hasher.final(hash);
+  SmallString<32> result;
+  MD5::stringifyResult(hash, result);
+  return "calltree_" + result.str().str();
+}
+
+CallTreeCache::CallTreeCache(ObjectCache &cache, Context &context, const Config &config)
+  : cache(cache), context(context), identifier(programKey(context, config)) {}
+
+void CallTreeCache::store(std::vector<std::unique_ptr<Test>> &tests,
+                          const std::vector<std::unique_ptr<Testee>> &testees) {
+  std::map<Test *, std::vector<Testee *>> testeesByTest;
+  for (auto &testee : testees) {
+    testeesByTest[testee->getTest()].push_back(testee.get());
+  }
+
+  FunctionTable functions(context);
+  std::string data;
+  raw_string_ostream stream(data);
+  RecordWriter writer(stream);
+
+  writer.number(tests.size());
+  for (auto &test : tests) {
+    ExecutionResult &result = test->getExecutionResult();
+    writer.string(test->getUniqueIdentifier());
+    writer.number(result.status);
+    writer.number(result.exitStatus);
+    writer.number(result.runningTime);
+    writer.number(result.cpuTime);
+    writer.string(result.stdoutOutput);
+    writer.string(result.stderrOutput);
+
+    writer.number(test->getExecutedFunctions().size());
+    for (auto function : test->getExecutedFunctions()) {
+      functions.write(writer, function);
+    }
+
+    auto &testTestees = testeesByTest[test.get()];
+    writer.number(testTestees.size());
+    for (auto testee : testTestees) {
+      functions.write(writer, testee->getTesteeFunction());
+      writer.number(testee->getDistance());
+    }
+  }
+
+  cache.putData(stream.str(), identifier);
+}
+
+bool CallTreeCache::load(std::vector<std::unique_ptr<Test>> &tests,
+                         std::vector<std::unique_ptr<Testee>> &testees) {
+  std::string data;
+  if (!cache.getData(identifier, data)) {
+    return false;
+  }
+
+  std::map<std::string, Test *> testsByIdentifier;
+  for (auto &test : tests) {
+    testsByIdentifier[test->getUniqueIdentifier()] = test.get();
+  }
+
+  struct StoredTest {
+    ExecutionResult result;
+    std::vector<Function *> executedFunctions;
+    std::vector<std::pair<Function *, int>> testees;
+  };
+  std::map<Test *, StoredTest> stored;
+
+  FunctionTable functions(context);
+  RecordReader reader(data);
+
+  long long testsCount = 0;
+  bool valid = reader.number(testsCount) && testsCount == (long long)tests.size();
+
+  for (long long i = 0; valid && i < testsCount; i++) {
+    std::string testIdentifier;
+    long long status = 0, exitStatus = 0, runningTime = 0, cpuTime = 0;
+    StoredTest test;
+    valid = reader.string(testIdentifier) &&
+            reader.number(status) &&
+            reader.number(exitStatus) &&
+            reader.number(runningTime) &&
+            reader.number(cpuTime) &&
+            reader.string(test.result.stdoutOutput) &&
+            reader.string(test.result.stderrOutput);
+
+    auto found = testsByIdentifier.find(testIdentifier);
+    valid = valid && found != testsByIdentifier.end() && stored.count(found->second) == 0;
+
+    long long executedCount = 0;
+    valid = valid && reader.number(executedCount);
+    for (long long j = 0; valid && j < executedCount; j++) {
+      Function *function = functions.read(reader);
+      valid = function != nullptr;
+      test.executedFunctions.push_back(function);
+    }
+
+    long long testeesCount = 0;
+    valid = valid && reader.number(testeesCount);
+    for (long long j = 0; valid && j < testeesCount; j++) {
+      Function *function = functions.read(reader);
+      long long distance = 0;
+      valid = function != nullptr && reader.number(distance);
+      test.testees.push_back(std::make_pair(function, int(distance)));
+    }
+
+    if (valid) {
+      test.result.status = ExecutionStatus(status);
+      test.result.exitStatus = int(exitStatus);
+      test.result.runningTime = runningTime;
+      test.result.cpuTime = cpuTime;
+      stored[found->second] = std::move(test);
+    }
+  }
+
+  if (!valid || !reader.atEnd()) {
+    Logger::debug() << "CallTreeCache> Ignoring the stored call trees\n";
+    return false;
+  }
+
+  for (auto &test : tests) {
+    StoredTest &storedTest = stored[test.get()];
+    test->setExecutionResult(storedTest.result);
+    test->setExecutedFunctions(storedTest.executedFunctions);
+    for (auto &testee : storedTest.testees) {
+      testees.push_back(make_unique<Testee>(testee.first, test.get(), testee.second));
+    }
+  }
+
+  return true;
+}
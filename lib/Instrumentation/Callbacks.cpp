@@ -4,6 +4,8 @@
 #include "Driver.h"
 
 #include <llvm/IR/Constants.h>
+#include <llvm/IR/DerivedTypes.h>
+#include <llvm/IR/IRBuilder.h>
 #include <llvm/IR/Instructions.h>
 #include <llvm/IR/GlobalVariable.h>
 
@@ -12,100 +14,125 @@ using namespace llvm;
 
 namespace mull {
 
-extern "C" void mull_enterFunction(void **trampoline, uint32_t functionIndex) {
-  InstrumentationInfo *info = (InstrumentationInfo *)*trampoline;
-  assert(info);
-  assert(info->callTreeMapping);
-  DynamicCallTree::enterFunction(functionIndex, info->callTreeMapping, info->callstack);
+extern "C" void mull_enterFunction(InstrumentationInfo *info, uint32_t functionIndex) {
+  DynamicCallTree::recordFunction(functionIndex, *info);
 }
 
-extern "C" void mull_leaveFunction(void **trampoline, uint32_t functionIndex) {
-  InstrumentationInfo *info = (InstrumentationInfo *)*trampoline;
-  assert(info);
-  assert(info->callTreeMapping);
-  DynamicCallTree::leaveFunction(functionIndex, info->callTreeMapping, info->callstack);
 }
 
+StructType *Callbacks::instrumentationInfoType(LLVMContext &context) {
+  auto intType = Type::getInt32Ty(context);
+  auto intPointerType = intType->getPointerTo();
+  return StructType::get(context, { intPointerType, intPointerType, intType });
 }
 
 Value *Callbacks::injectInstrumentationInfoPointer(Module *module,
                                                    const char *variableName) {
   auto &context = module->getContext();
-  auto trampolineType = Type::getVoidTy(context)->getPointerTo()->getPointerTo();
+  auto trampolineType = instrumentationInfoType(context)->getPointerTo();
   return module->getOrInsertGlobal(variableName, trampolineType);
 }
 
-Value *Callbacks::injectFunctionIndexOffset(Module *module,
-                                            const char *functionIndexOffsetPrefix) {
-  auto &context = module->getContext();
-  auto functionIndexOffsetType = Type::getInt32Ty(context);
-  std::string functionIndexOffset(functionIndexOffsetPrefix);
-  functionIndexOffset += module->getModuleIdentifier();
-
-  return module->getOrInsertGlobal(functionIndexOffset, functionIndexOffsetType);
-}
-
+/// Turns
+///
+///   define void @foo() {
+///   entry:
+///     ...
+///     ret void
+///   }
+///
+/// into
+///
+///   define void @foo() {
+///   mull_enter:
+///     %info = load { i32*, i32*, i32 }*, { i32*, i32*, i32 }** @mull_instrumentation_info
+///     %depth = load i32, i32* <info->callstackDepth>
+///     %parent = load i32, i32* <info->callTreeMapping[index]>
+///     br i1 <depth != 0 && parent != 0>, label %mull_push, label %mull_record
+///   mull_record:
+///     call void @mull_enterFunction(%info, i32 <index>)
+///     br label %mull_push
+///   mull_push:
+///     store i32 <index>, i32* <info->callstack[depth & mask]>
+///     store i32 <depth + 1>, i32* <info->callstackDepth>
+///     br label %entry
+///   entry:
+///     ...
+///     store i32 %depth, i32* <info->callstackDepth>
+///     ret void
+///   }
+///
+/// The index already includes the offset of the module.
 void Callbacks::injectCallbacks(llvm::Function *function,
                                 uint32_t index,
-                                Value *infoPointer,
-                                Value *offset) {
-  auto &context = function->getParent()->getContext();
+                                Value *infoPointer) {
+  Module *module = function->getParent();
+  auto &context = module->getContext();
   auto intType = Type::getInt32Ty(context);
-  auto trampolineType = Type::getVoidTy(context)->getPointerTo()->getPointerTo();
   auto voidType = Type::getVoidTy(context);
-  std::vector<Type *> parameterTypes({trampolineType, intType});
+  auto infoType = instrumentationInfoType(context);
+  std::vector<Type *> parameterTypes({infoType->getPointerTo(), intType});
 
   FunctionType *callbackType = FunctionType::get(voidType, parameterTypes, false);
 
-  Function *enterFunction = function->getParent()->getFunction("mull_enterFunction");
-  Function *leaveFunction = function->getParent()->getFunction("mull_leaveFunction");
-
-  if (enterFunction == nullptr && leaveFunction == nullptr) {
+  Function *enterFunction = module->getFunction("mull_enterFunction");
+  if (enterFunction == nullptr) {
     enterFunction = Function::Create(callbackType,
                                      Function::ExternalLinkage,
                                      "mull_enterFunction",
-                                     function->getParent());
-
-    leaveFunction = Function::Create(callbackType,
-                                     Function::ExternalLinkage,
-                                     "mull_leaveFunction",
-                                     function->getParent());
+                                     module);
   }
 
-  assert(enterFunction);
-  assert(leaveFunction);
-
-  Value *functionIndex = ConstantInt::get(intType, index);
-
-  auto &entryBlock = *function->getBasicBlockList().begin();
-  auto firstInstruction = &*entryBlock.getInstList().begin();
+  BasicBlock *originalEntry = &function->getEntryBlock();
+  BasicBlock *enter = BasicBlock::Create(context, "mull_enter", function, originalEntry);
+  BasicBlock *record = BasicBlock::Create(context, "mull_record", function, originalEntry);
+  BasicBlock *push = BasicBlock::Create(context, "mull_push", function, originalEntry);
 
-  Value *offsetValue = new LoadInst(offset, "offset", firstInstruction);
-  Value *indexAndOffset = BinaryOperator::Create(Instruction::Add,
-                                                 functionIndex,
-                                                 offsetValue,
-                                                 "functionIndex",
-                                                 firstInstruction);
-  std::vector<Value *> enterParameters({infoPointer, indexAndOffset});
-
-  CallInst *enterFunctionCall = CallInst::Create(enterFunction, enterParameters);
-  enterFunctionCall->insertBefore(firstInstruction);
+  /// Static allocas must stay in the entry block
+  while (auto alloca = dyn_cast<AllocaInst>(&originalEntry->front())) {
+    alloca->removeFromParent();
+    enter->getInstList().push_back(alloca);
+  }
 
+  Value *functionIndex = ConstantInt::get(intType, index);
+  Value *zero = ConstantInt::get(intType, 0);
+
+  IRBuilder<> builder(enter);
+  Value *info = builder.CreateLoad(infoPointer, "info");
+  Value *depthAddress = builder.CreateStructGEP(infoType, info, 2, "depthAddress");
+  Value *depth = builder.CreateLoad(depthAddress, "depth");
+  Value *mappingAddress = builder.CreateStructGEP(infoType, info, 0, "mappingAddress");
+  Value *mapping = builder.CreateLoad(mappingAddress, "mapping");
+  Value *parentAddress = builder.CreateInBoundsGEP(mapping, functionIndex, "parentAddress");
+  Value *parent = builder.CreateLoad(parentAddress, "parent");
+  Value *nested = builder.CreateICmpNE(depth, zero, "nested");
+  Value *seen = builder.CreateICmpNE(parent, zero, "seen");
+  builder.CreateCondBr(builder.CreateAnd(nested, seen), push, record);
+
+  builder.SetInsertPoint(record);
+  std::vector<Value *> enterParameters({info, functionIndex});
+  builder.CreateCall(enterFunction, enterParameters);
+  builder.CreateBr(push);
+
+  builder.SetInsertPoint(push);
+  Value *callstackAddress = builder.CreateStructGEP(infoType, info, 1, "callstackAddress");
+  Value *callstack = builder.CreateLoad(callstackAddress, "callstack");
+  Value *mask = ConstantInt::get(intType, InstrumentationInfo::MaxCallstackDepth - 1);
+  Value *position = builder.CreateAnd(depth, mask, "position");
+  Value *top = builder.CreateInBoundsGEP(callstack, position, "top");
+  builder.CreateStore(functionIndex, top);
+  builder.CreateStore(builder.CreateAdd(depth, ConstantInt::get(intType, 1)),
+                      depthAddress);
+  builder.CreateBr(originalEntry);
+
+  /// Leaving a function restores the depth it was entered at,
+  /// which also makes up for the callees left by unwinding
   for (auto &block : function->getBasicBlockList()) {
     ReturnInst *returnStatement = nullptr;
     if (!(returnStatement = dyn_cast<ReturnInst>(block.getTerminator()))) {
       continue;
     }
 
-    Value *offsetValue = new LoadInst(offset, "offset", returnStatement);
-    Value *indexAndOffset = BinaryOperator::Create(Instruction::Add,
-                                                   functionIndex,
-                                                   offsetValue,
-                                                   "functionIndex",
-                                                   returnStatement);
-    std::vector<Value *> leaveParameters({infoPointer, indexAndOffset});
-
-    CallInst *leaveFunctionCall = CallInst::Create(leaveFunction, leaveParameters);
-    leaveFunctionCall->insertBefore(returnStatement);
+    new StoreInst(depth, depthAddress, returnStatement);
   }
 }
@@ -3,32 +3,43 @@
 #include "Testee.h"
 
 #include <queue>
-#include <stack>
 
 using namespace mull;
 using namespace llvm;
 
-void DynamicCallTree::enterFunction(const uint32_t functionIndex,
-                                    uint32_t *mapping,
-                                    std::stack<uint32_t> &stack) {
+static const uint32_t CallstackMask = InstrumentationInfo::MaxCallstackDepth - 1;
+static_assert((InstrumentationInfo::MaxCallstackDepth & CallstackMask) == 0,
+              "Call stack depth must be a power of two");
+
+void DynamicCallTree::recordFunction(const uint32_t functionIndex,
+                                     InstrumentationInfo &info) {
+  uint32_t *mapping = info.callTreeMapping;
 
-  if (stack.empty()) {
+  if (info.callstackDepth == 0) {
     /// This is the first function in a chain
     /// The root of a tree
     mapping[functionIndex] = functionIndex;
   } else if (mapping[functionIndex] == 0) {
     /// This function has never been called
-    uint32_t parent = stack.top();
+    uint32_t parent = info.callstack[(info.callstackDepth - 1) & CallstackMask];
     mapping[functionIndex] = parent;
   }
+}
+
+void DynamicCallTree::enterFunction(const uint32_t functionIndex,
+                                    InstrumentationInfo &info) {
+  if (info.callstackDepth == 0 || info.callTreeMapping[functionIndex] == 0) {
+    recordFunction(functionIndex, info);
+  }
 
-  stack.push(functionIndex);
+  info.callstack[info.callstackDepth & CallstackMask] = functionIndex;
+  info.callstackDepth++;
 }
 
 void DynamicCallTree::leaveFunction(const uint32_t functionIndex,
-                                    uint32_t *mapping,
-                                    std::stack<uint32_t> &stack) {
-  stack.pop();
+                                    InstrumentationInfo &info) {
+  assert(info.callstackDepth > 0);
+  info.callstackDepth--;
 }
 
 void fillInCallTree(std::vector<CallTreeFunction> &functions,
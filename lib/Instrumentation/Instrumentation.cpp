@@ -25,10 +25,6 @@ const char *Instrumentation::instrumentationInfoVariableName() {
   return "mull_instrumentation_info";
 }
 
-const char *Instrumentation::functionIndexOffsetPrefix() {
-  return "mull_function_index_offset_";
-}
-
 void Instrumentation::recordFunctions(llvm::Module *originalModule) {
   uint32_t offset = functions.size();
   functionOffsetMapping[originalModule->getModuleIdentifier()] = offset;
@@ -45,15 +41,17 @@ void Instrumentation::recordFunctions(llvm::Module *originalModule) {
 void Instrumentation::insertCallbacks(llvm::Module *instrumentedModule) {
   auto info = callbacks.injectInstrumentationInfoPointer(instrumentedModule,
                                                          instrumentationInfoVariableName());
-  auto offset = callbacks.injectFunctionIndexOffset(instrumentedModule,
-                                                    functionIndexOffsetPrefix());
 
-  uint32_t index = 0;
+  /// Modules are compiled in parallel, the mapping is only read here
+  auto offset = functionOffsetMapping.find(instrumentedModule->getModuleIdentifier());
+  assert(offset != functionOffsetMapping.end() && "Functions must be recorded first");
+
+  uint32_t index = offset->second;
   for (auto &function: instrumentedModule->getFunctionList()) {
     if (function.isDeclaration()) {
       continue;
     }
-    callbacks.injectCallbacks(&function, index, info, offset);
+    callbacks.injectCallbacks(&function, index, info);
     index++;
   }
 }
@@ -69,6 +67,20 @@ Instrumentation::getTestees(Test *test, Filter &filter, int distance) {
   return testees;
 }
 
+/// Must be called before getTestees, which consumes the mapping
+std::vector<llvm::Function *> Instrumentation::getExecutedFunctions(Test *test) {
+  auto &mapping = test->getInstrumentationInfo().callTreeMapping;
+
+  std::vector<llvm::Function *> executedFunctions;
+  for (uint32_t index = 1; index < functions.size(); index++) {
+    if (mapping[index] != 0) {
+      executedFunctions.push_back(functions[index].function);
+    }
+  }
+
+  return executedFunctions;
+}
+
 void Instrumentation::setupInstrumentationInfo(Test *test) {
   auto &mapping = test->getInstrumentationInfo().callTreeMapping;
 
@@ -83,10 +95,19 @@ void Instrumentation::setupInstrumentationInfo(Test *test) {
                         -1, 0);
   mapping = static_cast<uint32_t *>(rawMemory);
   memset(mapping, 0, mappingSize);
+
+  auto &info = test->getInstrumentationInfo();
+  info.callstack = new uint32_t[InstrumentationInfo::MaxCallstackDepth];
+  info.callstackDepth = 0;
 }
 
 void Instrumentation::cleanupInstrumentationInfo(Test *test) {
-  std::stack<uint32_t>().swap(test->getInstrumentationInfo().callstack);
-  munmap(test->getInstrumentationInfo().callTreeMapping, functions.size());
+  auto &info = test->getInstrumentationInfo();
+  delete[] info.callstack;
+  info.callstack = nullptr;
+  info.callstackDepth = 0;
+
+  munmap(info.callTreeMapping, sizeof(info.callTreeMapping[0]) * functions.size());
+  info.callTreeMapping = nullptr;
 }
 
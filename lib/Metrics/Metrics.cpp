@@ -1,4 +1,5 @@
 #include "Metrics/Metrics.h"
+#include <algorithm>
 #include <iostream>
 #include <numeric>
 
@@ -47,6 +48,90 @@ const char *MetricsMeasure::precision() {
   return "ms";
 }
 
+DurationHistogram::DurationHistogram()
+  : count(0), total(0), max(0), buckets() {}
+
+void DurationHistogram::add(uint64_t microseconds) {
+  int bucket = 0;
+  while (bucket < BucketsCount - 1 && (microseconds >> (bucket + 1)) != 0) {
+    bucket++;
+  }
+  buckets[bucket]++;
+  count++;
+  total += microseconds;
+  max = std::max(max, microseconds);
+}
+
+void DurationHistogram::merge(const DurationHistogram &other) {
+  for (int i = 0; i < BucketsCount; i++) {
+    buckets[i] += other.buckets[i];
+  }
+  count += other.count;
+  total += other.total;
+  max = std::max(max, other.max);
+}
+
+uint64_t DurationHistogram::percentile(double fraction) const {
+  uint64_t threshold = uint64_t(fraction * count);
+  uint64_t seen = 0;
+  for (int i = 0; i < BucketsCount; i++) {
+    seen += buckets[i];
+    if (seen > threshold) {
+      return std::min(max, (uint64_t(2) << i) - 1);
+    }
+  }
+  return max;
+}
+
+MutantCosts::MutantCosts() : cacheHits(0), cacheMisses(0) {}
+
+void MutantCosts::add(MutantPhase phase, uint64_t microseconds) {
+  phases[int(phase)].add(microseconds);
+}
+
+void MutantCosts::merge(const MutantCosts &other) {
+  for (int i = 0; i < MutantPhasesCount; i++) {
+    phases[i].merge(other.phases[i]);
+  }
+  cacheHits += other.cacheHits;
+  cacheMisses += other.cacheMisses;
+}
+
+const char *MutantCosts::phaseName(MutantPhase phase) {
+  switch (phase) {
+    case MutantPhase::Clone:
+      return "clone";
+    case MutantPhase::Mutate:
+      return "mutate";
+    case MutantPhase::Codegen:
+      return "codegen";
+    case MutantPhase::Link:
+      return "link";
+    case MutantPhase::Fork:
+      return "fork";
+    case MutantPhase::TestRun:
+      return "test_run";
+    case MutantPhase::OutputCapture:
+      return "output_capture";
+  }
+}
+
+PhaseTimer::PhaseTimer(MutantCosts &costs, MutantPhase phase)
+  : costs(costs), phase(phase), start(std::chrono::steady_clock::now()) {}
+
+PhaseTimer::~PhaseTimer() {
+  using namespace std::chrono;
+  auto elapsed = duration_cast<microseconds>(steady_clock::now() - start);
+  costs.add(phase, elapsed.count());
+}
+
+ContextMemory::ContextMemory()
+  : modules(0), bitcodeSize(0), functions(0),
+    materializedFunctions(0), instructions(0) {}
+
+Metrics::Metrics()
+  : precompiledObjectFilesSize(0), precompiledObjectFilesResidentSize(0) {}
+
 void Metrics::beginLoadModules() {
   loadModules.begin = currentTimestamp();
 }
@@ -178,6 +263,20 @@ void Metrics::endRun() {
   runTime.end = currentTimestamp();
 }
 
+void Metrics::setPrecompiledObjectFilesMemory(uint64_t size, uint64_t residentSize) {
+  precompiledObjectFilesSize = size;
+  precompiledObjectFilesResidentSize = residentSize;
+}
+
+void Metrics::setContextsMemory(const std::vector<ContextMemory> &contexts) {
+  contextsMemory = contexts;
+}
+
+void Metrics::addMutantCosts(const MutantCosts &workerCosts) {
+  std::lock_guard<std::mutex> lock(costsMutex);
+  costs.merge(workerCosts);
+}
+
 void Metrics::beginReportResult() {
   reportResult.begin = currentTimestamp();
 }
@@ -209,6 +308,21 @@ void Metrics::dump() const {
   cout << "Load dylibs: ...................... " << loadDynamicLibraries.duration() << MetricsMeasure::precision() << endl;
   cout << endl;
 
+  cout << "Object files size: ................ " << precompiledObjectFilesSize / 1024 << "KB" << endl;
+  cout << "Object files resident: ............ " << precompiledObjectFilesResidentSize / 1024 << "KB" << endl;
+  cout << endl;
+
+  for (size_t i = 0; i < contextsMemory.size(); i++) {
+    auto &memory = contextsMemory[i];
+    cout << "Context #" << i << ": " << memory.modules << " modules, "
+         << memory.bitcodeSize / 1024 << "KB of bitcode, "
+         << memory.materializedFunctions << "/" << memory.functions << " functions parsed, "
+         << memory.instructions << " instructions" << endl;
+  }
+  if (!contextsMemory.empty()) {
+    cout << endl;
+  }
+
   cout << "Load original program: ............ " << loadOriginalProgram.duration() << MetricsMeasure::precision() << endl;
   cout << "Load mutant (avg): ................ " << average_duration(loadMutant) << MetricsMeasure::precision() << endl;
   cout << "Load mutant (total): .............. " << accumulate_duration(loadMutant) << MetricsMeasure::precision() << endl;
@@ -229,5 +343,23 @@ void Metrics::dump() const {
   cout << "Tests run time (avg): ............. " << average_duration(runOriginalTest) << MetricsMeasure::precision() << endl;
   cout << "Mutants run time (avg): ........... " << totalMutantRunTime / (mutantRuns.size() ? mutantRuns.size() : 1) << MetricsMeasure::precision() << endl;
   cout << endl;
+
+  if (costs.cacheHits + costs.cacheMisses != 0) {
+    cout << "Mutant cache: ..................... " << costs.cacheHits << " hits, "
+         << costs.cacheMisses << " misses" << endl;
+  }
+  for (int i = 0; i < MutantPhasesCount; i++) {
+    auto &histogram = costs.phases[i];
+    if (histogram.count == 0) {
+      continue;
+    }
+    cout << "Mutant " << MutantCosts::phaseName(MutantPhase(i)) << ": "
+         << histogram.count << " times, "
+         << histogram.total / 1000 << "ms total, "
+         << histogram.total / histogram.count << "us avg, "
+         << histogram.percentile(0.5) << "us p50, "
+         << histogram.percentile(0.9) << "us p90, "
+         << histogram.max << "us max" << endl;
+  }
 }
 
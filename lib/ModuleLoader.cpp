@@ -39,13 +39,19 @@ ModuleLoader::loadModuleAtPath(const std::string &path,
 
   std::string hash = MD5HashFromBuffer(BufferOrError->get()->getBuffer());
 
-  auto llvmModule = parseBitcodeFile(BufferOrError->get()->getMemBufferRef(), context);
+  /// Function bodies are only parsed once something needs them,
+  /// most of them are never reached by any test
+  auto llvmModule = llvm_compat::parseLazyBitcodeFile(BufferOrError->get()->getMemBufferRef(),
+                                                      context);
   if (!llvmModule) {
     Logger::error() << "ModuleLoader> Can't load module " << path << '\n';
     return nullptr;
   }
 
-  auto module = make_unique<MullModule>(std::move(llvmModule.get()), hash, path);
+  auto module = make_unique<MullModule>(std::move(llvmModule),
+                                        std::move(BufferOrError.get()),
+                                        hash,
+                                        path);
   return module;
 }
 
@@ -27,14 +27,32 @@ MullModule::MullModule(std::unique_ptr<llvm::Module> llvmModule,
     llvm::sys::path::stem(module->getModuleIdentifier()).str() + "_" + md5;
 }
 
+MullModule::MullModule(std::unique_ptr<llvm::Module> llvmModule,
+                       std::unique_ptr<llvm::MemoryBuffer> bitcode,
+                       const std::string &md5,
+                       const std::string &path)
+: MullModule(std::move(llvmModule), md5, path)
+{
+  this->bitcode = std::move(bitcode);
+}
+
 std::unique_ptr<MullModule> MullModule::clone(LLVMContext &context) {
-  auto bufferOrError = MemoryBuffer::getFile(modulePath);
-  if (!bufferOrError) {
-    Logger::error() << "MullModule::clone> Can't load module " << modulePath << '\n';
-    return nullptr;
+  /// Modules that were not loaded from bitcode are still read from disk
+  std::unique_ptr<MemoryBuffer> fileBuffer;
+  MemoryBufferRef buffer;
+  if (bitcode) {
+    buffer = bitcode->getMemBufferRef();
+  } else {
+    auto bufferOrError = MemoryBuffer::getFile(modulePath);
+    if (!bufferOrError) {
+      Logger::error() << "MullModule::clone> Can't load module " << modulePath << '\n';
+      return nullptr;
+    }
+    fileBuffer = std::move(bufferOrError.get());
+    buffer = fileBuffer->getMemBufferRef();
   }
 
-  auto llvmModule = parseBitcodeFile(bufferOrError->get()->getMemBufferRef(), context);
+  auto llvmModule = parseBitcodeFile(buffer, context);
   if (!llvmModule) {
     Logger::error() << "MullModule::clone> Can't load module " << modulePath << '\n';
     return nullptr;
@@ -43,3 +61,19 @@ std::unique_ptr<MullModule> MullModule::clone(LLVMContext &context) {
   auto module = make_unique<MullModule>(std::move(llvmModule.get()), "", modulePath);
   return module;
 }
+
+std::unique_ptr<MullModule> MullModule::lazyClone(LLVMContext &context) {
+  /// The lazy module keeps reading from the buffer
+  if (!bitcode) {
+    return clone(context);
+  }
+
+  auto llvmModule = llvm_compat::parseLazyBitcodeFile(bitcode->getMemBufferRef(),
+                                                      context);
+  if (!llvmModule) {
+    Logger::error() << "MullModule::lazyClone> Can't load module " << modulePath << '\n';
+    return nullptr;
+  }
+
+  return make_unique<MullModule>(std::move(llvmModule), "", modulePath);
+}
@@ -0,0 +1,422 @@
+#include "MutationHistory.h"
+
+#include "Logger.h"
+#include "LLVMCompatibility.h"
+#include "MullModule.h"
+#include "MutationPoint.h"
+#include "Mutators/Mutator.h"
+#include "Test.h"
+
+#include <llvm/ADT/DenseMap.h>
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/Function.h>
+#include <llvm/IR/GlobalVariable.h>
+#include <llvm/IR/InstrTypes.h>
+#include <llvm/IR/Instructions.h>
+#include <llvm/IR/IntrinsicInst.h>
+#include <llvm/IR/Metadata.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Support/MD5.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <sqlite3.h>
+
+#include <algorithm>
+
+using namespace mull;
+using namespace llvm;
+
+static std::string hashString(const std::string &data) {
+  MD5 hasher;
+  hasher.update(data);
+  MD5::MD5Result hash;
+  hasher.final(hash);
+  SmallString<32> result;
+  MD5::stringifyResult(hash, result);
+  return result.str().str();
+}
+
+static std::string printed(const Type *type) {
+  std::string result;
+  raw_string_ostream stream(result);
+  type->print(stream);
+  return stream.str();
+}
+
+static std::string printed(const Value *value) {
+  std::string result;
+  raw_string_ostream stream(result);
+  value->print(stream);
+  return stream.str();
+}
+
+/// Globals referenced from constant expressions,
+/// e.g. a string literal passed to a function
+static void collectGlobals(const Constant *constant,
+                           std::vector<GlobalVariable *> &globals) {
+  if (auto global = dyn_cast<GlobalVariable>(constant)) {
+    globals.push_back(const_cast<GlobalVariable *>(global));
+    return;
+  }
+  if (isa<GlobalValue>(constant)) {
+    return;
+  }
+  for (auto &operand : constant->operands()) {
+    if (auto nested = dyn_cast<Constant>(operand.get())) {
+      collectGlobals(nested, globals);
+    }
+  }
+}
+
+static bool execute(sqlite3 *database, const char *sql) {
+  char *errorMessage = nullptr;
+  if (sqlite3_exec(database, sql, nullptr, nullptr, &errorMessage) != SQLITE_OK) {
+    Logger::error() << "MutationHistory> Cannot execute " << sql << "\n";
+    Logger::error() << "Reason: '" << errorMessage << "'\n";
+    sqlite3_free(errorMessage);
+    return false;
+  }
+  return true;
+}
+
+MutationHistory::MutationHistory(const std::string &path,
+                                 const std::string &settings)
+  : settings(settings), database(nullptr), lookupStatement(nullptr), insertStatement(nullptr),
+    uncommittedResults(0) {
+  if (path.empty()) {
+    return;
+  }
+
+  if (sqlite3_open(path.c_str(), &database) != SQLITE_OK) {
+    Logger::error() << "MutationHistory> Cannot open " << path << ": "
+                    << sqlite3_errmsg(database) << "\n";
+    sqlite3_close(database);
+    database = nullptr;
+    return;
+  }
+
+  const char *createTable =
+    "CREATE TABLE IF NOT EXISTS mutation_history ("
+    " mutant_key TEXT,"
+    " test_key TEXT,"
+    " status INTEGER,"
+    " exit_status INTEGER,"
+    " duration INTEGER,"
+    " stdout TEXT,"
+    " stderr TEXT,"
+    " PRIMARY KEY (mutant_key, test_key))";
+
+  const char *lookup =
+    "SELECT status, exit_status, duration, stdout, stderr"
+    " FROM mutation_history WHERE mutant_key = ?1 AND test_key = ?2";
+
+  const char *insert =
+    "INSERT OR REPLACE INTO mutation_history"
+    " VALUES (?1, ?2, ?3, ?4, ?5, ?6, ?7)";
+
+  if (!execute(database, createTable) ||
+      sqlite3_prepare_v2(database, lookup, -1, &lookupStatement, nullptr) != SQLITE_OK ||
+      sqlite3_prepare_v2(database, insert, -1, &insertStatement, nullptr) != SQLITE_OK) {
+    Logger::error() << "MutationHistory> Ignoring " << path << "\n";
+    sqlite3_finalize(lookupStatement);
+    sqlite3_finalize(insertStatement);
+    sqlite3_close(database);
+    lookupStatement = nullptr;
+    insertStatement = nullptr;
+    database = nullptr;
+  }
+}
+
+MutationHistory::~MutationHistory() {
+  if (isEnabled()) {
+    commit();
+  }
+  sqlite3_finalize(lookupStatement);
+  sqlite3_finalize(insertStatement);
+  sqlite3_close(database);
+}
+
+bool MutationHistory::isEnabled() const {
+  return database != nullptr;
+}
+
+const std::string &MutationHistory::globalHash(GlobalVariable &global) {
+  auto cached = globalHashes.find(&global);
+  if (cached != globalHashes.end()) {
+    return cached->second;
+  }
+
+  std::string contents = printed(global.getValueType());
+  contents += global.isConstant() ? " constant " : " global ";
+  contents += global.hasInitializer() ? printed(global.getInitializer()) : "external";
+
+  return globalHashes[&global] = hashString(contents);
+}
+
+/// Only the code matters: local values are numbered in the order
+/// of appearance, and debug intrinsics and metadata are skipped.
+/// Callees are referenced by name, the test key covers their code.
+const std::string &MutationHistory::functionHash(Function &function) {
+  auto cached = functionHashes.find(&function);
+  if (cached != functionHashes.end()) {
+    return cached->second;
+  }
+
+  /// Executed functions may not be parsed yet
+  if (function.isMaterializable() && !llvm_compat::materialize(function)) {
+    Logger::error() << "MutationHistory> Can't materialize "
+                    << function.getName() << '\n';
+  }
+
+  DenseMap<const Value *, unsigned> localValues;
+  unsigned index = 0;
+  for (auto &argument : function.args()) {
+    localValues[&argument] = index++;
+  }
+  for (auto &block : function) {
+    localValues[&block] = index++;
+    for (auto &instruction : block) {
+      localValues[&instruction] = index++;
+    }
+  }
+
+  auto token = [&](const Value *value) -> std::string {
+    auto local = localValues.find(value);
+    if (local != localValues.end()) {
+      return "%" + std::to_string(local->second);
+    }
+    if (isa<MetadataAsValue>(value)) {
+      return "!";
+    }
+    if (auto global = dyn_cast<GlobalVariable>(value)) {
+      return "@" + global->getName().str() + "=" + globalHash(*const_cast<GlobalVariable *>(global));
+    }
+    if (auto global = dyn_cast<GlobalValue>(value)) {
+      return "@" + global->getName().str();
+    }
+
+    std::string result = printed(value);
+    if (auto constant = dyn_cast<Constant>(value)) {
+      std::vector<GlobalVariable *> globals;
+      collectGlobals(constant, globals);
+      for (auto global : globals) {
+        result += "=" + globalHash(*global);
+      }
+    }
+    return result;
+  };
+
+  std::string contents = printed(function.getFunctionType());
+  for (auto &block : function) {
+    contents += "\nblock";
+    for (auto &instruction : block) {
+      if (isa<DbgInfoIntrinsic>(instruction)) {
+        continue;
+      }
+
+      contents += "\n";
+      contents += instruction.getOpcodeName();
+      contents += " " + printed(instruction.getType());
+      contents += " " + std::to_string(instruction.getRawSubclassOptionalData());
+
+      /// The parts of instructions that are not operands
+      if (auto compare = dyn_cast<CmpInst>(&instruction)) {
+        contents += " " + std::to_string(compare->getPredicate());
+      }
+      if (auto alloca = dyn_cast<AllocaInst>(&instruction)) {
+        contents += " " + printed(alloca->getAllocatedType());
+      }
+      if (auto load = dyn_cast<LoadInst>(&instruction)) {
+        contents += load->isVolatile() ? " volatile" : "";
+      }
+      if (auto store = dyn_cast<StoreInst>(&instruction)) {
+        contents += store->isVolatile() ? " volatile" : "";
+      }
+      if (auto extract = dyn_cast<ExtractValueInst>(&instruction)) {
+        for (auto index : extract->indices()) {
+          contents += " " + std::to_string(index);
+        }
+      }
+      if (auto insert = dyn_cast<InsertValueInst>(&instruction)) {
+        for (auto index : insert->indices()) {
+          contents += " " + std::to_string(index);
+        }
+      }
+      if (auto phi = dyn_cast<PHINode>(&instruction)) {
+        for (auto incoming : phi->blocks()) {
+          contents += " " + token(incoming);
+        }
+      }
+
+      for (auto &operand : instruction.operands()) {
+        contents += " " + token(operand.get());
+      }
+    }
+  }
+
+  return functionHashes[&function] = hashString(contents);
+}
+
+const std::string &MutationHistory::mutantKey(MutationPoint &mutationPoint) {
+  auto cached = mutantKeys.find(&mutationPoint);
+  if (cached != mutantKeys.end()) {
+    return cached->second;
+  }
+
+  MutationPointAddress address = mutationPoint.getAddress();
+  Module *module = mutationPoint.getOriginalModule()->getModule();
+  Function &function = *std::next(module->begin(), address.getFnIndex());
+
+  std::string key = functionHash(function);
+  key += ";" + std::to_string(address.getBBIndex());
+  key += ";" + std::to_string(address.getIIndex());
+  key += ";" + mutationPoint.getMutator()->getUniqueIdentifier();
+  key += ";" + settings;
+
+  return mutantKeys[&mutationPoint] = hashString(key);
+}
+
+const std::string &MutationHistory::testKey(Test &test) {
+  auto cached = testKeys.find(&test);
+  if (cached != testKeys.end()) {
+    return cached->second;
+  }
+
+  /// Independent of the order of the functions in the program
+  std::vector<std::string> hashes;
+  for (auto function : test.getExecutedFunctions()) {
+    hashes.push_back(functionHash(*function));
+  }
+  std::sort(hashes.begin(), hashes.end());
+
+  std::string key = test.getUniqueIdentifier();
+  for (auto &hash : hashes) {
+    key += ";" + hash;
+  }
+
+  return testKeys[&test] = hashString(key);
+}
+
+bool MutationHistory::lookup(const std::string &mutantKey,
+                             const std::string &testKey,
+                             ExecutionResult &result) {
+  if (!isEnabled()) {
+    return false;
+  }
+
+  sqlite3_bind_text(lookupStatement, 1, mutantKey.c_str(), -1, SQLITE_TRANSIENT);
+  sqlite3_bind_text(lookupStatement, 2, testKey.c_str(), -1, SQLITE_TRANSIENT);
+
+  bool found = sqlite3_step(lookupStatement) == SQLITE_ROW;
+  if (found) {
+    auto text = [&](int column) {
+      auto value = sqlite3_column_text(lookupStatement, column);
+      return value ? std::string(reinterpret_cast<const char *>(value)) : std::string();
+    };
+
+    result.status = ExecutionStatus(sqlite3_column_int(lookupStatement, 0));
+    result.exitStatus = sqlite3_column_int(lookupStatement, 1);
+    result.runningTime = sqlite3_column_int64(lookupStatement, 2);
+    result.stdoutOutput = text(3);
+    result.stderrOutput = text(4);
+    usedResults.insert(std::make_pair(mutantKey, testKey));
+  }
+
+  sqlite3_reset(lookupStatement);
+  sqlite3_clear_bindings(lookupStatement);
+  return found;
+}
+
+/// Results are written as they come, so that a run that is interrupted
+/// still keeps what it has done. Transactions are committed periodically.
+void MutationHistory::record(const std::string &mutantKey,
+                             const std::string &testKey,
+                             const ExecutionResult &result) {
+  if (!isEnabled()) {
+    return;
+  }
+
+  if (uncommittedResults == 0 && !execute(database, "BEGIN TRANSACTION")) {
+    return;
+  }
+
+  sqlite3_bind_text(insertStatement, 1, mutantKey.c_str(), -1, SQLITE_TRANSIENT);
+  sqlite3_bind_text(insertStatement, 2, testKey.c_str(), -1, SQLITE_TRANSIENT);
+  sqlite3_bind_int(insertStatement, 3, result.status);
+  sqlite3_bind_int(insertStatement, 4, result.exitStatus);
+  sqlite3_bind_int64(insertStatement, 5, result.runningTime);
+  sqlite3_bind_text(insertStatement, 6, result.stdoutOutput.c_str(), -1, SQLITE_TRANSIENT);
+  sqlite3_bind_text(insertStatement, 7, result.stderrOutput.c_str(), -1, SQLITE_TRANSIENT);
+  if (sqlite3_step(insertStatement) != SQLITE_DONE) {
+    Logger::error() << "MutationHistory> Cannot record result: "
+                    << sqlite3_errmsg(database) << "\n";
+  }
+  sqlite3_reset(insertStatement);
+  sqlite3_clear_bindings(insertStatement);
+
+  usedResults.insert(std::make_pair(mutantKey, testKey));
+
+  uncommittedResults++;
+  if (uncommittedResults >= CommitInterval) {
+    commit();
+  }
+}
+
+void MutationHistory::commit() {
+  if (uncommittedResults == 0) {
+    return;
+  }
+  execute(database, "COMMIT");
+  uncommittedResults = 0;
+}
+
+void MutationHistory::save() {
+  if (!isEnabled()) {
+    return;
+  }
+
+  commit();
+
+  if (!execute(database, "BEGIN TRANSACTION")) {
+    return;
+  }
+
+  execute(database, "CREATE TEMP TABLE IF NOT EXISTS used_results ("
+                    " mutant_key TEXT, test_key TEXT,"
+                    " PRIMARY KEY (mutant_key, test_key))");
+  execute(database, "DELETE FROM used_results");
+
+  sqlite3_stmt *insertUsed = nullptr;
+  sqlite3_prepare_v2(database,
+                     "INSERT OR IGNORE INTO used_results VALUES (?1, ?2)",
+                     -1, &insertUsed, nullptr);
+
+  bool failed = insertUsed == nullptr;
+
+  for (auto &keys : usedResults) {
+    if (failed) {
+      break;
+    }
+    sqlite3_bind_text(insertUsed, 1, keys.first.c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_text(insertUsed, 2, keys.second.c_str(), -1, SQLITE_TRANSIENT);
+    failed |= sqlite3_step(insertUsed) != SQLITE_DONE;
+    sqlite3_reset(insertUsed);
+  }
+
+  sqlite3_finalize(insertUsed);
+
+  if (failed) {
+    Logger::error() << "MutationHistory> Cannot save results: "
+                    << sqlite3_errmsg(database) << "\n";
+    execute(database, "ROLLBACK");
+    return;
+  }
+
+  execute(database, "DELETE FROM mutation_history WHERE NOT EXISTS"
+                    " (SELECT 1 FROM used_results"
+                    "  WHERE used_results.mutant_key = mutation_history.mutant_key"
+                    "  AND used_results.test_key = mutation_history.test_key)");
+  execute(database, "COMMIT");
+
+  usedResults.clear();
+}
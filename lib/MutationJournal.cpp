@@ -0,0 +1,166 @@
+#include "MutationJournal.h"
+
+#include "Logger.h"
+#include "RecordFormat.h"
+
+#include <llvm/ADT/STLExtras.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace mull;
+using namespace llvm;
+
+static const char *const Magic = "mull-journal";
+
+static void writeHeader(raw_ostream &stream) {
+  RecordWriter writer(stream);
+  writer.string(Magic);
+  writer.number(MutationJournal::FormatVersion);
+  stream << '\n';
+}
+
+MutationJournal::MutationJournal(const std::string &path, bool resume)
+    : descriptor(-1), unsyncedResults(0) {
+  if (path.empty()) {
+    return;
+  }
+
+  size_t validSize = resume ? load(path) : 0;
+
+  int flags = O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC;
+  if (validSize == 0) {
+    flags |= O_TRUNC;
+  }
+  descriptor = open(path.c_str(), flags, 0644);
+  if (descriptor == -1) {
+    Logger::error() << "Cannot open mutation journal " << path << "\n";
+    results.clear();
+    return;
+  }
+
+  /// Whatever follows the last complete record is rewritten
+  if (validSize != 0 && ftruncate(descriptor, validSize) != 0) {
+    Logger::error() << "Cannot truncate mutation journal " << path << "\n";
+  }
+
+  stream = make_unique<raw_fd_ostream>(descriptor, false);
+  if (validSize == 0) {
+    writeHeader(*stream);
+    stream->flush();
+  }
+}
+
+MutationJournal::~MutationJournal() {
+  if (!stream) {
+    return;
+  }
+  sync();
+  stream.reset();
+  close(descriptor);
+}
+
+bool MutationJournal::isEnabled() const {
+  return stream != nullptr;
+}
+
+size_t MutationJournal::size() const {
+  return results.size();
+}
+
+size_t MutationJournal::load(const std::string &path) {
+  auto bufferOrError = MemoryBuffer::getFile(path);
+  if (!bufferOrError) {
+    return 0;
+  }
+
+  StringRef data = bufferOrError.get()->getBuffer();
+  RecordReader reader(data);
+
+  std::string magic;
+  long long version = 0;
+  bool compatible = reader.string(magic) && magic == Magic &&
+                    reader.number(version) && version == FormatVersion;
+  size_t validSize = data.size() - reader.remaining();
+  if (!compatible || validSize == data.size() || data[validSize] != '\n') {
+    Logger::warn() << "Mutation journal " << path
+                   << " is not compatible, starting over\n";
+    return 0;
+  }
+  validSize += 1;
+  RecordReader records(data.substr(validSize));
+
+  while (!records.atEnd()) {
+    std::string mutantKey, testKey;
+    long long status = 0, exitStatus = 0, runningTime = 0;
+    ExecutionResult result;
+    bool complete = records.string(mutantKey) &&
+                    records.string(testKey) &&
+                    records.number(status) &&
+                    records.number(exitStatus) &&
+                    records.number(runningTime) &&
+                    records.string(result.stdoutOutput) &&
+                    records.string(result.stderrOutput);
+
+    /// Every record ends with a newline, a record without it is incomplete
+    size_t end = data.size() - records.remaining();
+    complete = complete && end < data.size() && data[end] == '\n';
+    if (!complete) {
+      Logger::warn() << "Mutation journal " << path
+                     << " ends with an incomplete record, dropping it\n";
+      break;
+    }
+
+    result.status = ExecutionStatus(status);
+    result.exitStatus = int(exitStatus);
+    result.runningTime = runningTime;
+    results[std::make_pair(mutantKey, testKey)] = std::move(result);
+
+    records = RecordReader(data.substr(end + 1));
+    validSize = end + 1;
+  }
+
+  return validSize;
+}
+
+bool MutationJournal::lookup(const std::string &mutantKey,
+                             const std::string &testKey,
+                             ExecutionResult &result) const {
+  auto it = results.find(std::make_pair(mutantKey, testKey));
+  if (it == results.end()) {
+    return false;
+  }
+  result = it->second;
+  return true;
+}
+
+void MutationJournal::record(const std::string &mutantKey,
+                             const std::string &testKey,
+                             const ExecutionResult &result) {
+  if (!stream) {
+    return;
+  }
+
+  RecordWriter writer(*stream);
+  writer.string(mutantKey);
+  writer.string(testKey);
+  writer.number(static_cast<long long>(result.status));
+  writer.number(result.exitStatus);
+  writer.number(result.runningTime);
+  writer.string(result.stdoutOutput);
+  writer.string(result.stderrOutput);
+  *stream << '\n';
+  stream->flush();
+
+  if (++unsyncedResults >= SyncInterval) {
+    sync();
+  }
+}
+
+void MutationJournal::sync() {
+  stream->flush();
+  fsync(descriptor);
+  unsyncedResults = 0;
+}
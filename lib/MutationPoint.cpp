@@ -1,6 +1,8 @@
 #include "MutationPoint.h"
 #include "Toolchain/Compiler.h"
 #include "ModuleLoader.h"
+#include "Logger.h"
+#include "LLVMCompatibility.h"
 
 #include "Mutators/Mutator.h"
 #include <llvm/Transforms/Utils/Cloning.h>
@@ -109,6 +111,13 @@ void MutationPoint::addReachableTest(Test *test, int distance) {
 }
 
 void MutationPoint::applyMutation(MullModule &module) {
+  /// The module may be a lazy clone
+  auto &function = *std::next(module.getModule()->begin(), Address.getFnIndex());
+  if (!llvm_compat::materialize(function)) {
+    Logger::error() << "MutationPoint::applyMutation> Can't materialize "
+                    << function.getName() << '\n';
+  }
+
   mutator->applyMutation(module.getModule(), Address);
 }
 
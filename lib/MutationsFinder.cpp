@@ -1,6 +1,8 @@
 #include "MutationsFinder.h"
 #include "Testee.h"
 #include "Config.h"
+#include "Logger.h"
+#include "LLVMCompatibility.h"
 #include "Parallelization/Parallelization.h"
 
 using namespace mull;
@@ -12,6 +14,16 @@ MutationsFinder::MutationsFinder(std::vector<std::unique_ptr<Mutator>> mutators,
 std::vector<MutationPoint *> MutationsFinder::getMutationPoints(const Context &context,
                                                                 std::vector<MergedTestee> &testees,
                                                                 Filter &filter) {
+  /// Bodies of lazily loaded functions are parsed before the search:
+  /// modules share LLVMContexts, which cannot be modified concurrently
+  for (auto &testee : testees) {
+    Function *function = testee.getTesteeFunction();
+    if (function->isMaterializable() && !llvm_compat::materialize(*function)) {
+      Logger::error() << "MutationsFinder> Can't materialize "
+                      << function->getName() << '\n';
+    }
+  }
+
   std::vector<SearchMutationPointsTask> tasks;
   for (int i = 0; i < config.parallelization().workers; i++) {
     tasks.emplace_back(filter, context, mutators);
@@ -32,6 +32,10 @@ AndOrReplacementMutator::getMutationPoint(MullModule *module,
   return nullptr;
 }
 
+bool AndOrReplacementMutator::canMutateOpcode(unsigned opcode) {
+  return opcode == Instruction::Br;
+}
+
 bool AndOrReplacementMutator::canBeApplied(Value &V) {
   BranchInst *branchInst = dyn_cast<BranchInst>(&V);
 
@@ -234,6 +234,11 @@ ConditionalsBoundaryMutator::getMutationPoint(MullModule *module,
   return new MutationPoint(this, address, instruction, module, diagnostics, sourceLocation);
 }
 
+bool ConditionalsBoundaryMutator::canMutateOpcode(unsigned opcode) {
+  return opcode == Instruction::ICmp ||
+         opcode == Instruction::FCmp;
+}
+
 bool ConditionalsBoundaryMutator::canBeApplied(Value &V) {
   llvm_unreachable("not used here anymore");
   return false;
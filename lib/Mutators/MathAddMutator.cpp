@@ -91,6 +91,12 @@ MathAddMutator::replacementForAddWithOverflow(llvm::Function *addFunction,
                     << ".\n";
   }
 
+  /// The module may already have the replacement, e.g. when several
+  /// mutations are applied to the same module
+  if (Function *existingFunction = module.getFunction(replacementName)) {
+    return existingFunction;
+  }
+
   std::vector<Type*> twoParameters(2, replacementType);
 
   FunctionType *replacementFunctionType =
@@ -121,6 +127,12 @@ MathAddMutator::getMutationPoint(MullModule *module,
   return nullptr;
 }
 
+bool MathAddMutator::canMutateOpcode(unsigned opcode) {
+  return opcode == Instruction::Add ||
+         opcode == Instruction::FAdd ||
+         opcode == Instruction::Call;
+}
+
 bool MathAddMutator::canBeApplied(Value &V) {
   if (BinaryOperator *BinOp = dyn_cast<BinaryOperator>(&V)) {
     BinaryOperator::BinaryOps Opcode = BinOp->getOpcode();
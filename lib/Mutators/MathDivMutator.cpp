@@ -31,6 +31,12 @@ MathDivMutator::getMutationPoint(MullModule *module,
   return nullptr;
 }
 
+bool MathDivMutator::canMutateOpcode(unsigned opcode) {
+  return opcode == Instruction::UDiv ||
+         opcode == Instruction::SDiv ||
+         opcode == Instruction::FDiv;
+}
+
 bool MathDivMutator::canBeApplied(Value &V) {
   if (BinaryOperator *BinOp = dyn_cast<BinaryOperator>(&V)) {
     BinaryOperator::BinaryOps Opcode = BinOp->getOpcode();
@@ -30,6 +30,11 @@ MathMulMutator::getMutationPoint(MullModule *module,
   return nullptr;
 }
 
+bool MathMulMutator::canMutateOpcode(unsigned opcode) {
+  return opcode == Instruction::Mul ||
+         opcode == Instruction::FMul;
+}
+
 bool MathMulMutator::canBeApplied(Value &V) {
   if (BinaryOperator *BinOp = dyn_cast<BinaryOperator>(&V)) {
     BinaryOperator::BinaryOps Opcode = BinOp->getOpcode();
@@ -90,6 +90,12 @@ MathSubMutator::replacementForSubWithOverflow(llvm::Function *testeeFunction,
                     << ".\n";
   }
 
+  /// The module may already have the replacement, e.g. when several
+  /// mutations are applied to the same module
+  if (Function *existingFunction = module.getFunction(replacementName)) {
+    return existingFunction;
+  }
+
   std::vector<Type*> twoParameters(2, replacementType);
 
   FunctionType *replacementFunctionType =
@@ -118,6 +124,12 @@ MathSubMutator::getMutationPoint(MullModule *module,
   return nullptr;
 }
 
+bool MathSubMutator::canMutateOpcode(unsigned opcode) {
+  return opcode == Instruction::Sub ||
+         opcode == Instruction::FSub ||
+         opcode == Instruction::Call;
+}
+
 bool MathSubMutator::canBeApplied(Value &V) {
   if (BinaryOperator *BinOp = dyn_cast<BinaryOperator>(&V)) {
     BinaryOperator::BinaryOps Opcode = BinOp->getOpcode();
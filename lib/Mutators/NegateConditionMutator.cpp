@@ -299,6 +299,11 @@ NegateConditionMutator::getMutationPoint(MullModule *module,
   return nullptr;
 }
 
+bool NegateConditionMutator::canMutateOpcode(unsigned opcode) {
+  return opcode == Instruction::ICmp ||
+         opcode == Instruction::FCmp;
+}
+
 bool NegateConditionMutator::canBeApplied(Value &V) {
 
   if (CmpInst *cmpOp = dyn_cast<CmpInst>(&V)) {
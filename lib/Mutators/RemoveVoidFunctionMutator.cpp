@@ -48,6 +48,10 @@ RemoveVoidFunctionMutator::getMutationPoint(MullModule *module,
   return nullptr;
 }
 
+bool RemoveVoidFunctionMutator::canMutateOpcode(unsigned opcode) {
+  return opcode == Instruction::Call;
+}
+
 bool RemoveVoidFunctionMutator::canBeApplied(Value &V) {
   if (CallInst *callInst = dyn_cast<CallInst>(&V)) {
 
@@ -23,6 +23,10 @@ static bool findPossibleApplication(Value &V, std::string &outDiagnostics);
 static
 llvm::Value *getReplacement(Type *returnType, llvm::LLVMContext &context);
 
+bool ReplaceAssignmentMutator::canMutateOpcode(unsigned opcode) {
+  return opcode == Instruction::Store;
+}
+
 bool ReplaceAssignmentMutator::canBeApplied(Value &V) {
   std::string diagnostics;
 
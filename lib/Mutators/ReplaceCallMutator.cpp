@@ -21,6 +21,11 @@ const std::string ReplaceCallMutator::ID = "replace_call_mutator";
 
 static bool findPossibleApplication(Value &V, std::string &outDiagnostics);
 
+bool ReplaceCallMutator::canMutateOpcode(unsigned opcode) {
+  return opcode == Instruction::Call ||
+         opcode == Instruction::Invoke;
+}
+
 bool ReplaceCallMutator::canBeApplied(Value &V) {
   std::string diagnostics;
 
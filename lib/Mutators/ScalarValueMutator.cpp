@@ -51,6 +51,17 @@ ScalarValueMutator::getMutationPoint(MullModule *module,
   return new MutationPoint(this, address, instruction, module, diagnostics, sourceLocation);
 }
 
+bool ScalarValueMutator::canMutateOpcode(unsigned opcode) {
+  return (opcode >= Instruction::BinaryOpsBegin &&
+          opcode < Instruction::BinaryOpsEnd) ||
+         opcode == Instruction::Store ||
+         opcode == Instruction::FCmp ||
+         opcode == Instruction::ICmp ||
+         opcode == Instruction::Ret ||
+         opcode == Instruction::Call ||
+         opcode == Instruction::Invoke;
+}
+
 /// Currently only used by SimpleTestFinder.
 bool ScalarValueMutator::canBeApplied(Value &V) {
   std::string diagnostics;
@@ -1,33 +1,14 @@
 #include "Parallelization/TaskExecutor.h"
 
-namespace mull {
-std::vector<int> taskBatches(size_t itemsCount, size_t tasks) {
-  assert(itemsCount >= tasks);
-
-  std::vector<int> result;
-
-  int n = itemsCount;
-  int m = tasks;
-
-  int q = 0;
-  int r = 0;
-  int start = 0;
-  int end = 0;
-  int k = 0;
-  int s = 0;
-
-  for (k = 0; k < m; k++) {
-    q = (n - k) / m;
-    r = (n - k) % m;
+#include <algorithm>
 
-    start = end;
-    end = end + q + (r != 0);
-
-    s = s + end - start;
-    result.push_back(end - start);
-  }
-
-  assert(s == n);
-  return result;
+namespace mull {
+/// Guided scheduling: each claimed batch is a fraction of what is left,
+/// so the first batches are large enough to amortize per-call setup of a task
+/// (e.g. creating a TargetMachine), while the last ones contain single items.
+size_t dynamicBatchSize(size_t remainingItems, size_t workers) {
+  assert(workers != 0);
+  assert(remainingItems != 0);
+  return std::max(size_t(1), remainingItems / (workers * 4));
+}
 }
-}
\ No newline at end of file
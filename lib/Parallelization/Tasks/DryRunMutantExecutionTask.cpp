@@ -1,9 +1,13 @@
 #include "Parallelization/Tasks/DryRunMutantExecutionTask.h"
+#include "Parallelization/Tasks/MutantExecutionTask.h"
 #include "Parallelization/Progress.h"
 
 using namespace mull;
 using namespace llvm;
 
+DryRunMutantExecutionTask::DryRunMutantExecutionTask(const Config &config)
+    : config(config) {}
+
 void DryRunMutantExecutionTask::operator()(iterator begin, iterator end, Out &storage,
                                            progress_counter &counter) {
   for (auto it = begin; it != end; it++, counter.increment()) {
@@ -11,7 +15,7 @@ void DryRunMutantExecutionTask::operator()(iterator begin, iterator end, Out &st
     for (auto &reachableTest : mutationPoint->getReachableTests()) {
       auto test = reachableTest.first;
       auto distance = reachableTest.second;
-      auto timeout = test->getExecutionResult().runningTime * 10;
+      auto timeout = MutantExecutionTask::timeout(config, test->getExecutionResult());
       ExecutionResult result;
       result.status = DryRun;
       result.runningTime = timeout;
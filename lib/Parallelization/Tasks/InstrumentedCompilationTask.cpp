@@ -23,14 +23,18 @@ void mull::InstrumentedCompilationTask::operator()(mull::InstrumentedCompilation
 
   for (auto it = begin; it != end; it++, counter.increment()) {
     auto &module = *it->get();
-    auto objectFile = toolchain.cache().getInstrumentedObject(module);
+    /// Function indices are compiled in, they depend on the other modules
+    auto &offsets = instrumentation.getFunctionOffsetMapping();
+    uint32_t offset = offsets.find(module.getModule()->getModuleIdentifier())->second;
+
+    auto objectFile = toolchain.cache().getInstrumentedObject(module, offset);
     if (objectFile.getBinary() == nullptr) {
       LLVMContext instrumentationContext;
       auto clonedModule = module.clone(instrumentationContext);
 
       instrumentation.insertCallbacks(clonedModule->getModule());
       objectFile = toolchain.compiler().compileModule(*clonedModule, *localMachine);
-      toolchain.cache().putInstrumentedObject(objectFile, module);
+      toolchain.cache().putInstrumentedObject(objectFile, module, offset);
     }
     storage.push_back(std::move(objectFile));
   }
@@ -2,6 +2,7 @@
 #include "Parallelization/Progress.h"
 
 #include "Logger.h"
+#include "Toolchain/ObjectFileMapping.h"
 
 using namespace mull;
 using namespace llvm;
@@ -13,7 +14,7 @@ void mull::LoadObjectFilesTask::operator()(mull::LoadObjectFilesTask::iterator b
   for (auto it = begin; it != end; it++, counter.increment()) {
     auto objectFilePath = *it;
     ErrorOr<std::unique_ptr<MemoryBuffer>> buffer =
-        MemoryBuffer::getFile(objectFilePath);
+        ObjectFileMapping::map(objectFilePath);
 
     if (!buffer) {
       Logger::error() << "Cannot load object file: " << objectFilePath << "\n";
@@ -0,0 +1,174 @@
+#include "Parallelization/Tasks/MutantCompilationTask.h"
+#include "Config.h"
+#include "Driver.h"
+#include "MullModule.h"
+#include "MutationPoint.h"
+#include "Toolchain/FunctionRedirection.h"
+#include "Toolchain/Toolchain.h"
+#include "Toolchain/TrivialCompilerEquivalence.h"
+
+#include <llvm/ExecutionEngine/ExecutionEngine.h>
+#include <llvm/IR/LLVMContext.h>
+
+using namespace mull;
+using namespace llvm;
+
+CompiledMutant::CompiledMutant()
+    : mutationPoint(nullptr), status(ExecutionStatus::Invalid) {}
+
+CompiledMutant::CompiledMutant(MutationPoint *mutationPoint,
+                               object::OwningBinary<object::ObjectFile> object)
+    : mutationPoint(mutationPoint), object(std::move(object)),
+      status(ExecutionStatus::Invalid) {}
+
+MutantCompilationTask::MutantCompilationTask(Driver &driver,
+                                             Config &config,
+                                             Toolchain &toolchain,
+                                             Metrics &metrics,
+                                             TrivialCompilerEquivalence &equivalence)
+    : driver(driver), config(config), toolchain(toolchain), metrics(metrics),
+      equivalence(equivalence) {}
+
+/// Mutants are compared against the original code of the same function
+/// when only the function is compiled, and of the same module otherwise
+static std::string equivalenceScope(MutationPoint &mutationPoint, bool redirected) {
+  std::string scope = mutationPoint.getOriginalModule()->getUniqueIdentifier();
+  if (redirected) {
+    scope += ":" + std::to_string(mutationPoint.getAddress().getFnIndex());
+  }
+  return scope;
+}
+
+/// Compiled exactly like a mutant, only without the mutation applied
+static std::string originalHash(MutantCompilationTask &task,
+                                MutationPoint &mutationPoint,
+                                bool redirected) {
+  LLVMContext localContext;
+  auto originalModule = mutationPoint.getOriginalModule();
+  auto clonedModule = redirected ? originalModule->lazyClone(localContext)
+                                 : originalModule->clone(localContext);
+  if (redirected) {
+    FunctionRedirection::extractFunction(*clonedModule->getModule(),
+                                         originalModule->getUniqueIdentifier(),
+                                         mutationPoint.getAddress().getFnIndex());
+  }
+
+  PhaseTimer timer(task.costs, MutantPhase::Codegen);
+  auto original = task.toolchain.compiler().compileModule(*clonedModule.get(),
+                                                          *task.machine);
+  if (!original.getBinary()) {
+    return std::string();
+  }
+  return TrivialCompilerEquivalence::hash(original.getBinary()->getData());
+}
+
+static ExecutionStatus checkEquivalence(MutantCompilationTask &task,
+                                        MutationPoint &mutationPoint,
+                                        object::ObjectFile *mutant) {
+  if (mutant == nullptr) {
+    return ExecutionStatus::Invalid;
+  }
+
+  bool redirected = MutantCompilationTask::isRedirected(task.config, mutationPoint);
+  std::string scope = equivalenceScope(mutationPoint, redirected);
+  if (!task.equivalence.hasOriginal(scope)) {
+    std::string hash = originalHash(task, mutationPoint, redirected);
+    if (hash.empty()) {
+      return ExecutionStatus::Invalid;
+    }
+    task.equivalence.setOriginal(scope, hash);
+  }
+
+  std::string mutantHash = TrivialCompilerEquivalence::hash(mutant->getData());
+  switch (task.equivalence.classify(scope, mutantHash, &mutationPoint)) {
+    case TrivialCompilerEquivalence::Verdict::Equivalent:
+      return ExecutionStatus::Equivalent;
+    case TrivialCompilerEquivalence::Verdict::Duplicate:
+      return ExecutionStatus::Duplicate;
+    case TrivialCompilerEquivalence::Verdict::Unique:
+      return ExecutionStatus::Invalid;
+  }
+  return ExecutionStatus::Invalid;
+}
+
+bool MutantCompilationTask::isRedirected(const Config &config,
+                                         MutationPoint &mutationPoint) {
+  return config.getMutantCompilation() == Config::MutantCompilation::Function &&
+         FunctionRedirection::canRedirect(mutationPoint);
+}
+
+CompiledMutant MutantCompilationTask::compile(MutationPoint *mutationPoint) {
+  if (driver.schemataID(mutationPoint) != 0) {
+    return CompiledMutant(mutationPoint, object::OwningBinary<object::ObjectFile>());
+  }
+
+  CompiledMutant compiled(mutationPoint, compileMutant(mutationPoint));
+  if (config.trivialCompilerEquivalenceEnabled()) {
+    compiled.status = checkEquivalence(*this, *mutationPoint,
+                                       compiled.object.getBinary());
+    if (compiled.status != ExecutionStatus::Invalid) {
+      compiled.object = object::OwningBinary<object::ObjectFile>();
+    }
+  }
+  return compiled;
+}
+
+object::OwningBinary<object::ObjectFile>
+MutantCompilationTask::compileMutant(MutationPoint *mutationPoint) {
+  if (!machine) {
+    EngineBuilder builder;
+    machine.reset(builder.selectTarget(llvm::Triple(), "", "",
+                                       llvm::SmallVector<std::string, 1>()));
+  }
+
+  auto &cache = toolchain.cache();
+  bool redirected = isRedirected(config, *mutationPoint);
+
+  auto mutant = redirected ? cache.getFunctionObject(*mutationPoint)
+                           : cache.getObject(*mutationPoint);
+  if (mutant.getBinary() != nullptr) {
+    costs.cacheHits++;
+    return mutant;
+  }
+  costs.cacheMisses++;
+
+  /// Only the mutated function is needed in a redirected mutant,
+  /// so the bodies of the other functions are never parsed
+  LLVMContext localContext;
+  auto originalModule = mutationPoint->getOriginalModule();
+  std::unique_ptr<MullModule> clonedModule;
+  {
+    PhaseTimer timer(costs, MutantPhase::Clone);
+    clonedModule = redirected ? originalModule->lazyClone(localContext)
+                              : originalModule->clone(localContext);
+  }
+
+  {
+    PhaseTimer timer(costs, MutantPhase::Mutate);
+    mutationPoint->applyMutation(*clonedModule.get());
+
+    if (redirected) {
+      FunctionRedirection::extractFunction(*clonedModule->getModule(),
+                                           originalModule->getUniqueIdentifier(),
+                                           mutationPoint->getAddress().getFnIndex());
+    }
+  }
+
+  {
+    PhaseTimer timer(costs, MutantPhase::Codegen);
+    mutant = toolchain.compiler().compileModule(*clonedModule.get(), *machine);
+  }
+
+  if (redirected) {
+    cache.putFunctionObject(mutant, *mutationPoint);
+  } else {
+    cache.putObject(mutant, *mutationPoint);
+  }
+
+  return mutant;
+}
+
+void MutantCompilationTask::finish() {
+  metrics.addMutantCosts(costs);
+  costs = MutantCosts();
+}
@@ -1,77 +1,407 @@
 #include "Parallelization/Tasks/MutantExecutionTask.h"
-#include "Parallelization/Progress.h"
+#include "Parallelization/Tasks/MutantCompilationTask.h"
 #include "Driver.h"
 #include "Config.h"
+#include "Logger.h"
 #include "TestRunner.h"
+#include "Toolchain/FunctionRedirection.h"
+#include "Toolchain/Toolchain.h"
 
 #include <llvm/ExecutionEngine/ExecutionEngine.h>
+#include <llvm/Support/MemoryBuffer.h>
 #include <llvm/Support/TargetSelect.h>
 
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <thread>
+
 using namespace mull;
 using namespace llvm;
 
+/// Tests that are cheap to run and close to the mutant go first:
+/// with fail-fast enabled, the first failing test stops the execution,
+/// so the sooner a killing test runs, the less time is spent on a mutant.
+std::vector<std::pair<Test *, int>>
+MutantExecutionTask::orderedReachableTests(MutationPoint *mutationPoint,
+                                           bool failFast) {
+  std::vector<std::pair<Test *, int>> tests(mutationPoint->getReachableTests());
+  if (!failFast) {
+    return tests;
+  }
+
+  auto score = [](const std::pair<Test *, int> &reachableTest) {
+    long long cost = reachableTest.first->getExecutionResult().cost();
+    long long distance = reachableTest.second;
+    return cost * (distance + 1);
+  };
+
+  std::stable_sort(tests.begin(), tests.end(),
+                   [&](const std::pair<Test *, int> &lhs,
+                       const std::pair<Test *, int> &rhs) {
+                     return score(lhs) < score(rhs);
+                   });
+  return tests;
+}
+
+static ExecutionResult runTest(MutantExecutionTask &task,
+                               Test *test,
+                               const std::atomic<bool> *cancelled) {
+  const auto sandboxTimeout =
+    MutantExecutionTask::timeout(task.config, test->getExecutionResult());
+
+  ExecutionResult result = task.sandbox.run([&]() {
+    ExecutionStatus status = task.runner.runTest(test, task.jit);
+    assert(status != ExecutionStatus::Invalid && "Expect to see valid TestResult");
+    return status;
+  }, sandboxTimeout, cancelled);
+
+  assert(result.status != ExecutionStatus::Invalid &&
+      "Expect to see valid TestResult");
+  return result;
+}
+
+/// Runs the tests one by one in the fork server, which has the mutant linked.
+/// Returns the number of tests that got a result: once the server is
+/// unavailable, the test it was running and the ones after it are left to
+/// the caller. With fail-fast enabled, the tests after a failed one get
+/// their result here, so the ones left have not seen a failure yet.
+static size_t runTestsInServer(MutantExecutionTask &task,
+                               const std::vector<std::pair<Test *, int>> &tests,
+                               std::vector<ExecutionResult> &results) {
+  auto atLeastOneTestFailed = false;
+  for (size_t i = 0; i < tests.size(); i++) {
+    if (task.config.failFastModeEnabled() && atLeastOneTestFailed) {
+      results[i].status = ExecutionStatus::FailFast;
+      continue;
+    }
+
+    Test *test = tests[i].first;
+    const auto sandboxTimeout =
+      MutantExecutionTask::timeout(task.config, test->getExecutionResult());
+    if (!task.forkServer->run(reinterpret_cast<uint64_t>(test),
+                              sandboxTimeout, results[i])) {
+      results[i] = ExecutionResult();
+      return i;
+    }
+
+    if (results[i].status != ExecutionStatus::Passed) {
+      atLeastOneTestFailed = true;
+    }
+  }
+  return tests.size();
+}
+
+/// All the tests run in a single sandbox, which saves a fork per test
+static void runTestsInBatch(MutantExecutionTask &task,
+                            const std::vector<std::pair<Test *, int>> &tests,
+                            std::vector<ExecutionResult> &results) {
+  std::vector<std::function<ExecutionStatus ()>> functions;
+  std::vector<long long> timeouts;
+  for (auto &reachableTest : tests) {
+    Test *test = reachableTest.first;
+    functions.push_back([&task, test]() {
+      ExecutionStatus status = task.runner.runTest(test, task.jit);
+      assert(status != ExecutionStatus::Invalid && "Expect to see valid TestResult");
+      return status;
+    });
+    timeouts.push_back(MutantExecutionTask::timeout(task.config,
+                                                    test->getExecutionResult()));
+  }
+
+  results = task.sandbox.runBatch(functions, timeouts,
+                                  task.config.failFastModeEnabled());
+}
+
+static void runTestsSequentially(MutantExecutionTask &task,
+                                 const std::vector<std::pair<Test *, int>> &tests,
+                                 std::vector<ExecutionResult> &results) {
+  auto atLeastOneTestFailed = false;
+  for (size_t i = 0; i < tests.size(); i++) {
+    if (task.config.failFastModeEnabled() && atLeastOneTestFailed) {
+      results[i].status = ExecutionStatus::FailFast;
+      continue;
+    }
+
+    results[i] = runTest(task, tests[i].first, nullptr);
+    if (results[i].status != ExecutionStatus::Passed) {
+      atLeastOneTestFailed = true;
+    }
+  }
+}
+
+/// Every test runs in its own process forked from the worker, which has
+/// the mutant linked already. With fail-fast enabled, the first test to kill
+/// the mutant stops the ones still running, and the rest are not started.
+static void runTestsConcurrently(MutantExecutionTask &task,
+                                 const std::vector<std::pair<Test *, int>> &tests,
+                                 size_t workers,
+                                 std::vector<ExecutionResult> &results) {
+  const bool failFast = task.config.failFastModeEnabled();
+  std::atomic<bool> atLeastOneTestFailed(false);
+  std::atomic<size_t> cursor(0);
+
+  auto runTests = [&]() {
+    for (size_t i = cursor++; i < tests.size(); i = cursor++) {
+      results[i] = runTest(task, tests[i].first,
+                           failFast ? &atLeastOneTestFailed : nullptr);
+      if (results[i].status != ExecutionStatus::Passed &&
+          results[i].status != ExecutionStatus::FailFast) {
+        atLeastOneTestFailed = true;
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < std::min(workers, tests.size()); i++) {
+    threads.emplace_back(runTests);
+  }
+  runTests();
+
+  for (auto &thread : threads) {
+    thread.join();
+  }
+}
+
+/// Runs the tests against the mutant linked by the worker itself
+static void runTestsInWorker(MutantExecutionTask &task,
+                             const std::vector<std::pair<Test *, int>> &tests,
+                             std::vector<ExecutionResult> &results) {
+  size_t testWorkers = task.config.parallelization().mutantTestWorkers;
+  if (task.config.forkEnabled() && testWorkers > 1 && tests.size() > 1) {
+    runTestsConcurrently(task, tests, testWorkers, results);
+  } else if (task.config.batchedSandboxEnabled() && tests.size() > 1) {
+    runTestsInBatch(task, tests, results);
+  } else {
+    runTestsSequentially(task, tests, results);
+  }
+}
+
+template <typename T>
+static T *symbolAddress(MutantExecutionTask &task, const std::string &name) {
+  auto &mangler = task.toolchain.mangler();
+  auto &symbol = task.jit.getSymbol(mangler.getNameWithPrefix(name));
+  return reinterpret_cast<T *>(
+    static_cast<uintptr_t>(llvm_compat::JITSymbolAddress(symbol)));
+}
+
+/// Woven mutants are already in the program compiled with mutant schemata,
+/// the program is linked once and then only the active mutant ID changes
+static void loadWovenMutant(MutantExecutionTask &task,
+                            MutationPoint &mutationPoint) {
+  if (!task.schemataLoaded) {
+    auto objectFiles = task.driver.AllButOne(nullptr);
+    task.runner.loadProgram(objectFiles, task.jit);
+    task.schemataLoaded = true;
+  }
+
+  auto moduleIdentifier = mutationPoint.getOriginalModule()->getUniqueIdentifier();
+  auto activeMutant = symbolAddress<int32_t>(task,
+    FunctionRedirection::activeMutantName(moduleIdentifier));
+  assert(activeMutant && "Expect to find active mutant ID");
+
+  *activeMutant = task.driver.schemataID(&mutationPoint);
+  task.activeSchemata = activeMutant;
+}
+
+static void loadMutant(MutantExecutionTask &task,
+                       MutationPoint &mutationPoint,
+                       object::ObjectFile *mutant) {
+  /// Must be reset before relinking, which may free the memory it points to
+  if (task.activeRedirect) {
+    *task.activeRedirect = nullptr;
+    task.activeRedirect = nullptr;
+  }
+  if (task.activeSchemata) {
+    *task.activeSchemata = 0;
+    task.activeSchemata = nullptr;
+  }
+
+  if (task.driver.schemataID(&mutationPoint) != 0) {
+    loadWovenMutant(task, mutationPoint);
+    return;
+  }
+  task.schemataLoaded = false;
+
+  bool redirected = MutantCompilationTask::isRedirected(task.config, mutationPoint);
+  auto module = mutationPoint.getOriginalModule()->getModule();
+
+  auto objectFilesWithMutant = task.driver.AllButOne(redirected ? nullptr : module);
+  objectFilesWithMutant.push_back(mutant);
+  task.runner.loadProgram(objectFilesWithMutant, task.jit);
+
+  if (!redirected) {
+    return;
+  }
+
+  auto &original = *std::next(module->begin(), mutationPoint.getAddress().getFnIndex());
+  auto moduleIdentifier = mutationPoint.getOriginalModule()->getUniqueIdentifier();
+
+  auto redirect = symbolAddress<void *>(task,
+    FunctionRedirection::redirectName(original, moduleIdentifier));
+  auto mutatedFunction = symbolAddress<void>(task,
+    FunctionRedirection::mutantName(original, moduleIdentifier));
+  assert(redirect && mutatedFunction && "Expect to find redirected function");
+
+  *redirect = mutatedFunction;
+  task.activeRedirect = redirect;
+}
+
+/// Runs in the fork server: links the program along with
+/// the mutant sent by the worker. Woven mutants come without an object file.
+static bool loadMutantInServer(MutantExecutionTask &task,
+                               uint64_t key,
+                               llvm::StringRef payload) {
+  auto mutationPoint = reinterpret_cast<MutationPoint *>(key);
+  if (payload.empty()) {
+    loadMutant(task, *mutationPoint, nullptr);
+    return true;
+  }
+
+  std::unique_ptr<MemoryBuffer> buffer = MemoryBuffer::getMemBufferCopy(payload);
+
+  Expected<std::unique_ptr<object::ObjectFile>> objectOrError =
+    object::ObjectFile::createObjectFile(buffer->getMemBufferRef());
+
+  if (!objectOrError) {
+    consumeError(objectOrError.takeError());
+    return false;
+  }
+
+  task.serverMutant =
+    object::OwningBinary<object::ObjectFile>(std::move(objectOrError.get()),
+                                             std::move(buffer));
+
+  loadMutant(task, *mutationPoint, task.serverMutant.getBinary());
+  return true;
+}
+
 mull::MutantExecutionTask::MutantExecutionTask(Driver &driver,
                                                ProcessSandbox &sandbox,
                                                TestRunner &runner,
                                                Config &config,
                                                Toolchain &toolchain,
-                                               Filter &filter)
-    : sandbox(sandbox), runner(runner),
-      config(config), toolchain(toolchain), filter(filter), driver(driver) {}
-
-void MutantExecutionTask::operator()(MutantExecutionTask::iterator begin,
-                                     MutantExecutionTask::iterator end,
-                                     MutantExecutionTask::Out &storage,
-                                     progress_counter &counter) {
-  EngineBuilder builder;
-  auto target = builder.selectTarget(llvm::Triple(), "", "",
-                                     llvm::SmallVector<std::string, 1>());
-  std::unique_ptr<TargetMachine> localMachine(target);
-
-  for (auto it = begin; it != end; ++it, counter.increment()) {
-    auto mutationPoint = *it;
-    auto objectFilesWithMutant = driver.AllButOne(mutationPoint->getOriginalModule()->getModule());
-
-    auto mutant = toolchain.cache().getObject(*mutationPoint);
-    if (mutant.getBinary() == nullptr) {
-      LLVMContext localContext;
-      auto clonedModule = mutationPoint->getOriginalModule()->clone(localContext);
-      mutationPoint->applyMutation(*clonedModule.get());
-      mutant = toolchain.compiler().compileModule(*clonedModule.get(), *localMachine);
-      toolchain.cache().putObject(mutant, *mutationPoint);
-    }
+                                               Filter &filter,
+                                               Metrics &metrics)
+    : activeRedirect(nullptr), activeSchemata(nullptr), schemataLoaded(false), sandbox(sandbox), runner(runner),
+      config(config), toolchain(toolchain), filter(filter), driver(driver), metrics(metrics) {}
+
+void MutantExecutionTask::startForkServer() {
+  forkServer = make_unique<ForkServer>(
+    [this](uint64_t key, llvm::StringRef payload) {
+      return loadMutantInServer(*this, key, payload);
+    },
+    [this](uint64_t key, long long timeout) {
+      auto test = reinterpret_cast<Test *>(key);
+      return sandbox.run([&]() {
+        return runner.runTest(test, jit);
+      }, timeout);
+    });
 
-    objectFilesWithMutant.push_back(mutant.getBinary());
+  /// The task runs the mutants itself if the server cannot be started
+  if (!forkServer->start()) {
+    forkServer.reset();
+  }
+}
 
-    runner.loadProgram(objectFilesWithMutant, jit);
+void MutantExecutionTask::execute(CompiledMutant &compiledMutant, Out &storage) {
+  auto mutationPoint = compiledMutant.mutationPoint;
+  auto &mutant = compiledMutant.object;
 
-    auto atLeastOneTestFailed = false;
+  /// Equivalent and duplicate mutants are never linked, every reachable
+  /// test gets the status so that the report still lists them
+  if (compiledMutant.status == ExecutionStatus::Equivalent ||
+      compiledMutant.status == ExecutionStatus::Duplicate) {
     for (auto &reachableTest : mutationPoint->getReachableTests()) {
-      auto test = reachableTest.first;
-      auto distance = reachableTest.second;
-
       ExecutionResult result;
-      if (config.failFastModeEnabled() && atLeastOneTestFailed) {
-        result.status = ExecutionStatus::FailFast;
-      } else {
-        const auto timeout = test->getExecutionResult().runningTime * 10;
-        const auto sandboxTimeout = std::max(30LL, timeout);
-
-        result = sandbox.run([&]() {
-          ExecutionStatus status = runner.runTest(test, jit);
-          assert(status != ExecutionStatus::Invalid && "Expect to see valid TestResult");
-          return status;
-        }, sandboxTimeout);
-
-        assert(result.status != ExecutionStatus::Invalid &&
-            "Expect to see valid TestResult");
-
-        if (result.status != ExecutionStatus::Passed) {
-          atLeastOneTestFailed = true;
-        }
-      }
+      result.status = compiledMutant.status;
+      storage.push_back(make_unique<MutationResult>(result, mutationPoint,
+                                                    reachableTest.second,
+                                                    reachableTest.first));
+      driver.streamResult(storage.back().get());
+    }
+    return;
+  }
+
+  llvm::StringRef payload;
+  if (mutant.getBinary()) {
+    payload = mutant.getBinary()->getData();
+  }
+
+  bool loadedByServer = false;
+  {
+    PhaseTimer timer(costs, MutantPhase::Link);
+    loadedByServer = forkServer &&
+      forkServer->load(reinterpret_cast<uint64_t>(mutationPoint), payload);
+
+    if (!loadedByServer) {
+      loadMutant(*this, *mutationPoint, mutant.getBinary());
+    }
+  }
+
+  auto reachableTests = orderedReachableTests(mutationPoint,
+                                              config.failFastModeEnabled());
+  std::vector<ExecutionResult> results(reachableTests.size());
 
-      storage.push_back(make_unique<MutationResult>(result, mutationPoint, distance, test));
+  size_t finished = 0;
+  if (loadedByServer) {
+    finished = runTestsInServer(*this, reachableTests, results);
+    if (finished < reachableTests.size()) {
+      PhaseTimer timer(costs, MutantPhase::Link);
+      loadMutant(*this, *mutationPoint, mutant.getBinary());
     }
   }
+
+  if (finished == 0) {
+    runTestsInWorker(*this, reachableTests, results);
+  } else if (finished < reachableTests.size()) {
+    /// Only a status produced by a test is reported: the tests the server
+    /// did not finish run again against the mutant linked by the worker
+    std::vector<std::pair<Test *, int>> unfinishedTests(
+      reachableTests.begin() + finished, reachableTests.end());
+    std::vector<ExecutionResult> unfinishedResults(unfinishedTests.size());
+    runTestsInWorker(*this, unfinishedTests, unfinishedResults);
+    std::move(unfinishedResults.begin(), unfinishedResults.end(),
+              results.begin() + finished);
+  }
+
+  /// A new server would be forked from a worker thread while the other
+  /// workers are running, and could inherit a lock held by one of them
+  if (forkServer && !forkServer->isRunning()) {
+    Logger::warn() << "ForkServer> The server is gone, the worker runs "
+                      "the rest of its mutants itself\n";
+    forkServer.reset();
+  }
+
+  for (size_t i = 0; i < reachableTests.size(); i++) {
+    auto &result = results[i];
+    costs.add(MutantPhase::Fork, result.forkTime);
+    costs.add(MutantPhase::TestRun, result.testRunTime);
+    costs.add(MutantPhase::OutputCapture, result.outputCaptureTime);
+
+    storage.push_back(make_unique<MutationResult>(result, mutationPoint,
+                                                  reachableTests[i].second,
+                                                  reachableTests[i].first));
+    driver.streamResult(storage.back().get());
+  }
+}
+
+/// The CPU time of a test is measured in microseconds and does not grow
+/// when the machine is busy running other tests, so it is a better base than
+/// the wall-clock time. Tests that spent longer waiting than computing get
+/// their wall-clock time instead, so do the ones restored from old caches.
+long long MutantExecutionTask::timeout(const Config &config,
+                                       const ExecutionResult &originalResult) {
+  long long originalTime = originalResult.cpuTime;
+  long long wallClockTime = originalResult.runningTime * 1000;
+  if (wallClockTime > 2 * originalTime) {
+    originalTime = wallClockTime;
+  }
+  long long timeout = (originalTime * config.getMutantTimeoutMultiplier() + 999) / 1000;
+  return std::max((long long)config.getMutantTimeoutFloor(), timeout);
+}
+
+void MutantExecutionTask::finish() {
+  metrics.addMutantCosts(costs);
+  costs = MutantCosts();
 }
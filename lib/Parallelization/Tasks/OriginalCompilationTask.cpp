@@ -1,6 +1,8 @@
 #include "Parallelization/Tasks/OriginalCompilationTask.h"
 #include "Parallelization/Progress.h"
 #include "Toolchain/Toolchain.h"
+#include "Toolchain/FunctionRedirection.h"
+#include "Config.h"
 
 #include <llvm/ExecutionEngine/ExecutionEngine.h>
 #include <llvm/Support/TargetSelect.h>
@@ -8,7 +10,40 @@
 using namespace mull;
 using namespace llvm;
 
-OriginalCompilationTask::OriginalCompilationTask(Toolchain &toolchain) : toolchain(toolchain) {}
+OriginalCompilationTask::OriginalCompilationTask(Config &config, Toolchain &toolchain,
+                                                 const Schemata &schemata)
+  : config(config), toolchain(toolchain), schemata(schemata) {}
+
+static object::OwningBinary<object::ObjectFile>
+compileRedirectable(Toolchain &toolchain, MullModule &module, TargetMachine &machine) {
+  auto objectFile = toolchain.cache().getRedirectableObject(module);
+  if (objectFile.getBinary() == nullptr) {
+    LLVMContext localContext;
+    auto clonedModule = module.clone(localContext);
+    FunctionRedirection::prepareModule(*clonedModule->getModule(),
+                                       module.getUniqueIdentifier());
+    objectFile = toolchain.compiler().compileModule(*clonedModule, machine);
+    toolchain.cache().putRedirectableObject(objectFile, module);
+  }
+  return objectFile;
+}
+
+static object::OwningBinary<object::ObjectFile>
+compileSchemata(Toolchain &toolchain, MullModule &module,
+                const std::vector<MutationPoint *> &mutationPoints,
+                TargetMachine &machine) {
+  auto objectFile = toolchain.cache().getSchemataObject(module, mutationPoints);
+  if (objectFile.getBinary() == nullptr) {
+    LLVMContext localContext;
+    auto clonedModule = module.clone(localContext);
+    FunctionRedirection::weaveMutants(*clonedModule->getModule(),
+                                      module.getUniqueIdentifier(),
+                                      mutationPoints);
+    objectFile = toolchain.compiler().compileModule(*clonedModule, machine);
+    toolchain.cache().putSchemataObject(objectFile, module, mutationPoints);
+  }
+  return objectFile;
+}
 
 void mull::OriginalCompilationTask::operator()(mull::OriginalCompilationTask::iterator begin,
                                              mull::OriginalCompilationTask::iterator end,
@@ -22,6 +57,18 @@ void mull::OriginalCompilationTask::operator()(mull::OriginalCompilationTask::it
   for (auto it = begin; it != end; it++, counter.increment()) {
     auto &module = *it->get();
 
+    if (config.getMutantCompilation() == Config::MutantCompilation::Function) {
+      storage.push_back(compileRedirectable(toolchain, module, *localMachine));
+      continue;
+    }
+
+    auto woven = schemata.find(module.getModule());
+    if (woven != schemata.end()) {
+      storage.push_back(compileSchemata(toolchain, module, woven->second,
+                                        *localMachine));
+      continue;
+    }
+
     auto objectFile = toolchain.cache().getObject(module);
     if (objectFile.getBinary() == nullptr) {
       LLVMContext localContext;
@@ -38,6 +38,9 @@ void OriginalTestExecutionTask::operator()(iterator begin, iterator end, Out &st
     std::vector<std::unique_ptr<Testee>> testees;
 
     if (testExecutionResult.status == Passed) {
+      if (config.historyEnabled()) {
+        test->setExecutedFunctions(instrumentation.getExecutedFunctions(test.get()));
+      }
       testees = instrumentation.getTestees(test.get(), filter, config.getMaxDistance());
     }
     instrumentation.cleanupInstrumentationInfo(test.get());
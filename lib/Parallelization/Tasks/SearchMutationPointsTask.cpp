@@ -2,39 +2,54 @@
 #include "Parallelization/Tasks/SearchMutationPointsTask.h"
 #include "Filter.h"
 #include "Context.h"
+#include "SourceLocation.h"
 
 #include <vector>
 #include <llvm/IR/Function.h>
+#include <llvm/IR/Instruction.h>
 #include <llvm/IR/Module.h>
 
 using namespace mull;
 using namespace llvm;
 
-static int GetFunctionIndex(llvm::Function *function) {
-  Module *parent = function->getParent();
-
-  auto functionIterator = std::find_if(parent->begin(), parent->end(),
-                                       [function] (llvm::Function &f) {
-                                         return &f == function;
-                                       });
-
-  assert(functionIterator != parent->end()
-             && "Expected function to be found in module");
-  int index = static_cast<int>(std::distance(parent->begin(),
-                                             functionIterator));
-
-  return index;
+SearchMutationPointsTask::SearchMutationPointsTask(Filter &filter, const Context &context, std::vector<std::unique_ptr<Mutator>> &mutators)
+    : filter(filter), context(context), mutators(mutators),
+      mutatorsByOpcode(Instruction::OtherOpsEnd) {
+  for (unsigned opcode = 0; opcode < mutatorsByOpcode.size(); opcode++) {
+    for (size_t index = 0; index < mutators.size(); index++) {
+      if (mutators[index]->canMutateOpcode(opcode)) {
+        mutatorsByOpcode[opcode].push_back(index);
+      }
+    }
+  }
 }
 
-SearchMutationPointsTask::SearchMutationPointsTask(Filter &filter, const Context &context, std::vector<std::unique_ptr<Mutator>> &mutators)
-    : filter(filter), context(context), mutators(mutators) {
+/// Indices of all the functions of a module are computed at once,
+/// the testees usually come from the same modules
+int SearchMutationPointsTask::functionIndex(llvm::Function *function) {
+  auto cached = functionIndices.find(function);
+  if (cached != functionIndices.end()) {
+    return cached->second;
+  }
 
+  int index = 0;
+  for (auto &moduleFunction : *function->getParent()) {
+    functionIndices[&moduleFunction] = index;
+    index++;
+  }
+
+  assert(functionIndices.count(function)
+             && "Expected function to be found in module");
+  return functionIndices[function];
 }
 
 void SearchMutationPointsTask::operator()(iterator begin,
                                           iterator end,
                                           std::vector<std::unique_ptr<MutationPoint>> &storage,
                                           progress_counter &counter) {
+  /// Mutation points are grouped by mutator, in the order of the mutators
+  std::vector<std::vector<MutationPoint *>> pointsByMutator(mutators.size());
+
   for (auto it = begin; it != end; it++, counter.increment()) {
     auto &testee = *it;
     Function *function = testee.getTesteeFunction();
@@ -42,34 +57,46 @@ void SearchMutationPointsTask::operator()(iterator begin,
     auto moduleID = function->getParent()->getModuleIdentifier();
     MullModule *module = context.moduleWithIdentifier(moduleID);
 
-    int functionIndex = GetFunctionIndex(function);
-    for (auto &mutator : mutators) {
+    int fnIndex = functionIndex(function);
 
-      int basicBlockIndex = 0;
-      for (auto &basicBlock : function->getBasicBlockList()) {
+    int basicBlockIndex = 0;
+    for (auto &basicBlock : function->getBasicBlockList()) {
 
-        int instructionIndex = 0;
-        for (auto &instruction : basicBlock.getInstList()) {
-          if (filter.shouldSkipInstruction(&instruction)) {
-            instructionIndex++;
-            continue;
-          }
+      int instructionIndex = 0;
+      for (auto &instruction : basicBlock.getInstList()) {
+        auto &interestedMutators = mutatorsByOpcode[instruction.getOpcode()];
+        if (interestedMutators.empty()) {
+          instructionIndex++;
+          continue;
+        }
 
-          auto location = SourceLocation::sourceLocationFromInstruction(&instruction);
+        auto location = SourceLocation::sourceLocationFromInstruction(&instruction);
+        if (filter.shouldSkipLocation(location)) {
+          instructionIndex++;
+          continue;
+        }
 
-          MutationPointAddress address(functionIndex, basicBlockIndex, instructionIndex);
+        MutationPointAddress address(fnIndex, basicBlockIndex, instructionIndex);
+        for (auto mutatorIndex : interestedMutators) {
+          auto &mutator = mutators[mutatorIndex];
           MutationPoint *point = mutator->getMutationPoint(module, address, &instruction, location);
           if (point) {
-            for (auto &reachableTest : testee.getReachableTests()) {
-              point->addReachableTest(reachableTest.first, reachableTest.second);
-            }
-            storage.emplace_back(std::unique_ptr<MutationPoint>(point));
+            pointsByMutator[mutatorIndex].push_back(point);
           }
-          instructionIndex++;
         }
-        basicBlockIndex++;
+        instructionIndex++;
+      }
+      basicBlockIndex++;
+    }
+
+    for (auto &points : pointsByMutator) {
+      for (auto point : points) {
+        for (auto &reachableTest : testee.getReachableTests()) {
+          point->addReachableTest(reachableTest.first, reachableTest.second);
+        }
+        storage.emplace_back(std::unique_ptr<MutationPoint>(point));
       }
+      points.clear();
     }
   }
 }
-
@@ -0,0 +1,48 @@
+#include "Reporters/ResultStream.h"
+
+using namespace mull;
+
+ResultStream::ResultStream(Consumer consumer, size_t capacity)
+  : consumer(std::move(consumer)), capacity(capacity), finished(false),
+    thread(&ResultStream::consume, this) {}
+
+ResultStream::~ResultStream() {
+  finish();
+}
+
+void ResultStream::push(MutationResult *result) {
+  std::unique_lock<std::mutex> lock(mutex);
+  notFull.wait(lock, [this]() { return queue.size() < capacity; });
+  queue.push_back(result);
+  notEmpty.notify_one();
+}
+
+void ResultStream::finish() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    finished = true;
+    notEmpty.notify_one();
+  }
+
+  if (thread.joinable()) {
+    thread.join();
+  }
+}
+
+void ResultStream::consume() {
+  for (;;) {
+    MutationResult *result = nullptr;
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      notEmpty.wait(lock, [this]() { return finished || !queue.empty(); });
+      if (queue.empty()) {
+        return;
+      }
+      result = queue.front();
+      queue.pop_front();
+      notFull.notify_one();
+    }
+
+    consumer(*result);
+  }
+}
@@ -13,6 +13,7 @@
 #include <llvm/IR/Instruction.h>
 #include <llvm/IR/Function.h>
 #include <llvm/IR/Module.h>
+#include <llvm/Support/MD5.h>
 #include <llvm/Support/raw_ostream.h>
 #include <llvm/Support/Path.h>
 
@@ -27,6 +28,7 @@ using namespace mull;
 using namespace llvm;
 
 static void createTables(sqlite3 *database);
+static void createIndexes(sqlite3 *database);
 
 static std::string vectorToCsv(const std::vector<std::string> &v) {
   if (v.empty()) {
@@ -64,7 +66,16 @@ void sqlite_step(sqlite3 *database, sqlite3_stmt *stmt) {
   }
 }
 
-SQLiteReporter::SQLiteReporter(const std::string &projectName) {
+/// The strings are bound without copying, they must stay alive
+/// until the statement is stepped
+static void bindText(sqlite3_stmt *stmt, int index, const std::string &text) {
+  sqlite3_bind_text(stmt, index, text.data(), int(text.size()), SQLITE_STATIC);
+}
+
+SQLiteReporter::SQLiteReporter(const std::string &projectName)
+  : database(nullptr), insertExecutionResultStmt(nullptr),
+    insertMutationResultStmt(nullptr), insertOutputStmt(nullptr),
+    uncommittedResults(0), reportOutput(Config::ReportOutput::All) {
   SmallString<MAXPATHLEN> databasePath;
   auto error = llvm::sys::fs::current_path(databasePath);
   if (error) {
@@ -84,50 +95,81 @@ SQLiteReporter::SQLiteReporter(const std::string &projectName) {
   this->databasePath = databasePath.str();
 }
 
+SQLiteReporter::~SQLiteReporter() {
+  /// The run did not finish, the results reported so far are kept
+  if (database != nullptr) {
+    closeDatabase();
+  }
+}
+
 std::string mull::SQLiteReporter::getDatabasePath() {
   return databasePath;
 }
 
-void mull::SQLiteReporter::reportResults(const Result &result,
-                                         const Config &config,
-                                         const Metrics &metrics) {
-
-  std::string databasePath = getDatabasePath();
+/// Identical outputs are stored once, execution results refer to them by ID.
+/// An empty output is not stored at all.
+long long SQLiteReporter::outputID(const std::string &output) {
+  if (output.empty()) {
+    return 0;
+  }
 
-  sqlite3 *database;
-  sqlite3_open(databasePath.c_str(), &database);
+  MD5 hasher;
+  hasher.update(output);
+  MD5::MD5Result hash;
+  hasher.final(hash);
+  SmallString<32> digest;
+  MD5::stringifyResult(hash, digest);
+
+  std::string key = digest.str().str();
+  auto existing = outputIDs.find(key);
+  if (existing != outputIDs.end()) {
+    return existing->second;
+  }
 
-  createTables(database);
+  bindText(insertOutputStmt, 1, output);
+  sqlite_step(database, insertOutputStmt);
+  sqlite3_clear_bindings(insertOutputStmt);
+  sqlite3_reset(insertOutputStmt);
 
-  sqlite_exec(database, "BEGIN TRANSACTION");
+  long long id = sqlite3_last_insert_rowid(database);
+  outputIDs.insert(std::make_pair(key, id));
+  return id;
+}
 
-  const char *insertExecutionResultQuery = "INSERT INTO execution_result VALUES (?1, ?2, ?3, ?4, ?5, ?6)";
-  sqlite3_stmt *insertExecutionResultStmt;
-  sqlite3_prepare(database, insertExecutionResultQuery, -1, &insertExecutionResultStmt, NULL);
+void SQLiteReporter::bindOutput(sqlite3_stmt *stmt, int index,
+                                const std::string &output) {
+  long long id = outputID(output);
+  if (id == 0) {
+    sqlite3_bind_null(stmt, index);
+  } else {
+    sqlite3_bind_int64(stmt, index, id);
+  }
+}
 
+void SQLiteReporter::insertTests(const std::vector<std::unique_ptr<Test>> &tests) {
   const char *insertTestQuery = "INSERT INTO test VALUES (?1, ?2, ?3, ?4)";
   sqlite3_stmt *insertTestStmt;
   sqlite3_prepare(database, insertTestQuery, -1, &insertTestStmt, NULL);
 
-  for (auto &test : result.getTests()) {
+  for (auto &test : tests) {
     std::string testName = test->getTestDisplayName();
     std::string testUniqueId = test->getUniqueIdentifier();
-    ExecutionResult testExecutionResult = test->getExecutionResult();
+    const ExecutionResult &testExecutionResult = test->getExecutionResult();
 
     auto testLocation = SourceLocation::sourceLocationFromFunction(test->testBodyFunction());
 
     int executionResultIndex = 1;
-    sqlite3_bind_text(insertExecutionResultStmt, executionResultIndex++, testUniqueId.c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_text(insertExecutionResultStmt, executionResultIndex++, "", -1, SQLITE_TRANSIENT);
+    bindText(insertExecutionResultStmt, executionResultIndex++, testUniqueId);
+    sqlite3_bind_text(insertExecutionResultStmt, executionResultIndex++, "", 0, SQLITE_STATIC);
     sqlite3_bind_int(insertExecutionResultStmt, executionResultIndex++, testExecutionResult.status);
     sqlite3_bind_int64(insertExecutionResultStmt, executionResultIndex++, testExecutionResult.runningTime);
-    sqlite3_bind_text(insertExecutionResultStmt, executionResultIndex++, testExecutionResult.stdoutOutput.c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_text(insertExecutionResultStmt, executionResultIndex++, testExecutionResult.stderrOutput.c_str(), -1, SQLITE_TRANSIENT);
+    bindOutput(insertExecutionResultStmt, executionResultIndex++, testExecutionResult.stdoutOutput);
+    bindOutput(insertExecutionResultStmt, executionResultIndex++, testExecutionResult.stderrOutput);
 
     int testIndex = 1;
-    sqlite3_bind_text(insertTestStmt, testIndex++, testName.c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_text(insertTestStmt, testIndex++, testUniqueId.c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_text(insertTestStmt, testIndex++, testLocation.filePath.c_str(), -1, SQLITE_TRANSIENT);
+    bindText(insertTestStmt, testIndex++, testName);
+    bindText(insertTestStmt, testIndex++, testUniqueId);
+    bindText(insertTestStmt, testIndex++, testLocation.filePath);
     sqlite3_bind_int(insertTestStmt, testIndex++, testLocation.line);
 
     sqlite_step(database, insertExecutionResultStmt);
@@ -139,39 +181,46 @@ void mull::SQLiteReporter::reportResults(const Result &result,
     sqlite3_reset(insertTestStmt);
   }
 
-  const char *insertMutationResultQuery = "INSERT INTO mutation_result VALUES (?1, ?2, ?3)";
-  sqlite3_stmt *insertMutationResultStmt;
-  sqlite3_prepare(database, insertMutationResultQuery, -1, &insertMutationResultStmt, nullptr);
-
-  for (auto &mutationResult : result.getMutationResults()) {
-    MutationPoint *mutationPoint = mutationResult->getMutationPoint();
-    std::string testId = mutationResult->getTest()->getUniqueIdentifier();
-    std::string pointId = mutationPoint->getUniqueIdentifier();
+  sqlite3_finalize(insertTestStmt);
+}
 
-    ExecutionResult mutationExecutionResult = mutationResult->getExecutionResult();
+void SQLiteReporter::insertMutationResult(MutationResult &mutationResult) {
+  MutationPoint *mutationPoint = mutationResult.getMutationPoint();
+  std::string testId = mutationResult.getTest()->getUniqueIdentifier();
+  std::string pointId = mutationPoint->getUniqueIdentifier();
+
+  const ExecutionResult &mutationExecutionResult = mutationResult.getExecutionResult();
+  ExecutionStatus status = mutationExecutionResult.status;
+  bool keepOutput = reportOutput == Config::ReportOutput::All ||
+                    killsMutant(status);
+
+  int executionResultIndex = 1;
+  bindText(insertExecutionResultStmt, executionResultIndex++, testId);
+  bindText(insertExecutionResultStmt, executionResultIndex++, pointId);
+  sqlite3_bind_int(insertExecutionResultStmt, executionResultIndex++, status);
+  sqlite3_bind_int64(insertExecutionResultStmt, executionResultIndex++, mutationExecutionResult.runningTime);
+  if (keepOutput) {
+    bindOutput(insertExecutionResultStmt, executionResultIndex++, mutationExecutionResult.stdoutOutput);
+    bindOutput(insertExecutionResultStmt, executionResultIndex++, mutationExecutionResult.stderrOutput);
+  }
 
-    int executionResultIndex = 1;
-    sqlite3_bind_text(insertExecutionResultStmt, executionResultIndex++, testId.c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_text(insertExecutionResultStmt, executionResultIndex++, pointId.c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_int(insertExecutionResultStmt, executionResultIndex++, mutationExecutionResult.status);
-    sqlite3_bind_int64(insertExecutionResultStmt, executionResultIndex++, mutationExecutionResult.runningTime);
-    sqlite3_bind_text(insertExecutionResultStmt, executionResultIndex++, mutationExecutionResult.stdoutOutput.c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_text(insertExecutionResultStmt, executionResultIndex++, mutationExecutionResult.stderrOutput.c_str(), -1, SQLITE_TRANSIENT);
-
-    sqlite3_step(insertExecutionResultStmt);
-    sqlite3_clear_bindings(insertExecutionResultStmt);
-    sqlite3_reset(insertExecutionResultStmt);
+  sqlite_step(database, insertExecutionResultStmt);
+  sqlite3_clear_bindings(insertExecutionResultStmt);
+  sqlite3_reset(insertExecutionResultStmt);
 
-    int mutationResultIndex = 1;
-    sqlite3_bind_text(insertMutationResultStmt, mutationResultIndex++, testId.c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_text(insertMutationResultStmt, mutationResultIndex++, pointId.c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_int(insertMutationResultStmt, mutationResultIndex++, mutationResult->getMutationDistance());
+  int mutationResultIndex = 1;
+  bindText(insertMutationResultStmt, mutationResultIndex++, testId);
+  bindText(insertMutationResultStmt, mutationResultIndex++, pointId);
+  sqlite3_bind_int(insertMutationResultStmt, mutationResultIndex++, mutationResult.getMutationDistance());
 
-    sqlite3_step(insertMutationResultStmt);
-    sqlite3_clear_bindings(insertMutationResultStmt);
-    sqlite3_reset(insertMutationResultStmt);
-  }
+  sqlite_step(database, insertMutationResultStmt);
+  sqlite3_clear_bindings(insertMutationResultStmt);
+  sqlite3_reset(insertMutationResultStmt);
+}
 
+static void insertMutationPoints(sqlite3 *database,
+                                 const std::vector<MutationPoint *> &mutationPoints,
+                                 const Config &config) {
   const char *insertMutationPointQuery = "INSERT OR IGNORE INTO mutation_point VALUES (?1, ?2, ?3, ?4, ?5, ?6, ?7, ?8, ?9, ?10, ?11, ?12)";
   sqlite3_stmt *insertMutationPointStmt;
   sqlite3_prepare(database, insertMutationPointQuery, -1, &insertMutationPointStmt, NULL);
@@ -180,36 +229,38 @@ void mull::SQLiteReporter::reportResults(const Result &result,
   sqlite3_stmt *insertMutationPointDebugStmt;
   sqlite3_prepare(database, insertMutationPointDebugQuery, -1, &insertMutationPointDebugStmt, NULL);
 
-  for (auto mutationPoint : result.getMutationPoints()) {
+  for (auto mutationPoint : mutationPoints) {
     Instruction *instruction = dyn_cast<Instruction>(mutationPoint->getOriginalValue());
 
     SourceLocation location = SourceLocation::sourceLocationFromInstruction(instruction);
 
+    std::string mutatorID = mutationPoint->getMutator()->getUniqueIdentifier();
+    std::string functionName = instruction->getFunction()->getName().str();
+    const std::string &diagnostics = mutationPoint->getDiagnostics();
+    std::string mutationPointID = mutationPoint->getUniqueIdentifier();
+
     int index = 1;
-    sqlite3_bind_text(insertMutationPointStmt, index++,
-                      mutationPoint->getMutator()->getUniqueIdentifier().c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_text(insertMutationPointStmt, index++, instruction->getParent()->getParent()->getParent()->getModuleIdentifier().c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_text(insertMutationPointStmt, index++, instruction->getParent()->getParent()->getName().str().c_str(), -1, SQLITE_TRANSIENT);
+    bindText(insertMutationPointStmt, index++, mutatorID);
+    bindText(insertMutationPointStmt, index++, instruction->getModule()->getModuleIdentifier());
+    bindText(insertMutationPointStmt, index++, functionName);
 
     sqlite3_bind_int(insertMutationPointStmt, index++, mutationPoint->getAddress().getFnIndex());
     sqlite3_bind_int(insertMutationPointStmt, index++, mutationPoint->getAddress().getBBIndex());
     sqlite3_bind_int(insertMutationPointStmt, index++, mutationPoint->getAddress().getIIndex());
 
-    sqlite3_bind_text(insertMutationPointStmt, index++, location.filePath.c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_text(insertMutationPointStmt, index++, location.directory.c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_text(insertMutationPointStmt, index++, mutationPoint->getDiagnostics().c_str(), -1, SQLITE_TRANSIENT);
+    bindText(insertMutationPointStmt, index++, location.filePath);
+    bindText(insertMutationPointStmt, index++, location.directory);
+    bindText(insertMutationPointStmt, index++, diagnostics);
 
     sqlite3_bind_int(insertMutationPointStmt, index++, location.line);
     sqlite3_bind_int(insertMutationPointStmt, index++, location.column);
 
-    sqlite3_bind_text(insertMutationPointStmt, index++, mutationPoint->getUniqueIdentifier().c_str(), -1, SQLITE_TRANSIENT);
+    bindText(insertMutationPointStmt, index++, mutationPointID);
 
-    sqlite3_step(insertMutationPointStmt);
+    sqlite_step(database, insertMutationPointStmt);
     sqlite3_clear_bindings(insertMutationPointStmt);
     sqlite3_reset(insertMutationPointStmt);
 
-    std::string mutationPointID = mutationPoint->getUniqueIdentifier();
-
     if (config.shouldEmitDebugInfo()) {
       std::string function;
       llvm::raw_string_ostream f_ostream(function);
@@ -224,83 +275,258 @@ void mull::SQLiteReporter::reportResults(const Result &result,
       instruction->print(i_ostream);
 
       int index = 1;
-      sqlite3_bind_text(insertMutationPointDebugStmt, index++, location.filePath.c_str(), -1, SQLITE_TRANSIENT);
-      sqlite3_bind_text(insertMutationPointDebugStmt, index++, location.directory.c_str(), -1, SQLITE_TRANSIENT);
+      bindText(insertMutationPointDebugStmt, index++, location.filePath);
+      bindText(insertMutationPointDebugStmt, index++, location.directory);
 
       sqlite3_bind_int(insertMutationPointDebugStmt, index++, location.line);
       sqlite3_bind_int(insertMutationPointDebugStmt, index++, location.column);
 
-      sqlite3_bind_text(insertMutationPointDebugStmt, index++, f_ostream.str().c_str(), -1, SQLITE_TRANSIENT);
-      sqlite3_bind_text(insertMutationPointDebugStmt, index++, bb_ostream.str().c_str(), -1, SQLITE_TRANSIENT);
-      sqlite3_bind_text(insertMutationPointDebugStmt, index++, i_ostream.str().c_str(), -1, SQLITE_TRANSIENT);
+      bindText(insertMutationPointDebugStmt, index++, f_ostream.str());
+      bindText(insertMutationPointDebugStmt, index++, bb_ostream.str());
+      bindText(insertMutationPointDebugStmt, index++, i_ostream.str());
 
-      sqlite3_bind_text(insertMutationPointDebugStmt, index++, mutationPoint->getUniqueIdentifier().c_str(), -1, SQLITE_TRANSIENT);
+      bindText(insertMutationPointDebugStmt, index++, mutationPointID);
 
-      sqlite3_step(insertMutationPointDebugStmt);
+      sqlite_step(database, insertMutationPointDebugStmt);
       sqlite3_clear_bindings(insertMutationPointDebugStmt);
       sqlite3_reset(insertMutationPointDebugStmt);
     }
   }
 
-  /// Config
-  {
-    const char *insertConfigQuery = "INSERT INTO config VALUES(?1, ?2, ?3, ?4, ?5, ?6, ?7, ?8, ?9, ?10, ?11, ?12, ?13, ?14, ?15)";
-    sqlite3_stmt *insertConfigStmt;
-    sqlite3_prepare(database, insertConfigQuery, -1, &insertConfigStmt, NULL);
+  sqlite3_finalize(insertMutationPointStmt);
+  sqlite3_finalize(insertMutationPointDebugStmt);
+}
+
+static void insertConfig(sqlite3 *database,
+                         const Config &config,
+                         const Metrics &metrics) {
+  const char *insertConfigQuery = "INSERT INTO config VALUES(?1, ?2, ?3, ?4, ?5, ?6, ?7, ?8, ?9, ?10, ?11, ?12, ?13, ?14, ?15)";
+  sqlite3_stmt *insertConfigStmt;
+  sqlite3_prepare(database, insertConfigQuery, -1, &insertConfigStmt, NULL);
+
+  // Start and end times are not part of a config however we are
+  // mixing them in to make them into a final report.
+  const long startTime = metrics.driverRunTime().begin.count();
+  const long endTime = metrics.driverRunTime().end.count();
+
+  std::string csvBitcodePaths = vectorToCsv(config.getBitcodePaths());
+  std::string csvMutators = vectorToCsv(config.getMutators());
+  std::string csvDynamicLibraries = vectorToCsv(config.getDynamicLibrariesPaths());
+  std::string csvObjectFiles = vectorToCsv(config.getObjectFilesPaths());
+  std::string csvTests = vectorToCsv(config.getTests());
+  std::string cacheDirectory = config.getCacheDirectory();
+
+  int index = 1;
+  bindText(insertConfigStmt, index++, config.getProjectName());
+  bindText(insertConfigStmt, index++, csvBitcodePaths);
+  bindText(insertConfigStmt, index++, csvMutators);
+  bindText(insertConfigStmt, index++, csvDynamicLibraries);
+  bindText(insertConfigStmt, index++, csvObjectFiles);
+  bindText(insertConfigStmt, index++, csvTests);
+
+  sqlite3_bind_int(insertConfigStmt, index++, config.forkEnabled());
+  sqlite3_bind_int(insertConfigStmt, index++, config.dryRunModeEnabled());
+  sqlite3_bind_int(insertConfigStmt, index++, config.failFastModeEnabled());
+  sqlite3_bind_int(insertConfigStmt, index++, config.cachingEnabled());
+  sqlite3_bind_int(insertConfigStmt, index++, config.getTimeout());
+  sqlite3_bind_int(insertConfigStmt, index++, config.getMaxDistance());
+
+  bindText(insertConfigStmt, index++, cacheDirectory);
+
+  sqlite3_bind_int64(insertConfigStmt, index++, startTime);
+  sqlite3_bind_int64(insertConfigStmt, index++, endTime);
+
+  sqlite_step(database, insertConfigStmt);
+  sqlite3_finalize(insertConfigStmt);
+}
 
-    // Start and end times are not part of a config however we are
-    // mixing them in to make them into a final report.
-    const long startTime = metrics.driverRunTime().begin.count();
-    const long endTime = metrics.driverRunTime().end.count();
+/// Histograms of the mutant costs, in microseconds
+static void insertMetrics(sqlite3 *database, const Metrics &metrics) {
+  const char *insertMetricQuery = "INSERT INTO metrics VALUES (?1, ?2, ?3, ?4, ?5, ?6, ?7)";
+  sqlite3_stmt *insertMetricStmt;
+  sqlite3_prepare(database, insertMetricQuery, -1, &insertMetricStmt, NULL);
 
-    std::string csvBitcodePaths = vectorToCsv(config.getBitcodePaths());
-    std::string csvMutators = vectorToCsv(config.getMutators());
-    std::string csvDynamicLibraries = vectorToCsv(config.getDynamicLibrariesPaths());
-    std::string csvObjectFiles = vectorToCsv(config.getObjectFilesPaths());
-    std::string csvTests = vectorToCsv(config.getTests());
+  const MutantCosts &costs = metrics.mutantCosts();
+  for (int i = 0; i < MutantPhasesCount; i++) {
+    const DurationHistogram &histogram = costs.phases[i];
+    std::string name = MutantCosts::phaseName(MutantPhase(i));
 
     int index = 1;
-    sqlite3_bind_text(insertConfigStmt, index++, config.getProjectName().c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_text(insertConfigStmt, index++, csvBitcodePaths.c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_text(insertConfigStmt, index++, csvMutators.c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_text(insertConfigStmt, index++, csvDynamicLibraries.c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_text(insertConfigStmt, index++, csvObjectFiles.c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_text(insertConfigStmt, index++, csvTests.c_str(), -1, SQLITE_TRANSIENT);
-
-    sqlite3_bind_int(insertConfigStmt, index++, config.forkEnabled());
-    sqlite3_bind_int(insertConfigStmt, index++, config.dryRunModeEnabled());
-    sqlite3_bind_int(insertConfigStmt, index++, config.failFastModeEnabled());
-    sqlite3_bind_int(insertConfigStmt, index++, config.cachingEnabled());
-    sqlite3_bind_int(insertConfigStmt, index++, config.getTimeout());
-    sqlite3_bind_int(insertConfigStmt, index++, config.getMaxDistance());
-
-    sqlite3_bind_text(insertConfigStmt, index++, config.getCacheDirectory().c_str(), -1, SQLITE_TRANSIENT);
-
-    sqlite3_bind_int64(insertConfigStmt, index++, startTime);
-    sqlite3_bind_int64(insertConfigStmt, index++, endTime);
-
-    sqlite3_step(insertConfigStmt);
+    bindText(insertMetricStmt, index++, name);
+    sqlite3_bind_int64(insertMetricStmt, index++, histogram.count);
+    sqlite3_bind_int64(insertMetricStmt, index++, histogram.total);
+    sqlite3_bind_int64(insertMetricStmt, index++, histogram.percentile(0.5));
+    sqlite3_bind_int64(insertMetricStmt, index++, histogram.percentile(0.9));
+    sqlite3_bind_int64(insertMetricStmt, index++, histogram.percentile(0.99));
+    sqlite3_bind_int64(insertMetricStmt, index++, histogram.max);
+
+    sqlite_step(database, insertMetricStmt);
+    sqlite3_clear_bindings(insertMetricStmt);
+    sqlite3_reset(insertMetricStmt);
+  }
+
+  std::pair<const char *, uint64_t> counters[] = {
+    std::make_pair("cache_hit", costs.cacheHits),
+    std::make_pair("cache_miss", costs.cacheMisses)
+  };
+  for (auto &counter : counters) {
+    sqlite3_bind_text(insertMetricStmt, 1, counter.first, -1, SQLITE_STATIC);
+    sqlite3_bind_int64(insertMetricStmt, 2, counter.second);
+
+    sqlite_step(database, insertMetricStmt);
+    sqlite3_clear_bindings(insertMetricStmt);
+    sqlite3_reset(insertMetricStmt);
+  }
+
+  sqlite3_finalize(insertMetricStmt);
+}
+
+/// The report is written by a single process from scratch, so nothing
+/// is synced to disk until the database is closed. While the results are
+/// streamed, the write-ahead log keeps the database consistent if Mull
+/// crashes. A bulk load is done in a single transaction and needs no journal.
+static sqlite3 *openDatabase(const std::string &databasePath, bool bulkLoad) {
+  sqlite3 *database;
+  sqlite3_open(databasePath.c_str(), &database);
+
+  /// The page size can only be changed before the tables are created
+  sqlite_exec(database, "PRAGMA page_size = 65536");
+  sqlite_exec(database, "PRAGMA cache_size = -65536");
+  sqlite_exec(database, "PRAGMA synchronous = OFF");
+  if (bulkLoad) {
+    sqlite_exec(database, "PRAGMA journal_mode = OFF");
+  } else {
+    sqlite_exec(database, "PRAGMA journal_mode = WAL");
   }
 
+  createTables(database);
+  return database;
+}
+
+/// Tests and mutation points are saved before the mutants run,
+/// so that an interrupted run still leaves a consistent database behind
+void mull::SQLiteReporter::beginResults(const std::vector<std::unique_ptr<Test>> &tests,
+                                        const std::vector<MutationPoint *> &mutationPoints,
+                                        const Config &config) {
+  database = openDatabase(getDatabasePath(), false);
+  prepareStatements(config);
+
+  sqlite_exec(database, "BEGIN TRANSACTION");
+  insertTests(tests);
+  insertMutationPoints(database, mutationPoints, config);
   sqlite_exec(database, "END TRANSACTION");
+}
+
+void mull::SQLiteReporter::prepareStatements(const Config &config) {
+  reportOutput = config.getReportOutput();
+  outputIDs.clear();
+
+  const char *insertOutputQuery = "INSERT INTO output (content) VALUES (?1)";
+  sqlite3_prepare(database, insertOutputQuery, -1, &insertOutputStmt, nullptr);
+
+  const char *insertExecutionResultQuery = "INSERT INTO execution_result VALUES (?1, ?2, ?3, ?4, ?5, ?6)";
+  sqlite3_prepare(database, insertExecutionResultQuery, -1, &insertExecutionResultStmt, NULL);
+
+  const char *insertMutationResultQuery = "INSERT INTO mutation_result VALUES (?1, ?2, ?3)";
+  sqlite3_prepare(database, insertMutationResultQuery, -1, &insertMutationResultStmt, nullptr);
+
+  uncommittedResults = 0;
+}
+
+void mull::SQLiteReporter::reportMutationResult(MutationResult &result) {
+  if (uncommittedResults == 0) {
+    sqlite_exec(database, "BEGIN TRANSACTION");
+  }
+
+  insertMutationResult(result);
+
+  uncommittedResults++;
+  if (uncommittedResults >= CommitInterval) {
+    sqlite_exec(database, "END TRANSACTION");
+    uncommittedResults = 0;
+  }
+}
+
+void mull::SQLiteReporter::closeDatabase() {
+  if (uncommittedResults != 0) {
+    sqlite_exec(database, "END TRANSACTION");
+    uncommittedResults = 0;
+  }
+
+  sqlite3_finalize(insertExecutionResultStmt);
+  sqlite3_finalize(insertMutationResultStmt);
+  sqlite3_finalize(insertOutputStmt);
+  insertExecutionResultStmt = nullptr;
+  insertMutationResultStmt = nullptr;
+  insertOutputStmt = nullptr;
+  outputIDs.clear();
+
+  /// Building the indexes once all the rows are in is much cheaper
+  /// than keeping them up to date on every insert
+  createIndexes(database);
 
+  /// Leaves a single self-contained file behind
+  sqlite_exec(database, "PRAGMA journal_mode = DELETE");
   sqlite3_close(database);
+  database = nullptr;
+}
+
+void mull::SQLiteReporter::reportResults(const Result &result,
+                                         const Config &config,
+                                         const Metrics &metrics) {
+  /// The results were not streamed, everything is saved at once
+  if (database == nullptr) {
+    database = openDatabase(getDatabasePath(), true);
+    prepareStatements(config);
+
+    sqlite_exec(database, "BEGIN TRANSACTION");
+    insertTests(result.getTests());
+    insertMutationPoints(database, result.getMutationPoints(), config);
+    for (auto &mutationResult : result.getMutationResults()) {
+      insertMutationResult(*mutationResult);
+    }
+  } else if (uncommittedResults == 0) {
+    sqlite_exec(database, "BEGIN TRANSACTION");
+  }
+  insertConfig(database, config, metrics);
+  insertMetrics(database, metrics);
+  sqlite_exec(database, "END TRANSACTION");
+  uncommittedResults = 0;
 
-  outs() << "Results can be found at '" << databasePath << "'\n";
+  closeDatabase();
+
+  outs() << "Results can be found at '" << getDatabasePath() << "'\n";
 }
 
 #pragma mark - Database Schema
 
 static const char *CreateTables = R"CreateTables(
+CREATE TABLE output (
+  id INTEGER PRIMARY KEY,
+  content TEXT
+);
+
 CREATE TABLE execution_result (
   test_id TEXT,
   mutation_point_id TEXT,
   status INT,
   duration INT,
-  stdout TEXT,
-  stderr TEXT
+  stdout_id INT,
+  stderr_id INT
 );
 
+CREATE VIEW execution_result_with_output AS
+  SELECT
+    ex.test_id,
+    ex.mutation_point_id,
+    ex.status,
+    ex.duration,
+    coalesce(stdout.content, '') AS stdout,
+    coalesce(stderr.content, '') AS stderr
+  FROM execution_result AS ex
+  LEFT JOIN output AS stdout ON stdout.id = ex.stdout_id
+  LEFT JOIN output AS stderr ON stderr.id = ex.stderr_id;
+
 CREATE TABLE test (
   test_name TEXT,
   unique_id TEXT UNIQUE,
@@ -340,6 +566,16 @@ CREATE TABLE mutation_point_debug (
   unique_id TEXT UNIQUE
 );
 
+CREATE TABLE metrics (
+  name TEXT,
+  count INT,
+  total_us INT,
+  p50_us INT,
+  p90_us INT,
+  p99_us INT,
+  max_us INT
+);
+
 CREATE TABLE config (
   project_name TEXT,
   bitcode_paths TEXT,
@@ -362,3 +598,17 @@ CREATE TABLE config (
 static void createTables(sqlite3 *database) {
   sqlite_exec(database, CreateTables);
 }
+
+/// Covers the lookups of mull-reporter
+static const char *CreateIndexes = R"CreateIndexes(
+CREATE INDEX IF NOT EXISTS execution_result_test_id
+  ON execution_result (test_id);
+CREATE INDEX IF NOT EXISTS execution_result_mutation_point_id
+  ON execution_result (mutation_point_id, status);
+CREATE INDEX IF NOT EXISTS mutation_result_mutation_point_id
+  ON mutation_result (mutation_point_id, test_id);
+)CreateIndexes";
+
+static void createIndexes(sqlite3 *database) {
+  sqlite_exec(database, CreateIndexes);
+}
@@ -1,5 +1,7 @@
 #include "SourceLocation.h"
+#include "LLVMCompatibility.h"
 
+#include <mutex>
 #include <string>
 
 #include <llvm/IR/Instruction.h>
@@ -36,12 +38,26 @@ const SourceLocation SourceLocation::sourceLocationFromInstruction(llvm::Instruc
   return SourceLocation(directory, filePath, line, column);
 }
 
+/// The debug info of a function is only read along with its body.
+/// Parsing the body adds to the LLVMContext shared by several modules,
+/// while other threads may be asking for locations of other functions.
+static std::mutex materializationMutex;
+
 const SourceLocation SourceLocation::sourceLocationFromFunction(llvm::Function *function) {
-  if (function->getMetadata(0) == nullptr) {
+  llvm::MDNode *metadata = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(materializationMutex);
+    if (function->isMaterializable()) {
+      llvm_compat::materialize(*function);
+    }
+    metadata = function->getMetadata(0);
+  }
+
+  if (metadata == nullptr) {
     return nullSourceLocation();
   }
 
-  auto debugInfo = llvm::dyn_cast<llvm::DISubprogram>(function->getMetadata(0));
+  auto debugInfo = llvm::dyn_cast<llvm::DISubprogram>(metadata);
 
   std::string directory = debugInfo->getDirectory();
   std::string filePath = debugInfo->getFilename();
@@ -1,6 +1,8 @@
 #include "Toolchain/Compiler.h"
 
 #include "MullModule.h"
+#include "Logger.h"
+#include "LLVMCompatibility.h"
 
 #include "llvm/ExecutionEngine/Orc/CompileUtils.h"
 #include "llvm/IR/Module.h"
@@ -18,6 +20,12 @@ OwningBinary<ObjectFile> Compiler::compileModule(Module *module,
                                                  TargetMachine &machine) {
   assert(module);
 
+  /// Lazy clones get their remaining functions parsed before codegen
+  if (!llvm_compat::materializeAll(*module)) {
+    Logger::error() << "Compiler> Can't materialize module "
+                    << module->getModuleIdentifier() << '\n';
+  }
+
   if (module->getDataLayout().isDefault()) {
     module->setDataLayout(machine.createDataLayout());
   }
@@ -0,0 +1,358 @@
+#include "Toolchain/FunctionRedirection.h"
+
+#include "MutationPoint.h"
+#include "MullModule.h"
+#include "Mutators/Mutator.h"
+
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/Function.h>
+#include <llvm/IR/GlobalAlias.h>
+#include <llvm/IR/GlobalVariable.h>
+#include <llvm/IR/IRBuilder.h>
+#include <llvm/IR/Instructions.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Transforms/Utils/Cloning.h>
+
+#include <map>
+#include <vector>
+
+using namespace mull;
+using namespace llvm;
+
+static std::string promotedName(const GlobalValue &value,
+                                const std::string &moduleIdentifier) {
+  if (!value.hasLocalLinkage()) {
+    return value.getName().str();
+  }
+  return value.getName().str() + ".mull." + moduleIdentifier;
+}
+
+static void promote(GlobalValue &value, const std::string &moduleIdentifier) {
+  if (!value.hasLocalLinkage()) {
+    return;
+  }
+
+  /// Unnamed values get the same names in every copy of the module,
+  /// since the names are assigned in order
+  if (!value.hasName()) {
+    value.setName("mull_anonymous");
+  }
+
+  value.setName(promotedName(value, moduleIdentifier));
+  value.setLinkage(GlobalValue::ExternalLinkage);
+}
+
+static void promoteInternalSymbols(Module &module,
+                                   const std::string &moduleIdentifier) {
+  for (auto &function : module.functions()) {
+    promote(function, moduleIdentifier);
+  }
+  for (auto &global : module.globals()) {
+    promote(global, moduleIdentifier);
+  }
+  for (auto &alias : module.aliases()) {
+    promote(alias, moduleIdentifier);
+  }
+}
+
+/// Creates a new entry block, the old one becomes its successor
+static BasicBlock *insertEntryBlock(Function &function, const char *name) {
+  BasicBlock *originalEntry = &function.getEntryBlock();
+  BasicBlock *entry = BasicBlock::Create(function.getContext(), name,
+                                         &function, originalEntry);
+
+  /// Static allocas must stay in the entry block
+  while (auto alloca = dyn_cast<AllocaInst>(&originalEntry->front())) {
+    alloca->removeFromParent();
+    entry->getInstList().push_back(alloca);
+  }
+
+  return entry;
+}
+
+/// Passes all the arguments to the target and returns its result
+static void forwardCall(IRBuilder<> &builder, Function &function, Value *target) {
+  std::vector<Value *> arguments;
+  for (auto &argument : function.args()) {
+    arguments.push_back(&argument);
+  }
+  CallInst *call = builder.CreateCall(target, arguments);
+  call->setCallingConv(function.getCallingConv());
+  call->setAttributes(function.getAttributes());
+  call->setTailCallKind(CallInst::TCK_MustTail);
+
+  if (function.getReturnType()->isVoidTy()) {
+    builder.CreateRetVoid();
+  } else {
+    builder.CreateRet(call);
+  }
+}
+
+/// Turns
+///
+///   define i32 @foo(i32 %x) {
+///   entry:
+///     ...
+///   }
+///
+/// into
+///
+///   @foo.mull_redirect = global i32 (i32)* null
+///
+///   define i32 @foo(i32 %x) {
+///   mull_redirect_check:
+///     %target = load i32 (i32)*, i32 (i32)** @foo.mull_redirect
+///     %redirected = icmp ne i32 (i32)* %target, null
+///     br i1 %redirected, label %mull_redirect, label %entry
+///   mull_redirect:
+///     %result = musttail call i32 %target(i32 %x)
+///     ret i32 %result
+///   entry:
+///     ...
+///   }
+static void insertRedirect(Function &function) {
+  Module &module = *function.getParent();
+  LLVMContext &context = module.getContext();
+  PointerType *functionPointerType = function.getType();
+  Constant *null = ConstantPointerNull::get(functionPointerType);
+
+  auto redirect = new GlobalVariable(module,
+                                     functionPointerType,
+                                     false,
+                                     GlobalValue::ExternalLinkage,
+                                     null,
+                                     function.getName() + ".mull_redirect");
+
+  BasicBlock *originalEntry = &function.getEntryBlock();
+  BasicBlock *check = insertEntryBlock(function, "mull_redirect_check");
+  BasicBlock *forward = BasicBlock::Create(context, "mull_redirect",
+                                           &function, originalEntry);
+
+  IRBuilder<> builder(check);
+  Value *target = builder.CreateLoad(redirect);
+  Value *redirected = builder.CreateICmpNE(target, null);
+  builder.CreateCondBr(redirected, forward, originalEntry);
+
+  builder.SetInsertPoint(forward);
+  forwardCall(builder, function, target);
+}
+
+/// Turns
+///
+///   define i32 @foo(i32 %x) {
+///   entry:
+///     ...
+///   }
+///
+/// into
+///
+///   define i32 @foo(i32 %x) {
+///   mull_schemata:
+///     %mutant = load i32, i32* @mull_active_mutant.mull.<module>
+///     switch i32 %mutant, label %entry [
+///       i32 1, label %mull_mutant
+///       ...
+///     ]
+///   mull_mutant:
+///     %result = musttail call i32 @foo.mull_schema.1(i32 %x)
+///     ret i32 %result
+///   ...
+///   entry:
+///     ...
+///   }
+static void insertDispatch(Function &function,
+                           GlobalVariable *activeMutant,
+                           const std::vector<std::pair<int, Function *>> &mutants) {
+  LLVMContext &context = function.getContext();
+  BasicBlock *originalEntry = &function.getEntryBlock();
+  BasicBlock *dispatch = insertEntryBlock(function, "mull_schemata");
+
+  IRBuilder<> builder(dispatch);
+  Value *mutantID = builder.CreateLoad(activeMutant);
+  SwitchInst *switchInst = builder.CreateSwitch(mutantID, originalEntry,
+                                                mutants.size());
+
+  for (auto &mutant : mutants) {
+    BasicBlock *forward = BasicBlock::Create(context, "mull_mutant",
+                                             &function, originalEntry);
+    switchInst->addCase(builder.getInt32(mutant.first), forward);
+
+    builder.SetInsertPoint(forward);
+    forwardCall(builder, function, mutant.second);
+  }
+}
+
+bool FunctionRedirection::canRedirect(const Function &function) {
+  if (function.isDeclaration() || !function.hasName()) {
+    return false;
+  }
+
+  /// A variadic call cannot be forwarded
+  if (function.isVarArg()) {
+    return false;
+  }
+
+  if (function.hasFnAttribute(Attribute::Naked)) {
+    return false;
+  }
+
+  /// Every module with a copy of a linkonce or weak function would define
+  /// its own redirect, and the copy that runs may not be the one redirected.
+  /// Local functions are promoted to external ones, so they are fine.
+  if (!function.hasExternalLinkage() && !function.hasLocalLinkage()) {
+    return false;
+  }
+
+  return true;
+}
+
+bool FunctionRedirection::canRedirect(const MutationPoint &mutationPoint) {
+  Module *module = mutationPoint.getOriginalModule()->getModule();
+  auto fnIndex = mutationPoint.getAddress().getFnIndex();
+  Function &function = *std::next(module->begin(), fnIndex);
+  return canRedirect(function);
+}
+
+void FunctionRedirection::prepareModule(Module &module,
+                                        const std::string &moduleIdentifier) {
+  std::vector<Function *> functions;
+  for (auto &function : module.functions()) {
+    if (canRedirect(function)) {
+      functions.push_back(&function);
+    }
+  }
+
+  promoteInternalSymbols(module, moduleIdentifier);
+
+  for (auto function : functions) {
+    insertRedirect(*function);
+  }
+}
+
+void FunctionRedirection::extractFunction(Module &module,
+                                          const std::string &moduleIdentifier,
+                                          int functionIndex) {
+  Function *mutatedFunction = &*std::next(module.begin(), functionIndex);
+
+  promoteInternalSymbols(module, moduleIdentifier);
+
+  /// Everything else is linked from the prepared original module
+  std::vector<GlobalAlias *> aliases;
+  for (auto &alias : module.aliases()) {
+    aliases.push_back(&alias);
+  }
+  for (auto alias : aliases) {
+    std::string name = alias->getName().str();
+    alias->setName("");
+
+    GlobalValue *declaration = nullptr;
+    if (auto functionType = dyn_cast<FunctionType>(alias->getValueType())) {
+      declaration = Function::Create(functionType,
+                                     GlobalValue::ExternalLinkage,
+                                     name,
+                                     &module);
+    } else {
+      declaration = new GlobalVariable(module,
+                                       alias->getValueType(),
+                                       false,
+                                       GlobalValue::ExternalLinkage,
+                                       nullptr,
+                                       name);
+    }
+
+    alias->replaceAllUsesWith(ConstantExpr::getBitCast(declaration,
+                                                       alias->getType()));
+    alias->eraseFromParent();
+  }
+
+  for (auto &function : module.functions()) {
+    if (&function == mutatedFunction || function.isDeclaration()) {
+      continue;
+    }
+    function.deleteBody();
+    function.setComdat(nullptr);
+  }
+
+  std::vector<GlobalVariable *> specialGlobals;
+  for (auto &global : module.globals()) {
+    if (global.getName().startswith("llvm.")) {
+      specialGlobals.push_back(&global);
+      continue;
+    }
+    if (global.isDeclaration()) {
+      continue;
+    }
+    global.setInitializer(nullptr);
+    global.setLinkage(GlobalValue::ExternalLinkage);
+    global.setComdat(nullptr);
+  }
+
+  /// Constructors, destructors, and used lists belong to the original module
+  for (auto global : specialGlobals) {
+    global->eraseFromParent();
+  }
+
+  mutatedFunction->setName(mutatedFunction->getName() + ".mull_mutant");
+  mutatedFunction->setLinkage(GlobalValue::ExternalLinkage);
+  mutatedFunction->setComdat(nullptr);
+}
+
+std::string FunctionRedirection::redirectName(const Function &function,
+                                              const std::string &moduleIdentifier) {
+  return promotedName(function, moduleIdentifier) + ".mull_redirect";
+}
+
+std::string FunctionRedirection::mutantName(const Function &function,
+                                            const std::string &moduleIdentifier) {
+  return promotedName(function, moduleIdentifier) + ".mull_mutant";
+}
+
+void FunctionRedirection::weaveMutants(Module &module,
+                                       const std::string &moduleIdentifier,
+                                       const std::vector<MutationPoint *> &mutationPoints) {
+  Type *mutantIDType = Type::getInt32Ty(module.getContext());
+  auto activeMutant = new GlobalVariable(module,
+                                         mutantIDType,
+                                         false,
+                                         GlobalValue::ExternalLinkage,
+                                         ConstantInt::get(mutantIDType, 0),
+                                         activeMutantName(moduleIdentifier));
+
+  /// Clones are appended to the module, so the indices of
+  /// the original functions stay the same
+  std::vector<Function *> functions;
+  for (auto &function : module.functions()) {
+    functions.push_back(&function);
+  }
+
+  /// All the mutants are cloned from the original functions,
+  /// the dispatch is inserted once all of them are in place
+  std::map<int, std::vector<std::pair<int, Function *>>> mutantsByFunction;
+  for (size_t index = 0; index < mutationPoints.size(); index++) {
+    MutationPoint *mutationPoint = mutationPoints[index];
+    MutationPointAddress address = mutationPoint->getAddress();
+    Function *function = functions[address.getFnIndex()];
+    int mutantID = int(index) + 1;
+
+    ValueToValueMapTy map;
+    Function *mutant = CloneFunction(function, map);
+    mutant->setName(function->getName() + ".mull_schema." + Twine(mutantID));
+    mutant->setLinkage(GlobalValue::InternalLinkage);
+    mutant->setComdat(nullptr);
+
+    MutationPointAddress mutantAddress(MutationPointAddress::getFunctionIndex(mutant),
+                                       address.getBBIndex(),
+                                       address.getIIndex());
+    mutationPoint->getMutator()->applyMutation(&module, mutantAddress);
+
+    mutantsByFunction[address.getFnIndex()].push_back(std::make_pair(mutantID, mutant));
+  }
+
+  for (auto &entry : mutantsByFunction) {
+    insertDispatch(*functions[entry.first], activeMutant, entry.second);
+  }
+}
+
+std::string FunctionRedirection::activeMutantName(const std::string &moduleIdentifier) {
+  return "mull_active_mutant.mull." + moduleIdentifier;
+}
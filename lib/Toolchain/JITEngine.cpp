@@ -1,39 +1,64 @@
-
 #include "Toolchain/JITEngine.h"
 
+#include <llvm/ExecutionEngine/SectionMemoryManager.h>
+
 using namespace mull;
 using namespace llvm;
 
-JITEngine::JITEngine() : symbolNotFound(nullptr) {}
+namespace {
+
+/// Looks up symbols in the stable object files first, and only then
+/// asks the resolver of the program being loaded
+class StableLayerResolver : public llvm_compat::SymbolResolver {
+  llvm::StringMap<llvm_compat::JITSymbol> &stableSymbolTable;
+  llvm_compat::SymbolResolver &resolver;
+public:
+  StableLayerResolver(llvm::StringMap<llvm_compat::JITSymbol> &stableSymbolTable,
+                      llvm_compat::SymbolResolver &resolver)
+    : stableSymbolTable(stableSymbolTable), resolver(resolver) {}
+
+  llvm_compat::JITSymbolInfo findSymbol(const std::string &name) override {
+    auto symbolIterator = stableSymbolTable.find(name);
+    if (symbolIterator != stableSymbolTable.end()) {
+      auto address = llvm_compat::JITSymbolAddress(symbolIterator->second);
+      if (address) {
+        return llvm_compat::JITSymbolInfo(address, JITSymbolFlags::Exported);
+      }
+    }
 
-void JITEngine::addObjectFiles(std::vector<object::ObjectFile *> &files,
-                               llvm_compat::SymbolResolver &resolver,
-                               std::unique_ptr<llvm::RuntimeDyld::MemoryManager> memManager) {
-  std::vector<object::ObjectFile *>().swap(objectFiles);
-  llvm::StringMap<llvm_compat::JITSymbolInfo>().swap(symbolTable);
-  memoryManager = std::move(memManager);
+    return resolver.findSymbol(name);
+  }
 
-  for (auto object : files) {
-    objectFiles.push_back(object);
+  llvm_compat::JITSymbolInfo findSymbolInLogicalDylib(const std::string &name) override {
+    return resolver.findSymbolInLogicalDylib(name);
+  }
+};
 
-    for (auto symbol : object->symbols()) {
-      if (symbol.getFlags() & object::SymbolRef::SF_Undefined) {
-        continue;
-      }
+}
 
-      Expected<StringRef> name = symbol.getName();
-      if (!name) {
-        consumeError(name.takeError());
-        continue;
-      }
+static void collectSymbols(object::ObjectFile *object,
+                           llvm::StringMap<llvm_compat::JITSymbol> &symbolTable) {
+  for (auto symbol : object->symbols()) {
+    if (symbol.getFlags() & object::SymbolRef::SF_Undefined) {
+      continue;
+    }
 
-      auto flags = llvm_compat::JITSymbolFlagsFromObjectSymbol(symbol);
-      symbolTable.insert(std::make_pair(name.get(), llvm_compat::JITSymbol(0, flags)));
+    Expected<StringRef> name = symbol.getName();
+    if (!name) {
+      consumeError(name.takeError());
+      continue;
     }
 
+    auto flags = llvm_compat::JITSymbolFlagsFromObjectSymbol(symbol);
+    symbolTable.insert(std::make_pair(name.get(), llvm_compat::JITSymbol(0, flags)));
   }
+}
 
-  RuntimeDyld dynamicLoader(*memoryManager, resolver);
+static void link(std::vector<object::ObjectFile *> &objectFiles,
+                 llvm::StringMap<llvm_compat::JITSymbol> &symbolTable,
+                 llvm_compat::SymbolResolver &resolver,
+                 llvm::RuntimeDyld::MemoryManager &memoryManager) {
+  RuntimeDyld dynamicLoader(memoryManager, resolver);
   dynamicLoader.setProcessAllSections(false);
 
   for (auto &object : objectFiles) {
@@ -47,12 +72,64 @@ void JITEngine::addObjectFiles(std::vector<object::ObjectFile *> &files,
   dynamicLoader.finalizeWithMemoryManagerLocking();
 }
 
+JITEngine::JITEngine() : symbolNotFound(nullptr), stableObjectFilesLinked(false) {}
+
+void JITEngine::setStableObjectFiles(const std::vector<object::ObjectFile *> &files) {
+  assert(!stableObjectFilesLinked && "Stable object files are already linked");
+  stableObjectFiles = std::set<object::ObjectFile *>(files.begin(), files.end());
+}
+
+void JITEngine::linkStableObjectFiles(llvm_compat::SymbolResolver &resolver) {
+  std::vector<object::ObjectFile *> files(stableObjectFiles.begin(),
+                                          stableObjectFiles.end());
+  for (auto object : files) {
+    collectSymbols(object, stableSymbolTable);
+  }
+
+  stableMemoryManager = make_unique<SectionMemoryManager>();
+  link(files, stableSymbolTable, resolver, *stableMemoryManager);
+  stableObjectFilesLinked = true;
+}
+
+void JITEngine::addObjectFiles(std::vector<object::ObjectFile *> &files,
+                               llvm_compat::SymbolResolver &resolver,
+                               std::unique_ptr<llvm::RuntimeDyld::MemoryManager> memManager) {
+  std::vector<object::ObjectFile *>().swap(objectFiles);
+  llvm::StringMap<llvm_compat::JITSymbolInfo>().swap(symbolTable);
+  memoryManager = std::move(memManager);
+
+  if (!stableObjectFiles.empty() && !stableObjectFilesLinked) {
+    linkStableObjectFiles(resolver);
+  }
+
+  for (auto object : files) {
+    if (stableObjectFiles.count(object)) {
+      continue;
+    }
+
+    objectFiles.push_back(object);
+    collectSymbols(object, symbolTable);
+  }
+
+  if (stableObjectFiles.empty()) {
+    link(objectFiles, symbolTable, resolver, *memoryManager);
+    return;
+  }
+
+  StableLayerResolver layeredResolver(stableSymbolTable, resolver);
+  link(objectFiles, symbolTable, layeredResolver, *memoryManager);
+}
+
 llvm_compat::JITSymbol &JITEngine::getSymbol(llvm::StringRef name) {
   auto symbolIterator = symbolTable.find(name);
-  if (symbolIterator == symbolTable.end()) {
-    return symbolNotFound;
+  if (symbolIterator != symbolTable.end()) {
+    return symbolIterator->second;
   }
 
-  return symbolIterator->second;
-}
+  symbolIterator = stableSymbolTable.find(name);
+  if (symbolIterator != stableSymbolTable.end()) {
+    return symbolIterator->second;
+  }
 
+  return symbolNotFound;
+}
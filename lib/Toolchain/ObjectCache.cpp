@@ -3,14 +3,161 @@
 #include "Logger.h"
 #include "MullModule.h"
 #include "MutationPoint.h"
+#include "Toolchain/ObjectFileMapping.h"
+
+#include <llvm/Config/llvm-config.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/MD5.h>
+#include <llvm/Support/Path.h>
+#include <llvm/Support/raw_ostream.h>
+#include <llvm/Target/TargetMachine.h>
+
+#include <algorithm>
+#include <ctime>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utime.h>
 
 using namespace mull;
 using namespace llvm;
 using namespace llvm::object;
 
-ObjectCache::ObjectCache(bool useCache, const std::string &cacheDir)
+namespace {
+
+/// Follows the object in each file, so that a reader can tell a complete
+/// object from a truncated or otherwise damaged one
+const char TrailerMagic[8] = { 'm', 'u', 'l', 'l', 'o', 'b', 'j', '1' };
+const size_t ChecksumSize = 16;
+const size_t TrailerSize = ChecksumSize + sizeof(TrailerMagic);
+
+/// Only the files following this naming are ever evicted, the cache
+/// directory may contain something else
+const char CacheFilePrefix[] = "mull-";
+const char TemporarySuffix[] = ".tmp-";
+
+/// Temporary files this old are left by a process that died while writing
+const time_t StaleTemporaryFileAge = 60 * 60;
+
+struct CacheEntry {
+  std::string path;
+  uint64_t size;
+  time_t lastUse;
+};
+
+}
+
+static void checksum(StringRef data, MD5::MD5Result &result) {
+  MD5 hasher;
+  hasher.update(data);
+  hasher.final(result);
+}
+
+static std::string hashString(StringRef data) {
+  MD5::MD5Result hash;
+  checksum(data, hash);
+  SmallString<32> result;
+  MD5::stringifyResult(hash, result);
+  return result.str().str();
+}
+
+static bool hasValidTrailer(StringRef contents) {
+  if (contents.size() < TrailerSize) {
+    return false;
+  }
+
+  StringRef object = contents.substr(0, contents.size() - TrailerSize);
+  StringRef trailer = contents.substr(contents.size() - TrailerSize);
+  if (trailer.substr(ChecksumSize) != StringRef(TrailerMagic, sizeof(TrailerMagic))) {
+    return false;
+  }
+
+  MD5::MD5Result hash;
+  checksum(object, hash);
+  for (size_t i = 0; i < ChecksumSize; i++) {
+    if (uint8_t(trailer[i]) != hash[i]) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/// Anything that changes the generated code but is not part
+/// of the identifiers must be here
+static std::string fingerprint(const TargetMachine &machine) {
+  std::string result;
+  raw_string_ostream stream(result);
+  stream << "format " << ObjectCache::FormatVersion << ";"
+         << "llvm " << LLVM_VERSION_STRING << ";"
+         << machine.getTargetTriple().str() << ";"
+         << machine.getTargetCPU() << ";"
+         << machine.getTargetFeatureString();
+  return stream.str();
+}
+
+static std::vector<CacheEntry> scanCacheDirectory(const std::string &directory) {
+  std::vector<CacheEntry> entries;
+  time_t now = time(nullptr);
+
+  std::error_code error;
+  for (sys::fs::directory_iterator it(directory, error), end;
+       it != end && !error;
+       it.increment(error)) {
+    const std::string &path = it->path();
+    StringRef filename = sys::path::filename(path);
+    if (!filename.startswith(CacheFilePrefix)) {
+      continue;
+    }
+
+    struct stat status;
+    if (stat(path.c_str(), &status) != 0 || !S_ISREG(status.st_mode)) {
+      continue;
+    }
+
+    if (filename.find(TemporarySuffix) != StringRef::npos) {
+      if (now - status.st_mtime > StaleTemporaryFileAge) {
+        sys::fs::remove(path);
+      }
+      continue;
+    }
+
+    entries.push_back({ path, uint64_t(status.st_size), status.st_mtime });
+  }
+
+  return entries;
+}
+
+/// The same module compiled with a different set of woven mutants
+/// is a different object file
+static std::string schemataIdentifier(const MullModule &module,
+                                      const std::vector<MutationPoint *> &mutationPoints) {
+  MD5 hasher;
+  for (auto mutationPoint : mutationPoints) {
+    hasher.update(mutationPoint->getUniqueIdentifier());
+    hasher.update(";");
+  }
+  MD5::MD5Result hash;
+  hasher.final(hash);
+  SmallString<32> result;
+  MD5::stringifyResult(hash, result);
+
+  return "schemata_" + module.getUniqueIdentifier() + "_" + result.str().str();
+}
+
+ObjectCache::ObjectCache(bool useCache,
+                         const std::string &cacheDir,
+                         uint64_t cacheSizeLimit,
+                         const TargetMachine &machine)
   : useOnDiskCache(useCache),
-    cacheDirectory(cacheDir)
+    cacheDirectory(cacheDir),
+    toolchainFingerprint(fingerprint(machine)),
+    sizeLimit(cacheSizeLimit),
+    approximateSize(0),
+    hits(0),
+    misses(0),
+    writes(0),
+    corrupted(0),
+    evictions(0)
 {
   if (useOnDiskCache) {
     auto error = llvm::sys::fs::create_directories(cacheDir);
@@ -23,6 +170,38 @@ ObjectCache::ObjectCache(bool useCache, const std::string &cacheDir)
       useOnDiskCache = false;
     }
   }
+
+  /// Other processes may have filled the directory up since the last run
+  if (useOnDiskCache && sizeLimit != 0) {
+    approximateSize = evict(sizeLimit);
+  }
+}
+
+std::string ObjectCache::cachePath(const std::string &identifier) const {
+  return cacheDirectory + "/" + CacheFilePrefix +
+         hashString(toolchainFingerprint + ";" + identifier);
+}
+
+/// Returns the whole file, the trailer included,
+/// or nothing if the file does not exist or is damaged
+std::unique_ptr<MemoryBuffer> ObjectCache::readFromDisk(const std::string &cacheName) {
+  /// Files are replaced by renaming and never modified in place,
+  /// so the mapping stays valid even if another process evicts the file
+  ErrorOr<std::unique_ptr<MemoryBuffer>> buffer =
+    ObjectFileMapping::map(cacheName);
+
+  if (!buffer) {
+    return nullptr;
+  }
+
+  if (!hasValidTrailer(buffer.get()->getBuffer())) {
+    Logger::debug() << "ObjectCache> Removing damaged " << cacheName << "\n";
+    sys::fs::remove(cacheName);
+    corrupted++;
+    return nullptr;
+  }
+
+  return std::move(buffer.get());
 }
 
 OwningBinary<ObjectFile> ObjectCache::getObjectFromDisk(const std::string &identifier) {
@@ -30,32 +209,65 @@ OwningBinary<ObjectFile> ObjectCache::getObjectFromDisk(const std::string &ident
     return OwningBinary<ObjectFile>();
   }
 
-  std::string cacheName(cacheDirectory + "/" + identifier + ".o");
-
-  ErrorOr<std::unique_ptr<MemoryBuffer>> buffer =
-    MemoryBuffer::getFile(cacheName.c_str());
+  std::string cacheName(cachePath(identifier));
+  std::unique_ptr<MemoryBuffer> buffer = readFromDisk(cacheName);
 
   if (!buffer) {
+    misses++;
     return OwningBinary<ObjectFile>();
   }
 
+  StringRef contents = buffer->getBuffer();
+  MemoryBufferRef objectBuffer(contents.substr(0, contents.size() - TrailerSize),
+                               buffer->getBufferIdentifier());
   Expected<std::unique_ptr<ObjectFile>> objectOrError =
-    ObjectFile::createObjectFile(buffer.get()->getMemBufferRef());
+    ObjectFile::createObjectFile(objectBuffer);
 
   if (!objectOrError) {
+    consumeError(objectOrError.takeError());
+    sys::fs::remove(cacheName);
+    corrupted++;
+    misses++;
     return OwningBinary<ObjectFile>();
   }
 
+  /// The modification time is the last use time for the eviction
+  utime(cacheName.c_str(), nullptr);
+  hits++;
+
   std::unique_ptr<ObjectFile> objectFile(std::move(objectOrError.get()));
 
   auto owningObject = OwningBinary<ObjectFile>(std::move(objectFile),
-                                               std::move(buffer.get()));
+                                               std::move(buffer));
   return owningObject;
 }
 
-OwningBinary<ObjectFile> ObjectCache::getInstrumentedObject(const MullModule &module) {
+bool ObjectCache::getData(const std::string &identifier, std::string &data) {
+  if (!useOnDiskCache) {
+    return false;
+  }
+
+  std::string cacheName(cachePath(identifier));
+  std::unique_ptr<MemoryBuffer> buffer = readFromDisk(cacheName);
+
+  if (!buffer) {
+    misses++;
+    return false;
+  }
+
+  StringRef contents = buffer->getBuffer();
+  data = contents.substr(0, contents.size() - TrailerSize).str();
+
+  utime(cacheName.c_str(), nullptr);
+  hits++;
+  return true;
+}
+
+OwningBinary<ObjectFile> ObjectCache::getInstrumentedObject(const MullModule &module,
+                                                            uint32_t functionIndexOffset) {
   std::string filename("instrumented_");
   filename += module.getUniqueIdentifier();
+  filename += "_" + std::to_string(functionIndexOffset);
   return getObjectFromDisk(filename);
 }
 
@@ -67,25 +279,137 @@ OwningBinary<ObjectFile> ObjectCache::getObject(const MutationPoint &mutationPoi
   return getObjectFromDisk(mutationPoint.getUniqueIdentifier());
 }
 
+OwningBinary<ObjectFile> ObjectCache::getRedirectableObject(const MullModule &module) {
+  std::string filename("redirectable_");
+  filename += module.getUniqueIdentifier();
+  return getObjectFromDisk(filename);
+}
+
+OwningBinary<ObjectFile> ObjectCache::getFunctionObject(const MutationPoint &mutationPoint) {
+  std::string filename("function_");
+  filename += mutationPoint.getUniqueIdentifier();
+  return getObjectFromDisk(filename);
+}
+
+OwningBinary<ObjectFile>
+ObjectCache::getSchemataObject(const MullModule &module,
+                               const std::vector<MutationPoint *> &mutationPoints) {
+  return getObjectFromDisk(schemataIdentifier(module, mutationPoints));
+}
+
 void ObjectCache::putObjectOnDisk(
                   OwningBinary<ObjectFile> &object,
                   const std::string &identifier) {
+  writeToDisk(object.getBinary()->getMemoryBufferRef().getBuffer(), identifier);
+}
+
+void ObjectCache::putData(StringRef data, const std::string &identifier) {
+  writeToDisk(data, identifier);
+}
+
+void ObjectCache::writeToDisk(StringRef data, const std::string &identifier) {
   if (!useOnDiskCache) {
     return;
   }
 
-  std::string cacheName(cacheDirectory + "/" + identifier + ".o");
-  std::error_code EC;
-  raw_fd_ostream outfile(cacheName, EC, sys::fs::F_None);
-  outfile.write(object.getBinary()->getMemoryBufferRef().getBufferStart(),
-                object.getBinary()->getMemoryBufferRef().getBufferSize());
-  outfile.close();
+  std::string cacheName(cachePath(identifier));
+
+  /// Other processes may read the file at any moment,
+  /// it only appears under its name once complete
+  int fd = -1;
+  SmallString<128> temporaryName;
+  auto error = sys::fs::createUniqueFile(cacheName + TemporarySuffix + "%%%%%%%%",
+                                         fd, temporaryName);
+  if (error) {
+    Logger::debug() << "ObjectCache> Cannot create " << cacheName << ": "
+                    << error.message() << "\n";
+    return;
+  }
+
+  MD5::MD5Result hash;
+  checksum(data, hash);
+
+  bool written = false;
+  {
+    raw_fd_ostream outfile(fd, true);
+    outfile << data;
+    for (size_t i = 0; i < ChecksumSize; i++) {
+      outfile << char(hash[i]);
+    }
+    outfile.write(TrailerMagic, sizeof(TrailerMagic));
+    outfile.flush();
+
+    /// Otherwise a crash may leave a renamed but empty file behind
+    written = !outfile.has_error() && fsync(fd) == 0;
+    outfile.close();
+    written = written && !outfile.has_error();
+    outfile.clear_error();
+  }
+
+  if (!written || sys::fs::rename(temporaryName, cacheName)) {
+    Logger::debug() << "ObjectCache> Cannot write " << cacheName << "\n";
+    sys::fs::remove(temporaryName);
+    return;
+  }
+
+  writes++;
+
+  if (sizeLimit == 0) {
+    return;
+  }
+
+  approximateSize += data.size() + TrailerSize;
+  if (approximateSize > sizeLimit) {
+    std::lock_guard<std::mutex> lock(evictionMutex);
+    /// Leave some room so that the next writes do not trigger eviction again
+    if (approximateSize > sizeLimit) {
+      approximateSize = evict(sizeLimit / 4 * 3);
+    }
+  }
+}
+
+/// Removes the least recently used objects until the cache fits
+/// into the target size. Returns the resulting size of the cache.
+///
+/// The directory is scanned each time since other processes
+/// may share it. Files evicted while another process reads them
+/// stay accessible to the reader.
+uint64_t ObjectCache::evict(uint64_t targetSize) {
+  std::vector<CacheEntry> entries = scanCacheDirectory(cacheDirectory);
+
+  uint64_t size = 0;
+  for (auto &entry : entries) {
+    size += entry.size;
+  }
+
+  if (size <= targetSize) {
+    return size;
+  }
+
+  std::sort(entries.begin(), entries.end(),
+            [](const CacheEntry &lhs, const CacheEntry &rhs) {
+              return lhs.lastUse < rhs.lastUse;
+            });
+
+  for (auto &entry : entries) {
+    if (size <= targetSize) {
+      break;
+    }
+    if (!sys::fs::remove(entry.path)) {
+      evictions++;
+    }
+    size -= entry.size;
+  }
+
+  return size;
 }
 
 void ObjectCache::putInstrumentedObject(OwningBinary<ObjectFile> &object,
-                                        const MullModule &module) {
+                                        const MullModule &module,
+                                        uint32_t functionIndexOffset) {
   std::string filename("instrumented_");
   filename += module.getUniqueIdentifier();
+  filename += "_" + std::to_string(functionIndexOffset);
   putObjectOnDisk(object, filename);
 }
 
@@ -98,3 +422,46 @@ void ObjectCache::putObject(OwningBinary<ObjectFile> &object,
                             const MutationPoint &mutationPoint) {
   putObjectOnDisk(object, mutationPoint.getUniqueIdentifier());
 }
+
+void ObjectCache::putRedirectableObject(OwningBinary<ObjectFile> &object,
+                                        const MullModule &module) {
+  std::string filename("redirectable_");
+  filename += module.getUniqueIdentifier();
+  putObjectOnDisk(object, filename);
+}
+
+void ObjectCache::putFunctionObject(OwningBinary<ObjectFile> &object,
+                                    const MutationPoint &mutationPoint) {
+  std::string filename("function_");
+  filename += mutationPoint.getUniqueIdentifier();
+  putObjectOnDisk(object, filename);
+}
+
+void ObjectCache::putSchemataObject(OwningBinary<ObjectFile> &object,
+                                    const MullModule &module,
+                                    const std::vector<MutationPoint *> &mutationPoints) {
+  putObjectOnDisk(object, schemataIdentifier(module, mutationPoints));
+}
+
+ObjectCache::Statistics ObjectCache::statistics() const {
+  Statistics statistics;
+  statistics.hits = hits;
+  statistics.misses = misses;
+  statistics.writes = writes;
+  statistics.corrupted = corrupted;
+  statistics.evictions = evictions;
+  return statistics;
+}
+
+void ObjectCache::printStatistics() const {
+  if (!useOnDiskCache) {
+    return;
+  }
+
+  Statistics stats = statistics();
+  Logger::info() << "ObjectCache> hits: " << stats.hits
+                 << ", misses: " << stats.misses
+                 << ", writes: " << stats.writes
+                 << ", corrupted: " << stats.corrupted
+                 << ", evicted: " << stats.evictions << "\n";
+}
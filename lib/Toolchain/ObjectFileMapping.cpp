@@ -0,0 +1,52 @@
+#include "Toolchain/ObjectFileMapping.h"
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <vector>
+
+using namespace mull;
+using namespace llvm;
+
+#ifdef __APPLE__
+using PageStatus = char;
+#else
+using PageStatus = unsigned char;
+#endif
+
+ErrorOr<std::unique_ptr<MemoryBuffer>> ObjectFileMapping::map(const std::string &path) {
+  /// LLVM does not map the files whose size is a multiple of the page size
+  /// when a null terminator is required, object files do not need one
+  return MemoryBuffer::getFile(path, -1, false);
+}
+
+uint64_t ObjectFileMapping::residentSize(StringRef data) {
+  if (data.empty()) {
+    return 0;
+  }
+
+  const uintptr_t pageSize = sysconf(_SC_PAGESIZE);
+  const uintptr_t begin = reinterpret_cast<uintptr_t>(data.begin()) & ~(pageSize - 1);
+  const uintptr_t end = reinterpret_cast<uintptr_t>(data.end());
+  const size_t pages = (end - begin + pageSize - 1) / pageSize;
+
+  std::vector<PageStatus> status(pages);
+  if (mincore(reinterpret_cast<void *>(begin), end - begin, status.data()) != 0) {
+    return 0;
+  }
+
+  uint64_t resident = 0;
+  for (size_t page = 0; page < pages; page++) {
+    if (!(status[page] & 1)) {
+      continue;
+    }
+    /// The first and the last pages may be shared with other data
+    uintptr_t pageBegin = std::max(begin + page * pageSize,
+                                   reinterpret_cast<uintptr_t>(data.begin()));
+    uintptr_t pageEnd = std::min(begin + (page + 1) * pageSize, end);
+    resident += pageEnd - pageBegin;
+  }
+
+  return resident;
+}
@@ -16,7 +16,6 @@ InstrumentationResolver::InstrumentationResolver(orc::LocalCXXRuntimeOverrides &
 : overrides(overrides),
 instrumentation(instrumentation),
 instrumentationInfoName(mangler.getNameWithPrefix(instrumentation.instrumentationInfoVariableName())),
-functionOffsetPrefix(mangler.getNameWithPrefix(instrumentation.functionIndexOffsetPrefix())),
 trampoline(trampoline) {}
 
 llvm_compat::JITSymbolInfo InstrumentationResolver::findSymbol(const std::string &name) {
@@ -34,12 +33,6 @@ llvm_compat::JITSymbolInfo InstrumentationResolver::findSymbol(const std::string
     return llvm_compat::JITSymbolInfo((uint64_t)trampoline, JITSymbolFlags::Exported);
   }
 
-  if (name.find(functionOffsetPrefix) != std::string::npos) {
-    auto moduleName = name.substr(functionOffsetPrefix.length());
-    auto &mapping = instrumentation.getFunctionOffsetMapping();
-    return llvm_compat::JITSymbolInfo((uint64_t)&mapping[moduleName], JITSymbolFlags::Exported);
-  }
-
   return llvm_compat::JITSymbolInfo(nullptr);
 }
 
@@ -20,7 +20,10 @@ Toolchain::Toolchain(Config &config) :
   nativeTarget(),
   machine(llvm::EngineBuilder().selectTarget(llvm::Triple(), "", "",
                                              llvm::SmallVector<std::string, 1>())),
-  objectCache(config.cachingEnabled(), config.getCacheDirectory()),
+  objectCache(config.cachingEnabled(),
+              config.getCacheDirectory(),
+              uint64_t(config.getCacheSizeLimit()) * 1024 * 1024,
+              *machine),
   simpleCompiler(),
   nameMangler(machine->createDataLayout())
 {
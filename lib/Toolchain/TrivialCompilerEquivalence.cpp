@@ -0,0 +1,63 @@
+#include "Toolchain/TrivialCompilerEquivalence.h"
+
+#include <llvm/ADT/SmallString.h>
+#include <llvm/Support/MD5.h>
+
+using namespace mull;
+using namespace llvm;
+
+TrivialCompilerEquivalence::TrivialCompilerEquivalence()
+  : equivalent(0), duplicate(0) {}
+
+std::string TrivialCompilerEquivalence::hash(StringRef objectData) {
+  MD5 hasher;
+  hasher.update(objectData);
+  MD5::MD5Result result;
+  hasher.final(result);
+  SmallString<32> hash;
+  MD5::stringifyResult(result, hash);
+  return hash.str().str();
+}
+
+bool TrivialCompilerEquivalence::hasOriginal(const std::string &scope) {
+  std::lock_guard<std::mutex> lock(mutex);
+  return originals.count(scope) != 0;
+}
+
+void TrivialCompilerEquivalence::setOriginal(const std::string &scope,
+                                             const std::string &originalHash) {
+  std::lock_guard<std::mutex> lock(mutex);
+  originals.insert(std::make_pair(scope, originalHash));
+}
+
+/// Mutants are compiled in parallel, so which one of several identical
+/// mutants runs depends on which one is compiled first. Their results would
+/// be the same anyway.
+TrivialCompilerEquivalence::Verdict
+TrivialCompilerEquivalence::classify(const std::string &scope,
+                                     const std::string &mutantHash,
+                                     MutationPoint *mutationPoint) {
+  std::lock_guard<std::mutex> lock(mutex);
+
+  auto original = originals.find(scope);
+  if (original != originals.end() && original->second == mutantHash) {
+    equivalent++;
+    return Verdict::Equivalent;
+  }
+
+  auto inserted = mutants.insert(std::make_pair(scope + ":" + mutantHash, mutationPoint));
+  if (!inserted.second && inserted.first->second != mutationPoint) {
+    duplicate++;
+    return Verdict::Duplicate;
+  }
+
+  return Verdict::Unique;
+}
+
+uint64_t TrivialCompilerEquivalence::equivalentCount() const {
+  return equivalent.load();
+}
+
+uint64_t TrivialCompilerEquivalence::duplicateCount() const {
+  return duplicate.load();
+}
@@ -30,6 +30,7 @@
 #include <llvm/Support/CommandLine.h>
 #include <llvm/Support/YAMLParser.h>
 
+#include <csignal>
 #include <string>
 
 using namespace mull;
@@ -42,6 +43,12 @@ static cl::opt<std::string> ConfigFile(
     llvm::cl::Positional
 );
 
+static cl::opt<bool> Resume(
+    "resume",
+    llvm::cl::desc("Resume the interrupted run recorded in the journal_file"),
+    llvm::cl::cat(MullOptionCategory)
+);
+
 int main(int argc, char *argv[]) {
   if (argc == 1) {
     // TODO: print friendlier help message here.
@@ -55,6 +62,7 @@ int main(int argc, char *argv[]) {
 
   ConfigParser Parser;
   auto config = Parser.loadConfig(ConfigFile.c_str());
+  config.setResume(Resume);
 
   std::vector <std::string> configErrors = config.validate();
   if (configErrors.size() > 0) {
@@ -72,6 +80,9 @@ int main(int argc, char *argv[]) {
   InitializeNativeTargetAsmPrinter();
   InitializeNativeTargetAsmParser();
 
+  /// Writing into a pipe of a dead fork server or sandbox must not kill Mull
+  signal(SIGPIPE, SIG_IGN);
+
   ModuleLoader Loader;
   Toolchain toolchain(config);
   Filter filter;
@@ -162,11 +173,16 @@ int main(int argc, char *argv[]) {
 
   Metrics metrics;
   Driver driver(config, Loader, *testFinder, *testRunner, toolchain, filter, mutationsFinder, metrics, *junkDetector);
+  for (auto &reporter: reporters) {
+    driver.addReporter(reporter.get());
+  }
 
   metrics.beginRun();
   auto result = driver.Run();
   metrics.endRun();
 
+  toolchain.cache().printStatistics();
+
   for (auto &reporter: reporters) {
     reporter->reportResults(*result, config, metrics);
   }
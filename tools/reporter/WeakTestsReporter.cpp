@@ -49,6 +49,11 @@ public:
     : testId(std::move(testId)), testLocation(std::move(location)) {}
 
   void addMutant(Mutant mutant) {
+    /// Equivalent and duplicate mutants were never run
+    if (mutant.status == mull::ExecutionStatus::Equivalent ||
+        mutant.status == mull::ExecutionStatus::Duplicate) {
+      return;
+    }
     if (mutant.status == mull::ExecutionStatus::Passed) {
       survivedMutants.push_back(mutant);
     } else {
@@ -104,7 +109,7 @@ static std::set<std::string> fetchKilledMutants(const std::string &reportPath) {
   const char *query = R"query(
   select mutation_point_id from execution_result
   where
-  mutation_point_id <> "" and status <> 2
+  mutation_point_id <> "" and status not in (2, 8, 9)
   group by mutation_point_id;
 )query";
 
@@ -0,0 +1,88 @@
+#include "Parallelization/BoundedQueue.h"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace mull;
+
+TEST(BoundedQueue, popsInPushOrder) {
+  BoundedQueue<int> queue(4);
+  std::vector<int> popped;
+
+  std::thread consumer([&]() {
+    int item = 0;
+    while (queue.pop(item)) {
+      popped.push_back(item);
+    }
+  });
+
+  for (int i = 0; i < 100; i++) {
+    ASSERT_TRUE(queue.push(i));
+  }
+  queue.close();
+  consumer.join();
+
+  ASSERT_EQ(100U, popped.size());
+  for (int i = 0; i < 100; i++) {
+    ASSERT_EQ(i, popped[i]);
+  }
+}
+
+TEST(BoundedQueue, handsEveryItemToExactlyOneConsumer) {
+  const int producersCount = 3;
+  const int consumersCount = 4;
+  const int itemsPerProducer = 500;
+
+  BoundedQueue<int> queue(2);
+  std::atomic<int> runningProducers(producersCount);
+  std::mutex poppedMutex;
+  std::vector<int> popped;
+
+  std::vector<std::thread> threads;
+  for (int p = 0; p < producersCount; p++) {
+    threads.emplace_back([&, p]() {
+      for (int i = 0; i < itemsPerProducer; i++) {
+        queue.push(p * itemsPerProducer + i);
+      }
+      if (--runningProducers == 0) {
+        queue.close();
+      }
+    });
+  }
+  for (int c = 0; c < consumersCount; c++) {
+    threads.emplace_back([&]() {
+      int item = 0;
+      while (queue.pop(item)) {
+        std::lock_guard<std::mutex> lock(poppedMutex);
+        popped.push_back(item);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  std::sort(popped.begin(), popped.end());
+  ASSERT_EQ(size_t(producersCount * itemsPerProducer), popped.size());
+  for (int i = 0; i < producersCount * itemsPerProducer; i++) {
+    ASSERT_EQ(i, popped[i]);
+  }
+}
+
+TEST(BoundedQueue, rejectsItemsOnceClosed) {
+  BoundedQueue<int> queue(1);
+  ASSERT_TRUE(queue.push(1));
+  queue.close();
+
+  ASSERT_FALSE(queue.push(2));
+
+  int item = 0;
+  ASSERT_TRUE(queue.pop(item));
+  ASSERT_EQ(1, item);
+  ASSERT_FALSE(queue.pop(item));
+}
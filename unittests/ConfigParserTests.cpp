@@ -192,6 +192,85 @@ TEST_F(ConfigParserTestFixture, loadConfig_Fork_Unspecified) {
   ASSERT_EQ(true, config.forkEnabled());
 }
 
+TEST_F(ConfigParserTestFixture, loadConfig_ForkServer_Enabled) {
+  configWithYamlContent("fork_server: enabled\n");
+  ASSERT_EQ(true, config.forkServerEnabled());
+}
+
+TEST_F(ConfigParserTestFixture, loadConfig_ForkServer_EnabledWithoutFork) {
+  configWithYamlContent("fork: disabled\n"
+                        "fork_server: enabled\n");
+  ASSERT_EQ(false, config.forkServerEnabled());
+}
+
+TEST_F(ConfigParserTestFixture, loadConfig_ForkServer_Unspecified) {
+  configWithYamlContent("");
+  ASSERT_EQ(false, config.forkServerEnabled());
+}
+
+TEST_F(ConfigParserTestFixture, loadConfig_BatchedSandbox_Enabled) {
+  configWithYamlContent("batched_sandbox: enabled\n");
+  ASSERT_EQ(true, config.batchedSandboxEnabled());
+}
+
+TEST_F(ConfigParserTestFixture, loadConfig_BatchedSandbox_EnabledWithoutFork) {
+  configWithYamlContent("fork: disabled\n"
+                        "batched_sandbox: enabled\n");
+  ASSERT_EQ(false, config.batchedSandboxEnabled());
+}
+
+TEST_F(ConfigParserTestFixture, loadConfig_BatchedSandbox_Unspecified) {
+  configWithYamlContent("");
+  ASSERT_EQ(false, config.batchedSandboxEnabled());
+}
+
+TEST_F(ConfigParserTestFixture, loadConfig_IncrementalLinking_Enabled) {
+  configWithYamlContent("incremental_linking: true\n");
+  ASSERT_EQ(true, config.incrementalLinkingEnabled());
+}
+
+TEST_F(ConfigParserTestFixture, loadConfig_IncrementalLinking_EnabledWithoutFork) {
+  configWithYamlContent("fork: false\n"
+                        "incremental_linking: true\n");
+  ASSERT_EQ(false, config.incrementalLinkingEnabled());
+}
+
+TEST_F(ConfigParserTestFixture, loadConfig_IncrementalLinking_Unspecified) {
+  configWithYamlContent("");
+  ASSERT_EQ(false, config.incrementalLinkingEnabled());
+}
+
+TEST_F(ConfigParserTestFixture, loadConfig_MutantCompilation_Function) {
+  configWithYamlContent("mutant_compilation: function\n");
+  ASSERT_EQ(config.getMutantCompilation(), Config::MutantCompilation::Function);
+}
+
+TEST_F(ConfigParserTestFixture, loadConfig_MutantCompilation_Schemata) {
+  configWithYamlContent("mutant_compilation: schemata\n");
+  ASSERT_EQ(config.getMutantCompilation(), Config::MutantCompilation::Schemata);
+}
+
+TEST_F(ConfigParserTestFixture, loadConfig_MutantCompilation_Unspecified) {
+  configWithYamlContent("");
+  ASSERT_EQ(config.getMutantCompilation(), Config::MutantCompilation::Module);
+}
+
+TEST_F(ConfigParserTestFixture, loadConfig_TrivialCompilerEquivalence_Enabled) {
+  configWithYamlContent("trivial_compiler_equivalence: enabled\n");
+  ASSERT_EQ(true, config.trivialCompilerEquivalenceEnabled());
+}
+
+TEST_F(ConfigParserTestFixture, loadConfig_TrivialCompilerEquivalence_EnabledWithSchemata) {
+  configWithYamlContent("mutant_compilation: schemata\n"
+                        "trivial_compiler_equivalence: enabled\n");
+  ASSERT_EQ(false, config.trivialCompilerEquivalenceEnabled());
+}
+
+TEST_F(ConfigParserTestFixture, loadConfig_TrivialCompilerEquivalence_Unspecified) {
+  configWithYamlContent("");
+  ASSERT_EQ(false, config.trivialCompilerEquivalenceEnabled());
+}
+
 TEST_F(ConfigParserTestFixture, loadConfig_Timeout_Unspecified) {
   configWithYamlContent("");
   ASSERT_EQ(MullDefaultTimeoutMilliseconds, config.getTimeout());
@@ -202,6 +281,19 @@ TEST_F(ConfigParserTestFixture, loadConfig_Timeout_SpecificValue) {
   ASSERT_EQ(15, config.getTimeout());
 }
 
+TEST_F(ConfigParserTestFixture, loadConfig_MutantTimeout_Unspecified) {
+  configWithYamlContent("");
+  ASSERT_EQ(10, config.getMutantTimeoutMultiplier());
+  ASSERT_EQ(30, config.getMutantTimeoutFloor());
+}
+
+TEST_F(ConfigParserTestFixture, loadConfig_MutantTimeout_SpecificValue) {
+  configWithYamlContent("mutant_timeout_multiplier: 4\n"
+                        "mutant_timeout_floor: 100\n");
+  ASSERT_EQ(4, config.getMutantTimeoutMultiplier());
+  ASSERT_EQ(100, config.getMutantTimeoutFloor());
+}
+
 TEST_F(ConfigParserTestFixture, loadConfig_DryRun_Unspecified) {
   configWithYamlContent("");
   ASSERT_FALSE(config.dryRunModeEnabled());
@@ -262,6 +354,16 @@ TEST_F(ConfigParserTestFixture, loadConfig_Diagnostics_All) {
   ASSERT_EQ(config.getDiagnostics(), Config::Diagnostics::All);
 }
 
+TEST_F(ConfigParserTestFixture, loadConfig_ReportOutput_Unspecified) {
+  configWithYamlContent("");
+  ASSERT_EQ(config.getReportOutput(), Config::ReportOutput::All);
+}
+
+TEST_F(ConfigParserTestFixture, loadConfig_ReportOutput_Killed) {
+  configWithYamlContent("report_output: killed\n");
+  ASSERT_EQ(config.getReportOutput(), Config::ReportOutput::Killed);
+}
+
 TEST_F(ConfigParserTestFixture, loadConfig_Diagnostics_None) {
   configWithYamlContent("diagnostics: none\n");
   ASSERT_EQ(config.getDiagnostics(), Config::Diagnostics::None);
@@ -327,6 +429,16 @@ TEST_F(ConfigParserTestFixture, loadConfig_MaxDistance_SpecificValue) {
   ASSERT_EQ(3, config.getMaxDistance());
 }
 
+TEST_F(ConfigParserTestFixture, loadConfig_MaxOutputSize_Unspecified) {
+  configWithYamlContent("");
+  ASSERT_EQ(0, config.getMaxOutputSize());
+}
+
+TEST_F(ConfigParserTestFixture, loadConfig_MaxOutputSize_SpecificValue) {
+  configWithYamlContent("max_output_size: 1024\n");
+  ASSERT_EQ(1024, config.getMaxOutputSize());
+}
+
 TEST_F(ConfigParserTestFixture, loadConfig_CacheDirectory_Unspecified) {
   configWithYamlContent("");
   ASSERT_EQ("/tmp/mull_cache", config.getCacheDirectory());
@@ -337,6 +449,39 @@ TEST_F(ConfigParserTestFixture, loadConfig_CacheDirectory_SpecificValue) {
   ASSERT_EQ("/var/tmp", config.getCacheDirectory());
 }
 
+TEST_F(ConfigParserTestFixture, loadConfig_CacheSizeLimit_Unspecified) {
+  configWithYamlContent("");
+  ASSERT_EQ(0, config.getCacheSizeLimit());
+}
+
+TEST_F(ConfigParserTestFixture, loadConfig_CacheSizeLimit_SpecificValue) {
+  configWithYamlContent("cache_size_limit: 512\n");
+  ASSERT_EQ(512, config.getCacheSizeLimit());
+}
+
+TEST_F(ConfigParserTestFixture, loadConfig_HistoryFile_Unspecified) {
+  configWithYamlContent("");
+  ASSERT_FALSE(config.historyEnabled());
+}
+
+TEST_F(ConfigParserTestFixture, loadConfig_HistoryFile_SpecificValue) {
+  configWithYamlContent("history_file: /var/tmp/mull_history.sqlite\n");
+  ASSERT_TRUE(config.historyEnabled());
+  ASSERT_EQ("/var/tmp/mull_history.sqlite", config.getHistoryFile());
+}
+
+TEST_F(ConfigParserTestFixture, loadConfig_JournalFile_Unspecified) {
+  configWithYamlContent("");
+  ASSERT_FALSE(config.journalEnabled());
+  ASSERT_FALSE(config.resumeEnabled());
+}
+
+TEST_F(ConfigParserTestFixture, loadConfig_JournalFile_SpecificValue) {
+  configWithYamlContent("journal_file: /var/tmp/mull_journal\n");
+  ASSERT_TRUE(config.journalEnabled());
+  ASSERT_EQ("/var/tmp/mull_journal", config.getJournalFile());
+}
+
 TEST_F(ConfigParserTestFixture, loadConfig_Mutators_Unspecified) {
   const char *configYAML = "";
   configWithYamlContent(configYAML);
@@ -454,6 +599,8 @@ reporters:
 
   ASSERT_EQ(availableThreads, parallelization.workers);
   ASSERT_EQ(availableThreads, parallelization.mutantExecutionWorkers);
+  ASSERT_EQ(availableThreads, parallelization.mutantCompilationWorkers);
+  ASSERT_EQ(1, parallelization.mutantTestWorkers);
   ASSERT_EQ(availableThreads, parallelization.testExecutionWorkers);
 }
 
@@ -469,6 +616,8 @@ parallelization:
 
   ASSERT_EQ(availableThreads, parallelization.workers);
   ASSERT_EQ(availableThreads, parallelization.mutantExecutionWorkers);
+  ASSERT_EQ(availableThreads, parallelization.mutantCompilationWorkers);
+  ASSERT_EQ(1, parallelization.mutantTestWorkers);
   ASSERT_EQ(availableThreads, parallelization.testExecutionWorkers);
 }
 
@@ -485,6 +634,8 @@ parallelization:
 
   ASSERT_EQ(availableThreads, parallelization.workers);
   ASSERT_EQ(availableThreads, parallelization.mutantExecutionWorkers);
+  ASSERT_EQ(availableThreads, parallelization.mutantCompilationWorkers);
+  ASSERT_EQ(1, parallelization.mutantTestWorkers);
   ASSERT_EQ(14, parallelization.testExecutionWorkers);
 }
 
@@ -494,6 +645,8 @@ parallelization:
   workers: 33
   test_execution_workers: 14
   mutant_execution_workers: 12
+  mutant_compilation_workers: 5
+  mutant_test_workers: 3
   )YAML";
   configWithYamlContent(configYAML);
 
@@ -501,6 +654,8 @@ parallelization:
 
   ASSERT_EQ(33, parallelization.workers);
   ASSERT_EQ(12, parallelization.mutantExecutionWorkers);
+  ASSERT_EQ(5, parallelization.mutantCompilationWorkers);
+  ASSERT_EQ(3, parallelization.mutantTestWorkers);
   ASSERT_EQ(14, parallelization.testExecutionWorkers);
 }
 
@@ -1,7 +1,6 @@
 #include "gtest/gtest.h"
 
 #include <llvm/IR/Function.h>
-#include <stack>
 
 #include "Instrumentation/DynamicCallTree.h"
 #include "Testee.h"
@@ -158,20 +157,23 @@ TEST(DynamicCallTree, enter_leave_function) {
   ///   F1 -> F4 -> F5
 
   uint32_t mapping[6] = { 0 };
-  std::stack<uint32_t> stack;
-
-  DynamicCallTree::enterFunction(1, mapping, stack);
-    DynamicCallTree::enterFunction(2, mapping, stack);
-      DynamicCallTree::enterFunction(3, mapping, stack);
-      DynamicCallTree::leaveFunction(3, mapping, stack);
-      DynamicCallTree::enterFunction(4, mapping, stack);
-      DynamicCallTree::leaveFunction(4, mapping, stack);
-    DynamicCallTree::leaveFunction(2, mapping, stack);
-    DynamicCallTree::enterFunction(4, mapping, stack);
-      DynamicCallTree::enterFunction(5, mapping, stack);
-      DynamicCallTree::leaveFunction(5, mapping, stack);
-    DynamicCallTree::leaveFunction(4, mapping, stack);
-  DynamicCallTree::leaveFunction(1, mapping, stack);
+  std::vector<uint32_t> callstack(InstrumentationInfo::MaxCallstackDepth);
+  InstrumentationInfo info;
+  info.callTreeMapping = mapping;
+  info.callstack = callstack.data();
+
+  DynamicCallTree::enterFunction(1, info);
+    DynamicCallTree::enterFunction(2, info);
+      DynamicCallTree::enterFunction(3, info);
+      DynamicCallTree::leaveFunction(3, info);
+      DynamicCallTree::enterFunction(4, info);
+      DynamicCallTree::leaveFunction(4, info);
+    DynamicCallTree::leaveFunction(2, info);
+    DynamicCallTree::enterFunction(4, info);
+      DynamicCallTree::enterFunction(5, info);
+      DynamicCallTree::leaveFunction(5, info);
+    DynamicCallTree::leaveFunction(4, info);
+  DynamicCallTree::leaveFunction(1, info);
 
   ASSERT_EQ(mapping[0], 0UL);
   ASSERT_EQ(mapping[1], 1UL);
@@ -180,7 +182,7 @@ TEST(DynamicCallTree, enter_leave_function) {
   ASSERT_EQ(mapping[4], 2UL);
   ASSERT_EQ(mapping[5], 4UL);
 
-  ASSERT_TRUE(stack.empty());
+  ASSERT_EQ(info.callstackDepth, 0U);
 }
 
 TEST(DynamicCallTree, enter_leave_function_recursion) {
@@ -223,22 +225,25 @@ TEST(DynamicCallTree, enter_leave_function_recursion) {
 
 #endif
   uint32_t mapping[5] = { 0 };
-  std::stack<uint32_t> stack;
-
-  DynamicCallTree::enterFunction(1, mapping, stack);
-    DynamicCallTree::enterFunction(2, mapping, stack);
-      DynamicCallTree::enterFunction(1, mapping, stack);
-        DynamicCallTree::enterFunction(3, mapping, stack);
-          DynamicCallTree::enterFunction(1, mapping, stack);
-            DynamicCallTree::enterFunction(4, mapping, stack);
-            DynamicCallTree::leaveFunction(4, mapping, stack);
-          DynamicCallTree::leaveFunction(1, mapping, stack);
-        DynamicCallTree::leaveFunction(3, mapping, stack);
-      DynamicCallTree::leaveFunction(1, mapping, stack);
-    DynamicCallTree::leaveFunction(2, mapping, stack);
-    DynamicCallTree::enterFunction(4, mapping, stack);
-    DynamicCallTree::leaveFunction(4, mapping, stack);
-  DynamicCallTree::leaveFunction(1, mapping, stack);
+  std::vector<uint32_t> callstack(InstrumentationInfo::MaxCallstackDepth);
+  InstrumentationInfo info;
+  info.callTreeMapping = mapping;
+  info.callstack = callstack.data();
+
+  DynamicCallTree::enterFunction(1, info);
+    DynamicCallTree::enterFunction(2, info);
+      DynamicCallTree::enterFunction(1, info);
+        DynamicCallTree::enterFunction(3, info);
+          DynamicCallTree::enterFunction(1, info);
+            DynamicCallTree::enterFunction(4, info);
+            DynamicCallTree::leaveFunction(4, info);
+          DynamicCallTree::leaveFunction(1, info);
+        DynamicCallTree::leaveFunction(3, info);
+      DynamicCallTree::leaveFunction(1, info);
+    DynamicCallTree::leaveFunction(2, info);
+    DynamicCallTree::enterFunction(4, info);
+    DynamicCallTree::leaveFunction(4, info);
+  DynamicCallTree::leaveFunction(1, info);
 
   ASSERT_EQ(mapping[0], 0UL);
   ASSERT_EQ(mapping[1], 1UL);
@@ -246,7 +251,41 @@ TEST(DynamicCallTree, enter_leave_function_recursion) {
   ASSERT_EQ(mapping[3], 1UL);
   ASSERT_EQ(mapping[4], 1UL);
 
-  ASSERT_TRUE(stack.empty());
+  ASSERT_EQ(info.callstackDepth, 0U);
+}
+
+TEST(DynamicCallTree, enter_leave_function_deep_recursion) {
+  ///
+  /// Call trace
+  ///
+  ///   F1 -> F2 -> F2 -> ... -> F2 -> F3
+  ///
+  /// deeper than the call stack can hold
+
+  uint32_t mapping[4] = { 0 };
+  std::vector<uint32_t> callstack(InstrumentationInfo::MaxCallstackDepth);
+  InstrumentationInfo info;
+  info.callTreeMapping = mapping;
+  info.callstack = callstack.data();
+
+  const uint32_t depth = InstrumentationInfo::MaxCallstackDepth + 10;
+
+  DynamicCallTree::enterFunction(1, info);
+  for (uint32_t i = 0; i < depth; i++) {
+    DynamicCallTree::enterFunction(2, info);
+  }
+  DynamicCallTree::enterFunction(3, info);
+  DynamicCallTree::leaveFunction(3, info);
+  for (uint32_t i = 0; i < depth; i++) {
+    DynamicCallTree::leaveFunction(2, info);
+  }
+  DynamicCallTree::leaveFunction(1, info);
+
+  ASSERT_EQ(mapping[1], 1UL);
+  ASSERT_EQ(mapping[2], 1UL);
+  ASSERT_EQ(mapping[3], 2UL);
+
+  ASSERT_EQ(info.callstackDepth, 0U);
 }
 
 TEST(DynamicCallTree, test_subtrees) {
@@ -3,6 +3,15 @@
 
 #include "gtest/gtest.h"
 
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <functional>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
 using namespace mull;
 
 /// The timeout should be long enough to overlive the unit test suite running
@@ -29,6 +38,40 @@ TEST(ForkProcessSandbox, captureOutputFromChildProcess) {
   ASSERT_EQ(strcmp(result.stderrOutput.c_str(), stderrMessage), 0);
 }
 
+TEST(ForkProcessSandbox, captureOutputLargerThanPipeBuffer) {
+  const std::string message(1024 * 1024, 'x');
+
+  ForkProcessSandbox sandbox;
+
+  ExecutionResult result = sandbox.run([&]() {
+    fwrite(message.data(), 1, message.size(), stdout);
+    fwrite(message.data(), 1, message.size(), stderr);
+
+    return ExecutionStatus::Passed;
+  }, Timeout);
+
+  ASSERT_EQ(result.status, Passed);
+  ASSERT_EQ(result.stdoutOutput, message);
+  ASSERT_EQ(result.stderrOutput, message);
+}
+
+TEST(ForkProcessSandbox, truncateOutputToMaxOutputSize) {
+  const std::string message(1024 * 1024, 'x');
+
+  ForkProcessSandbox sandbox(16);
+
+  ExecutionResult result = sandbox.run([&]() {
+    fwrite(message.data(), 1, message.size(), stdout);
+    fprintf(stderr, "short");
+
+    return ExecutionStatus::Passed;
+  }, Timeout);
+
+  ASSERT_EQ(result.status, Passed);
+  ASSERT_EQ(result.stdoutOutput, std::string(16, 'x'));
+  ASSERT_EQ(result.stderrOutput, "short");
+}
+
 #pragma mark - Possible execution scenarios
 
 TEST(ForkProcessSandbox, statusPassedIfExitingWithZeroAndResultWasSet) {
@@ -84,3 +127,260 @@ TEST(ForkProcessSandbox, statusCrashed) {
 
   ASSERT_EQ(result.status, Crashed);
 }
+
+TEST(ForkProcessSandbox, statusTimeout_IfAlarmIsBlocked) {
+  ForkProcessSandbox sandbox;
+
+  ExecutionResult result = sandbox.run([&]() {
+    signal(SIGALRM, SIG_IGN);
+    sleep(3);
+    return ExecutionStatus::Passed;
+  }, 100);
+
+  ASSERT_EQ(result.status, Timedout);
+}
+
+TEST(ForkProcessSandbox, killsProcessesStartedByTest) {
+  ForkProcessSandbox sandbox;
+
+  int pipeDescriptors[2];
+  ASSERT_EQ(0, pipe(pipeDescriptors));
+
+  ExecutionResult result = sandbox.run([&]() {
+    pid_t grandchild = fork();
+    if (grandchild == 0) {
+      close(pipeDescriptors[0]);
+      sleep(30);
+      _exit(0);
+    }
+    close(pipeDescriptors[1]);
+    sleep(30);
+    return ExecutionStatus::Passed;
+  }, 100);
+  close(pipeDescriptors[1]);
+
+  ASSERT_EQ(result.status, Timedout);
+
+  /// The write end is closed once every process holding it is gone
+  char byte = 0;
+  ASSERT_EQ(0, read(pipeDescriptors[0], &byte, 1));
+  close(pipeDescriptors[0]);
+}
+
+TEST(ForkProcessSandbox, measuresCPUTime) {
+  ForkProcessSandbox sandbox;
+
+  ExecutionResult result = sandbox.run([&]() {
+    volatile unsigned long long counter = 0;
+    for (int i = 0; i < 20000000; i++) {
+      counter += i;
+    }
+    return ExecutionStatus::Passed;
+  }, Timeout);
+
+  ASSERT_EQ(result.status, Passed);
+  ASSERT_GT(result.cpuTime, 0);
+}
+
+TEST(ForkProcessSandbox, statusFailFast_IfCancelled) {
+  ForkProcessSandbox sandbox;
+  std::atomic<bool> cancelled(false);
+
+  std::thread canceller([&]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    cancelled = true;
+  });
+
+  ExecutionResult result = sandbox.run([&]() {
+    sleep(3);
+    return ExecutionStatus::Passed;
+  }, Timeout, &cancelled);
+  canceller.join();
+
+  ASSERT_EQ(result.status, FailFast);
+}
+
+TEST(ForkProcessSandbox, doesNotStartIfCancelled) {
+  ForkProcessSandbox sandbox;
+  std::atomic<bool> cancelled(true);
+
+  ExecutionResult result = sandbox.run([&]() {
+    return ExecutionStatus::Passed;
+  }, Timeout, &cancelled);
+
+  ASSERT_EQ(result.status, FailFast);
+  ASSERT_EQ(0, result.forkTime);
+}
+
+TEST(ForkProcessSandbox, runBatch_reportsEachTest) {
+  ForkProcessSandbox sandbox;
+
+  std::vector<std::function<ExecutionStatus ()>> functions;
+  functions.push_back([]() {
+    printf("first");
+    return ExecutionStatus::Passed;
+  });
+  functions.push_back([]() {
+    fprintf(stderr, "second");
+    return ExecutionStatus::Failed;
+  });
+  functions.push_back([]() {
+    printf("third");
+    return ExecutionStatus::Passed;
+  });
+  std::vector<long long> timeouts(functions.size(), Timeout);
+
+  auto results = sandbox.runBatch(functions, timeouts, false);
+
+  ASSERT_EQ(3U, results.size());
+  ASSERT_EQ(Passed, results[0].status);
+  ASSERT_EQ("first", results[0].stdoutOutput);
+  ASSERT_EQ(Failed, results[1].status);
+  ASSERT_EQ("", results[1].stdoutOutput);
+  ASSERT_EQ("second", results[1].stderrOutput);
+  ASSERT_EQ(Passed, results[2].status);
+  ASSERT_EQ("third", results[2].stdoutOutput);
+  ASSERT_EQ(0, results[2].forkTime);
+}
+
+TEST(ForkProcessSandbox, runBatch_capturesOutputLargerThanPipeBuffer) {
+  const std::string message(1024 * 1024, 'x');
+
+  ForkProcessSandbox sandbox;
+
+  std::vector<std::function<ExecutionStatus ()>> functions;
+  functions.push_back([&]() {
+    fwrite(message.data(), 1, message.size(), stdout);
+    fwrite(message.data(), 1, message.size(), stderr);
+    return ExecutionStatus::Passed;
+  });
+  functions.push_back([]() {
+    printf("second");
+    return ExecutionStatus::Passed;
+  });
+  std::vector<long long> timeouts(functions.size(), Timeout);
+
+  auto results = sandbox.runBatch(functions, timeouts, false);
+
+  ASSERT_EQ(Passed, results[0].status);
+  ASSERT_EQ(message, results[0].stdoutOutput);
+  ASSERT_EQ(message, results[0].stderrOutput);
+  ASSERT_EQ(Passed, results[1].status);
+  ASSERT_EQ("second", results[1].stdoutOutput);
+}
+
+TEST(ForkProcessSandbox, runBatch_truncatesOutputOfEachTest) {
+  const std::string message(1024 * 1024, 'x');
+
+  ForkProcessSandbox sandbox(16);
+
+  std::vector<std::function<ExecutionStatus ()>> functions;
+  functions.push_back([&]() {
+    fwrite(message.data(), 1, message.size(), stdout);
+    return ExecutionStatus::Passed;
+  });
+  functions.push_back([]() {
+    printf("second");
+    return ExecutionStatus::Passed;
+  });
+  std::vector<long long> timeouts(functions.size(), Timeout);
+
+  auto results = sandbox.runBatch(functions, timeouts, false);
+
+  ASSERT_EQ(std::string(16, 'x'), results[0].stdoutOutput);
+  ASSERT_EQ("second", results[1].stdoutOutput);
+}
+
+TEST(ForkProcessSandbox, runBatch_stopsOnFailure) {
+  ForkProcessSandbox sandbox;
+
+  std::vector<std::function<ExecutionStatus ()>> functions;
+  functions.push_back([]() { return ExecutionStatus::Failed; });
+  functions.push_back([]() { return ExecutionStatus::Passed; });
+  std::vector<long long> timeouts(functions.size(), Timeout);
+
+  auto results = sandbox.runBatch(functions, timeouts, true);
+
+  ASSERT_EQ(Failed, results[0].status);
+  ASSERT_EQ(FailFast, results[1].status);
+}
+
+TEST(ForkProcessSandbox, runBatch_isolatesCrashingTest) {
+  ForkProcessSandbox sandbox;
+
+  std::vector<std::function<ExecutionStatus ()>> functions;
+  functions.push_back([]() { return ExecutionStatus::Passed; });
+  functions.push_back([]() {
+    abort();
+    return ExecutionStatus::Passed;
+  });
+  functions.push_back([]() { return ExecutionStatus::Passed; });
+  std::vector<long long> timeouts(functions.size(), Timeout);
+
+  auto results = sandbox.runBatch(functions, timeouts, false);
+
+  ASSERT_EQ(Passed, results[0].status);
+  ASSERT_EQ(Crashed, results[1].status);
+  ASSERT_EQ(Passed, results[2].status);
+}
+
+TEST(ForkProcessSandbox, runBatch_timesOutEachTestSeparately) {
+  ForkProcessSandbox sandbox;
+
+  std::vector<std::function<ExecutionStatus ()>> functions;
+  functions.push_back([]() {
+    usleep(60 * 1000);
+    return ExecutionStatus::Passed;
+  });
+  functions.push_back([]() {
+    sleep(3);
+    return ExecutionStatus::Passed;
+  });
+  functions.push_back([]() { return ExecutionStatus::Passed; });
+  std::vector<long long> timeouts(functions.size(), 100);
+
+  auto results = sandbox.runBatch(functions, timeouts, false);
+
+  ASSERT_EQ(Passed, results[0].status);
+  ASSERT_EQ(Timedout, results[1].status);
+  ASSERT_EQ(Passed, results[2].status);
+}
+
+TEST(ForkProcessSandbox, runBatch_runsFinishedTestsOnce) {
+  ForkProcessSandbox sandbox;
+
+  /// Every run of a test leaves a byte in the pipe
+  int runs[2];
+  ASSERT_EQ(0, pipe(runs));
+
+  const size_t NumberOfTests = 10;
+  const size_t NumberOfBatches = 20;
+
+  std::vector<std::function<ExecutionStatus ()>> functions;
+  for (size_t i = 0; i < NumberOfTests; i++) {
+    functions.push_back([&runs]() {
+      char run = 'r';
+      return write(runs[1], &run, 1) == 1 ? ExecutionStatus::Passed
+                                          : ExecutionStatus::Failed;
+    });
+  }
+  std::vector<long long> timeouts(functions.size(), Timeout);
+
+  for (size_t batch = 0; batch < NumberOfBatches; batch++) {
+    auto results = sandbox.runBatch(functions, timeouts, false);
+    for (auto &result : results) {
+      ASSERT_EQ(Passed, result.status);
+    }
+  }
+  close(runs[1]);
+
+  size_t totalRuns = 0;
+  char buffer[256];
+  ssize_t bytesRead = 0;
+  while ((bytesRead = read(runs[0], buffer, sizeof(buffer))) > 0) {
+    totalRuns += size_t(bytesRead);
+  }
+  close(runs[0]);
+
+  ASSERT_EQ(NumberOfTests * NumberOfBatches, totalRuns);
+}
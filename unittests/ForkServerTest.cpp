@@ -0,0 +1,164 @@
+#include "ForkServer.h"
+#include "ForkProcessSandbox.h"
+#include "ExecutionResult.h"
+
+#include "gtest/gtest.h"
+
+#include <string>
+#include <unistd.h>
+
+using namespace mull;
+
+static const long long Timeout = 1100;
+
+TEST(ForkServer, runsHandlersInTheServerProcess) {
+  const pid_t workerPID = getpid();
+  std::string loadedPayload;
+
+  ForkServer server([&](uint64_t key, llvm::StringRef payload) {
+    loadedPayload = payload.str();
+    return key == 42 && getpid() != workerPID;
+  }, [&](uint64_t key, long long timeout) {
+    ExecutionResult result;
+    result.status = getpid() != workerPID ? Passed : Failed;
+    result.exitStatus = static_cast<int>(key);
+    result.runningTime = timeout;
+    result.stdoutOutput = loadedPayload;
+    result.stderrOutput = "stderr";
+    return result;
+  });
+
+  ASSERT_FALSE(server.isRunning());
+  ASSERT_TRUE(server.start());
+  ASSERT_TRUE(server.load(42, "payload"));
+  ASSERT_TRUE(server.isRunning());
+
+  /// The state of the server is not shared with the worker
+  ASSERT_TRUE(loadedPayload.empty());
+
+  ExecutionResult result;
+  ASSERT_TRUE(server.run(7, Timeout, result));
+  ASSERT_EQ(result.status, Passed);
+  ASSERT_EQ(result.exitStatus, 7);
+  ASSERT_EQ(result.runningTime, Timeout);
+  ASSERT_EQ(result.stdoutOutput, "payload");
+  ASSERT_EQ(result.stderrOutput, "stderr");
+
+  server.stop();
+  ASSERT_FALSE(server.isRunning());
+}
+
+TEST(ForkServer, runsTestsInSandboxOfTheServer) {
+  ForkProcessSandbox sandbox;
+  ForkServer server([&](uint64_t key, llvm::StringRef payload) {
+    return true;
+  }, [&](uint64_t key, long long timeout) {
+    return sandbox.run([&]() {
+      if (key == 1) {
+        return ExecutionStatus::Passed;
+      }
+      abort();
+      return ExecutionStatus::Passed;
+    }, timeout);
+  });
+
+  ASSERT_TRUE(server.start());
+  ASSERT_TRUE(server.load(0, ""));
+
+  ExecutionResult result;
+  ASSERT_TRUE(server.run(1, Timeout, result));
+  ASSERT_EQ(result.status, Passed);
+  ASSERT_TRUE(server.run(2, Timeout, result));
+  ASSERT_EQ(result.status, Crashed);
+
+  /// A crashing test does not take the server down
+  ASSERT_TRUE(server.isRunning());
+  ASSERT_TRUE(server.run(1, Timeout, result));
+  ASSERT_EQ(result.status, Passed);
+}
+
+TEST(ForkServer, shutsDownWhenLoadFails) {
+  ForkServer server([&](uint64_t key, llvm::StringRef payload) {
+    return false;
+  }, [&](uint64_t key, long long timeout) {
+    return ExecutionResult();
+  });
+
+  ASSERT_TRUE(server.start());
+  ASSERT_FALSE(server.load(0, ""));
+  ASSERT_FALSE(server.isRunning());
+
+  ExecutionResult result;
+  ASSERT_FALSE(server.run(0, Timeout, result));
+}
+
+TEST(ForkServer, doesNotStartOnRequests) {
+  ForkServer server([&](uint64_t key, llvm::StringRef payload) {
+    return true;
+  }, [&](uint64_t key, long long timeout) {
+    return ExecutionResult();
+  });
+
+  ExecutionResult result;
+  ASSERT_FALSE(server.load(0, ""));
+  ASSERT_FALSE(server.run(0, Timeout, result));
+  ASSERT_FALSE(server.isRunning());
+}
+
+TEST(ForkServer, isUnavailableWhenServerDies) {
+  ForkServer server([&](uint64_t key, llvm::StringRef payload) {
+    return true;
+  }, [&](uint64_t key, long long timeout) {
+    _exit(1);
+    return ExecutionResult();
+  });
+
+  ASSERT_TRUE(server.start());
+  ASSERT_TRUE(server.load(0, ""));
+
+  ExecutionResult result;
+  ASSERT_FALSE(server.run(0, Timeout, result));
+  ASSERT_FALSE(server.isRunning());
+}
+
+TEST(ForkServer, killsServerStuckInLoad) {
+  const long long loadTimeout = 200;
+  ForkServer server([&](uint64_t key, llvm::StringRef payload) {
+    if (key == 1) {
+      sleep(10);
+    }
+    return true;
+  }, [&](uint64_t key, long long timeout) {
+    return ExecutionResult();
+  }, loadTimeout);
+
+  ASSERT_TRUE(server.start());
+
+  /// The payload does not fit into the pipe, so the worker would block
+  /// on writing it as well as on reading the response
+  std::string payload(1024 * 1024, 'x');
+  ASSERT_FALSE(server.load(1, payload));
+  ASSERT_FALSE(server.isRunning());
+
+  /// The server stays down until it is started again
+  ASSERT_FALSE(server.load(2, payload));
+  ASSERT_TRUE(server.start());
+  ASSERT_TRUE(server.load(2, payload));
+}
+
+TEST(ForkServer, killsServerStuckInRun) {
+  const long long runTimeoutMargin = 200;
+  ForkServer server([&](uint64_t key, llvm::StringRef payload) {
+    return true;
+  }, [&](uint64_t key, long long timeout) {
+    sleep(10);
+    return ExecutionResult();
+  }, ForkServer::DefaultLoadTimeout, runTimeoutMargin);
+
+  ASSERT_TRUE(server.start());
+  ASSERT_TRUE(server.load(0, ""));
+
+  ExecutionResult result;
+  ASSERT_FALSE(server.run(0, 100, result));
+  ASSERT_FALSE(server.isRunning());
+}
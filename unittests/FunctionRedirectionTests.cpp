@@ -0,0 +1,268 @@
+#include "Toolchain/FunctionRedirection.h"
+#include "Toolchain/Compiler.h"
+#include "Toolchain/JITEngine.h"
+#include "Toolchain/Mangler.h"
+#include "Toolchain/Resolvers/NativeResolver.h"
+#include "Context.h"
+#include "Config.h"
+#include "Filter.h"
+#include "MutationPoint.h"
+#include "MutationsFinder.h"
+#include "Mutators/MathSubMutator.h"
+#include "Testee.h"
+#include "TestModuleFactory.h"
+
+#include <llvm/AsmParser/Parser.h>
+#include <llvm/ExecutionEngine/ExecutionEngine.h>
+#include <llvm/ExecutionEngine/SectionMemoryManager.h>
+#include <llvm/IR/InstIterator.h>
+#include <llvm/IR/Instructions.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/IR/Verifier.h>
+#include <llvm/Support/SourceMgr.h>
+#include <llvm/Support/TargetSelect.h>
+
+#include "gtest/gtest.h"
+
+using namespace llvm;
+using namespace mull;
+
+static TestModuleFactory TestModuleFactory;
+
+static void replaceSubWithAdd(Function &function) {
+  for (auto &instruction : instructions(function)) {
+    auto binaryOperator = dyn_cast<BinaryOperator>(&instruction);
+    if (binaryOperator && binaryOperator->getOpcode() == Instruction::Sub) {
+      auto add = BinaryOperator::Create(Instruction::Add,
+                                        binaryOperator->getOperand(0),
+                                        binaryOperator->getOperand(1),
+                                        "", binaryOperator);
+      binaryOperator->replaceAllUsesWith(add);
+      binaryOperator->eraseFromParent();
+      return;
+    }
+  }
+}
+
+static void *symbolAddress(JITEngine &jit, mull::Mangler &mangler, const std::string &name) {
+  auto &symbol = jit.getSymbol(mangler.getNameWithPrefix(name));
+  auto address = llvm_compat::JITSymbolAddress(symbol);
+  return reinterpret_cast<void *>(static_cast<uintptr_t>(address));
+}
+
+TEST(FunctionRedirection, prepareModule) {
+  auto module = TestModuleFactory.create_SimpleTest_MathSub_Module();
+
+  LLVMContext context;
+  auto prepared = module->clone(context);
+  FunctionRedirection::prepareModule(*prepared->getModule(),
+                                     module->getUniqueIdentifier());
+
+  ASSERT_FALSE(verifyModule(*prepared->getModule(), &errs()));
+
+  Function *mathSub = prepared->getModule()->getFunction("math_sub");
+  ASSERT_NE(nullptr, mathSub);
+  ASSERT_EQ("mull_redirect_check", mathSub->getEntryBlock().getName());
+  ASSERT_NE(nullptr, prepared->getModule()->getNamedGlobal("math_sub.mull_redirect"));
+}
+
+TEST(FunctionRedirection, extractFunction) {
+  auto module = TestModuleFactory.create_SimpleTest_MathSub_Module();
+  Function *original = module->getModule()->getFunction("math_sub");
+  int functionIndex = MutationPointAddress::getFunctionIndex(original);
+
+  LLVMContext context;
+  auto extracted = module->clone(context);
+  FunctionRedirection::extractFunction(*extracted->getModule(),
+                                       module->getUniqueIdentifier(),
+                                       functionIndex);
+
+  ASSERT_FALSE(verifyModule(*extracted->getModule(), &errs()));
+
+  std::vector<std::string> definitions;
+  for (auto &function : extracted->getModule()->functions()) {
+    if (!function.isDeclaration()) {
+      definitions.push_back(function.getName().str());
+    }
+  }
+
+  ASSERT_EQ(1U, definitions.size());
+  ASSERT_EQ(FunctionRedirection::mutantName(*original, module->getUniqueIdentifier()),
+            definitions.front());
+}
+
+TEST(FunctionRedirection, redirectToMutant) {
+  InitializeNativeTarget();
+  InitializeNativeTargetAsmPrinter();
+  InitializeNativeTargetAsmParser();
+
+  std::unique_ptr<TargetMachine> targetMachine(
+                                  EngineBuilder().selectTarget(Triple(), "", "",
+                                  SmallVector<std::string, 1>()));
+  mull::Mangler mangler(targetMachine->createDataLayout());
+  Compiler compiler;
+
+  auto module = TestModuleFactory.create_SimpleTest_MathSub_Module();
+  Function *original = module->getModule()->getFunction("math_sub");
+  int functionIndex = MutationPointAddress::getFunctionIndex(original);
+  std::string moduleIdentifier = module->getUniqueIdentifier();
+
+  LLVMContext context;
+  auto prepared = module->clone(context);
+  FunctionRedirection::prepareModule(*prepared->getModule(), moduleIdentifier);
+  auto preparedObject = compiler.compileModule(prepared->getModule(), *targetMachine);
+
+  auto mutant = module->clone(context);
+  replaceSubWithAdd(*std::next(mutant->getModule()->begin(), functionIndex));
+  FunctionRedirection::extractFunction(*mutant->getModule(), moduleIdentifier,
+                                       functionIndex);
+  auto mutantObject = compiler.compileModule(mutant->getModule(), *targetMachine);
+
+  orc::LocalCXXRuntimeOverrides overrides([&](const char *name) {
+    return mangler.getNameWithPrefix(name);
+  });
+  NativeResolver resolver(overrides);
+  JITEngine jit;
+  std::vector<object::ObjectFile *> objects({ preparedObject.getBinary(),
+                                              mutantObject.getBinary() });
+  jit.addObjectFiles(objects, resolver, make_unique<SectionMemoryManager>());
+
+  auto mathSub = (int (*)(int, int))symbolAddress(jit, mangler, "math_sub");
+  ASSERT_NE(nullptr, mathSub);
+  ASSERT_EQ(-2, mathSub(2, 4));
+
+  auto redirect = (void **)symbolAddress(jit, mangler,
+    FunctionRedirection::redirectName(*original, moduleIdentifier));
+  void *mutatedFunction = symbolAddress(jit, mangler,
+    FunctionRedirection::mutantName(*original, moduleIdentifier));
+  ASSERT_NE(nullptr, redirect);
+  ASSERT_NE(nullptr, mutatedFunction);
+
+  *redirect = mutatedFunction;
+  ASSERT_EQ(6, mathSub(2, 4));
+
+  *redirect = nullptr;
+  ASSERT_EQ(-2, mathSub(2, 4));
+}
+
+/// Inline functions are emitted into every module that uses them
+TEST(FunctionRedirection, prepareModule_skipsLinkOnceFunctions) {
+  const char *firstSource = R"(
+    define linkonce_odr i32 @inline_sub(i32 %a, i32 %b) {
+    entry:
+      %result = sub i32 %a, %b
+      ret i32 %result
+    }
+    define i32 @first(i32 %a) {
+    entry:
+      %result = call i32 @inline_sub(i32 %a, i32 1)
+      ret i32 %result
+    }
+  )";
+
+  const char *secondSource = R"(
+    define linkonce_odr i32 @inline_sub(i32 %a, i32 %b) {
+    entry:
+      %result = sub i32 %a, %b
+      ret i32 %result
+    }
+    define i32 @second(i32 %a) {
+    entry:
+      %result = call i32 @inline_sub(i32 %a, i32 2)
+      ret i32 %result
+    }
+  )";
+
+  LLVMContext context;
+  SMDiagnostic error;
+  auto first = parseAssemblyString(firstSource, error, context);
+  auto second = parseAssemblyString(secondSource, error, context);
+  ASSERT_NE(nullptr, first.get());
+  ASSERT_NE(nullptr, second.get());
+
+  ASSERT_FALSE(FunctionRedirection::canRedirect(*first->getFunction("inline_sub")));
+  ASSERT_TRUE(FunctionRedirection::canRedirect(*first->getFunction("first")));
+
+  FunctionRedirection::prepareModule(*first, "first");
+  FunctionRedirection::prepareModule(*second, "second");
+  ASSERT_FALSE(verifyModule(*first, &errs()));
+  ASSERT_FALSE(verifyModule(*second, &errs()));
+
+  /// Neither module defines a redirect of its copy
+  ASSERT_EQ(nullptr, first->getNamedGlobal("inline_sub.mull_redirect"));
+  ASSERT_EQ(nullptr, second->getNamedGlobal("inline_sub.mull_redirect"));
+  ASSERT_EQ("entry", first->getFunction("inline_sub")->getEntryBlock().getName());
+  ASSERT_EQ("entry", second->getFunction("inline_sub")->getEntryBlock().getName());
+
+  ASSERT_NE(nullptr, first->getNamedGlobal("first.mull_redirect"));
+  ASSERT_NE(nullptr, second->getNamedGlobal("second.mull_redirect"));
+}
+
+TEST(FunctionRedirection, weaveMutants) {
+  InitializeNativeTarget();
+  InitializeNativeTargetAsmPrinter();
+  InitializeNativeTargetAsmParser();
+
+  std::unique_ptr<TargetMachine> targetMachine(
+                                  EngineBuilder().selectTarget(Triple(), "", "",
+                                  SmallVector<std::string, 1>()));
+  mull::Mangler mangler(targetMachine->createDataLayout());
+  Compiler compiler;
+
+  Context context;
+  context.addModule(TestModuleFactory.create_SimpleTest_MathSub_Module());
+
+  Config config;
+  config.normalizeParallelizationConfig();
+
+  std::vector<std::unique_ptr<Mutator>> mutators;
+  mutators.emplace_back(make_unique<MathSubMutator>());
+  MutationsFinder finder(std::move(mutators), config);
+
+  Function *testeeFunction = context.lookupDefinedFunction("math_sub");
+  std::vector<std::unique_ptr<Testee>> testees;
+  testees.emplace_back(make_unique<Testee>(testeeFunction, nullptr, 1));
+  auto mergedTestees = mergeTestees(testees);
+  Filter filter;
+
+  std::vector<MutationPoint *> mutationPoints =
+    finder.getMutationPoints(context, mergedTestees, filter);
+  ASSERT_EQ(1U, mutationPoints.size());
+
+  MullModule *module = mutationPoints.front()->getOriginalModule();
+  std::string moduleIdentifier = module->getUniqueIdentifier();
+
+  LLVMContext localContext;
+  auto woven = module->clone(localContext);
+  FunctionRedirection::weaveMutants(*woven->getModule(), moduleIdentifier,
+                                    mutationPoints);
+
+  ASSERT_FALSE(verifyModule(*woven->getModule(), &errs()));
+  Function *mathSub = woven->getModule()->getFunction("math_sub");
+  ASSERT_EQ("mull_schemata", mathSub->getEntryBlock().getName());
+
+  auto wovenObject = compiler.compileModule(woven->getModule(), *targetMachine);
+
+  orc::LocalCXXRuntimeOverrides overrides([&](const char *name) {
+    return mangler.getNameWithPrefix(name);
+  });
+  NativeResolver resolver(overrides);
+  JITEngine jit;
+  std::vector<object::ObjectFile *> objects({ wovenObject.getBinary() });
+  jit.addObjectFiles(objects, resolver, make_unique<SectionMemoryManager>());
+
+  auto function = (int (*)(int, int))symbolAddress(jit, mangler, "math_sub");
+  auto activeMutant = (int32_t *)symbolAddress(jit, mangler,
+    FunctionRedirection::activeMutantName(moduleIdentifier));
+  ASSERT_NE(nullptr, function);
+  ASSERT_NE(nullptr, activeMutant);
+
+  ASSERT_EQ(-2, function(2, 4));
+
+  *activeMutant = 1;
+  ASSERT_EQ(6, function(2, 4));
+
+  *activeMutant = 0;
+  ASSERT_EQ(-2, function(2, 4));
+}
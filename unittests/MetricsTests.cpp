@@ -0,0 +1,49 @@
+#include "Metrics/Metrics.h"
+
+#include "gtest/gtest.h"
+
+using namespace mull;
+
+TEST(DurationHistogram, bucketsByPowersOfTwo) {
+  DurationHistogram histogram;
+  for (uint64_t microseconds = 0; microseconds < 100; microseconds++) {
+    histogram.add(microseconds);
+  }
+  histogram.add(5000);
+
+  ASSERT_EQ(101U, histogram.count);
+  ASSERT_EQ(4950U + 5000U, histogram.total);
+  ASSERT_EQ(5000U, histogram.max);
+
+  /// 0-1, 2-3, 4-7, ..., 64-127
+  ASSERT_EQ(2U, histogram.buckets[0]);
+  ASSERT_EQ(2U, histogram.buckets[1]);
+  ASSERT_EQ(36U, histogram.buckets[6]);
+
+  ASSERT_EQ(63U, histogram.percentile(0.5));
+  ASSERT_EQ(127U, histogram.percentile(0.9));
+  ASSERT_EQ(5000U, histogram.percentile(1.0));
+}
+
+TEST(Metrics, mergesMutantCostsOfWorkers) {
+  MutantCosts first;
+  first.add(MutantPhase::Codegen, 100);
+  first.cacheMisses++;
+
+  MutantCosts second;
+  second.add(MutantPhase::Codegen, 300);
+  second.add(MutantPhase::Fork, 10);
+  second.cacheHits++;
+
+  Metrics metrics;
+  metrics.addMutantCosts(first);
+  metrics.addMutantCosts(second);
+
+  const MutantCosts &costs = metrics.mutantCosts();
+  ASSERT_EQ(2U, costs.phases[int(MutantPhase::Codegen)].count);
+  ASSERT_EQ(400U, costs.phases[int(MutantPhase::Codegen)].total);
+  ASSERT_EQ(1U, costs.phases[int(MutantPhase::Fork)].count);
+  ASSERT_EQ(0U, costs.phases[int(MutantPhase::Link)].count);
+  ASSERT_EQ(1U, costs.cacheHits);
+  ASSERT_EQ(1U, costs.cacheMisses);
+}
@@ -2,8 +2,12 @@
 #include "gtest/gtest.h"
 
 #include "ModuleLoader.h"
+#include "LLVMCompatibility.h"
 #include "TestModuleFactory.h"
 
+#include <llvm/Support/FileSystem.h>
+
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 
@@ -28,3 +32,60 @@ TEST(ModuleLoaderTest, loadModuleFromBitcodeListFile) {
 
   ASSERT_EQ(modules.size(), 1U);
 }
+
+TEST(ModuleLoaderTest, cloneFromMemory) {
+  llvm::LLVMContext context;
+  ModuleLoader loader;
+
+  SmallString<128> bitcodeFile;
+  ASSERT_FALSE(sys::fs::createTemporaryFile("mull-module", "bc", bitcodeFile));
+  ASSERT_FALSE(sys::fs::copy_file(testModuleFactory.testerModulePath_Bitcode(),
+                                  bitcodeFile));
+
+  auto module = loader.loadModuleAtPath(bitcodeFile.str().str(), context);
+  ASSERT_NE(nullptr, module);
+
+  /// Clones do not need the file anymore
+  ASSERT_FALSE(sys::fs::remove(bitcodeFile));
+
+  llvm::LLVMContext cloneContext;
+  auto clone = module->clone(cloneContext);
+  ASSERT_NE(nullptr, clone);
+  ASSERT_EQ(module->getModule()->size(), clone->getModule()->size());
+
+  auto lazyClone = module->lazyClone(cloneContext);
+  ASSERT_NE(nullptr, lazyClone);
+
+  auto definition = std::find_if(lazyClone->getModule()->begin(),
+                                 lazyClone->getModule()->end(),
+                                 [](Function &function) {
+                                   return function.isMaterializable();
+                                 });
+  ASSERT_NE(lazyClone->getModule()->end(), definition);
+  ASSERT_TRUE(definition->empty());
+
+  ASSERT_TRUE(llvm_compat::materializeAll(*lazyClone->getModule()));
+  ASSERT_FALSE(definition->empty());
+}
+
+TEST(ModuleLoaderTest, loadsFunctionBodiesLazily) {
+  llvm::LLVMContext context;
+  ModuleLoader loader;
+
+  auto module = loader.loadModuleAtPath(testModuleFactory.testerModulePath_Bitcode(),
+                                        context);
+  ASSERT_NE(nullptr, module);
+  ASSERT_LT(0U, module->getBitcodeSize());
+
+  auto definition = std::find_if(module->getModule()->begin(),
+                                 module->getModule()->end(),
+                                 [](Function &function) {
+                                   return !function.isDeclaration();
+                                 });
+  ASSERT_NE(module->getModule()->end(), definition);
+  ASSERT_TRUE(definition->isMaterializable());
+  ASSERT_TRUE(definition->empty());
+
+  ASSERT_TRUE(llvm_compat::materialize(*definition));
+  ASSERT_FALSE(definition->empty());
+}
@@ -0,0 +1,154 @@
+#include "Parallelization/MutantPipeline.h"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace mull;
+
+class SquareNumberTask {
+public:
+  using In = const std::vector<int>;
+  using Compiled = int;
+
+  explicit SquareNumberTask(std::atomic<int> &finished, int delay = 0)
+      : finished(finished), delay(delay) {}
+
+  int compile(int number) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(delay));
+    return number * number;
+  }
+
+  void finish() {
+    finished++;
+  }
+
+  std::atomic<int> &finished;
+  int delay;
+};
+
+class CollectNumberTask {
+public:
+  using Out = std::vector<int>;
+
+  explicit CollectNumberTask(std::atomic<int> &finished) : finished(finished) {}
+
+  void execute(int &number, Out &storage) {
+    storage.push_back(number);
+  }
+
+  void finish() {
+    finished++;
+  }
+
+  std::atomic<int> &finished;
+};
+
+static std::vector<int> squares(const std::vector<int> &numbers) {
+  std::vector<int> result;
+  for (auto number : numbers) {
+    result.push_back(number * number);
+  }
+  return result;
+}
+
+TEST(MutantPipeline, moreCompilersThanExecutors) {
+  std::atomic<int> compilersFinished(0);
+  std::atomic<int> executorsFinished(0);
+
+  std::vector<SquareNumberTask> compilationTasks;
+  for (int i = 0; i < 4; i++) {
+    compilationTasks.emplace_back(compilersFinished);
+  }
+  std::vector<CollectNumberTask> executionTasks;
+  executionTasks.emplace_back(executorsFinished);
+
+  std::vector<int> in;
+  for (int i = 0; i < 100; i++) {
+    in.push_back(i);
+  }
+  std::vector<int> out;
+
+  MutantPipeline<SquareNumberTask, CollectNumberTask>
+    pipeline("squares", in, out, std::move(compilationTasks), std::move(executionTasks));
+  pipeline.execute();
+
+  std::sort(out.begin(), out.end());
+  ASSERT_EQ(squares(in), out);
+  ASSERT_EQ(4, compilersFinished.load());
+  ASSERT_EQ(1, executorsFinished.load());
+}
+
+TEST(MutantPipeline, moreWorkersThanMutants) {
+  std::atomic<int> compilersFinished(0);
+  std::atomic<int> executorsFinished(0);
+
+  std::vector<SquareNumberTask> compilationTasks;
+  std::vector<CollectNumberTask> executionTasks;
+  for (int i = 0; i < 8; i++) {
+    compilationTasks.emplace_back(compilersFinished);
+    executionTasks.emplace_back(executorsFinished);
+  }
+
+  std::vector<int> in({ 1, 2, 3 });
+  std::vector<int> out;
+
+  MutantPipeline<SquareNumberTask, CollectNumberTask>
+    pipeline("squares", in, out, std::move(compilationTasks), std::move(executionTasks));
+  pipeline.execute();
+
+  std::sort(out.begin(), out.end());
+  ASSERT_EQ(squares(in), out);
+  ASSERT_EQ(3, compilersFinished.load());
+  ASSERT_EQ(3, executorsFinished.load());
+}
+
+/// The executors keep waiting while a slow compiler is still running,
+/// even after the other compilers have run out of mutants
+TEST(MutantPipeline, closesQueueAfterLastCompiler) {
+  std::atomic<int> compilersFinished(0);
+  std::atomic<int> executorsFinished(0);
+
+  std::vector<SquareNumberTask> compilationTasks;
+  compilationTasks.emplace_back(compilersFinished);
+  compilationTasks.emplace_back(compilersFinished, 50);
+  std::vector<CollectNumberTask> executionTasks;
+  executionTasks.emplace_back(executorsFinished);
+  executionTasks.emplace_back(executorsFinished);
+
+  std::vector<int> in({ 1, 2, 3, 4, 5, 6 });
+  std::vector<int> out;
+
+  MutantPipeline<SquareNumberTask, CollectNumberTask>
+    pipeline("squares", in, out, std::move(compilationTasks), std::move(executionTasks));
+  pipeline.execute();
+
+  std::sort(out.begin(), out.end());
+  ASSERT_EQ(squares(in), out);
+  ASSERT_EQ(2, compilersFinished.load());
+  ASSERT_EQ(2, executorsFinished.load());
+}
+
+TEST(MutantPipeline, emptyInput) {
+  std::atomic<int> compilersFinished(0);
+  std::atomic<int> executorsFinished(0);
+
+  std::vector<SquareNumberTask> compilationTasks;
+  compilationTasks.emplace_back(compilersFinished);
+  std::vector<CollectNumberTask> executionTasks;
+  executionTasks.emplace_back(executorsFinished);
+
+  std::vector<int> in;
+  std::vector<int> out;
+
+  MutantPipeline<SquareNumberTask, CollectNumberTask>
+    pipeline("squares", in, out, std::move(compilationTasks), std::move(executionTasks));
+  pipeline.execute();
+
+  ASSERT_TRUE(out.empty());
+  ASSERT_EQ(0, compilersFinished.load());
+}
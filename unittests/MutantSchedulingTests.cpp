@@ -0,0 +1,172 @@
+#include "Driver.h"
+#include "MutationPoint.h"
+#include "Mutators/MathSubMutator.h"
+#include "Parallelization/Tasks/MutantExecutionTask.h"
+#include "SimpleTest/SimpleTest_Test.h"
+#include "SourceLocation.h"
+#include "TestModuleFactory.h"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+#include <vector>
+
+using namespace mull;
+using namespace llvm;
+
+static TestModuleFactory TestModuleFactory;
+
+/// Only the timing of the test matters for the scheduling. The running time
+/// is in milliseconds, the CPU time is in microseconds.
+static std::unique_ptr<Test> testRunningFor(long long runningTime,
+                                            long long cpuTime = 0) {
+  auto test = make_unique<SimpleTest_Test>(nullptr);
+  ExecutionResult result;
+  result.status = ExecutionStatus::Passed;
+  result.runningTime = runningTime;
+  result.cpuTime = cpuTime;
+  test->setExecutionResult(result);
+  return std::move(test);
+}
+
+class MutantScheduling : public ::testing::Test {
+protected:
+  void SetUp() override {
+    module = TestModuleFactory.create_SimpleTest_MathSub_Module();
+  }
+
+  MutationPoint *createMutationPoint(int index) {
+    MutationPointAddress address(0, 0, index);
+    points.push_back(make_unique<MutationPoint>(&mutator, address, nullptr,
+                                                module.get(), "",
+                                                SourceLocation::nullSourceLocation()));
+    return points.back().get();
+  }
+
+  std::unique_ptr<MullModule> module;
+  MathSubMutator mutator;
+  std::vector<std::unique_ptr<MutationPoint>> points;
+};
+
+TEST_F(MutantScheduling, longestFirst_sortsByRunningTimeOfTests) {
+  auto shortTest = testRunningFor(10);
+  auto longTest = testRunningFor(100);
+
+  MutationPoint *cheap = createMutationPoint(0);
+  cheap->addReachableTest(shortTest.get(), 1);
+
+  MutationPoint *expensive = createMutationPoint(1);
+  expensive->addReachableTest(longTest.get(), 1);
+
+  /// The costs of all the tests reaching a mutant add up
+  MutationPoint *medium = createMutationPoint(2);
+  medium->addReachableTest(shortTest.get(), 1);
+  medium->addReachableTest(shortTest.get(), 2);
+
+  auto sorted = Driver::longestFirst({ cheap, medium, expensive });
+
+  ASSERT_EQ(3U, sorted.size());
+  ASSERT_EQ(expensive, sorted[0]);
+  ASSERT_EQ(medium, sorted[1]);
+  ASSERT_EQ(cheap, sorted[2]);
+}
+
+TEST_F(MutantScheduling, longestFirst_keepsOrderOfTies) {
+  auto test = testRunningFor(10);
+  /// Tests without any measured time still count
+  auto instantTest = testRunningFor(0);
+
+  MutationPoint *first = createMutationPoint(0);
+  first->addReachableTest(test.get(), 1);
+  MutationPoint *second = createMutationPoint(1);
+  second->addReachableTest(test.get(), 1);
+  MutationPoint *instant = createMutationPoint(2);
+  instant->addReachableTest(instantTest.get(), 1);
+  MutationPoint *unreachable = createMutationPoint(3);
+  MutationPoint *third = createMutationPoint(4);
+  third->addReachableTest(test.get(), 1);
+
+  auto sorted = Driver::longestFirst({ unreachable, first, instant, second, third });
+
+  ASSERT_EQ(5U, sorted.size());
+  ASSERT_EQ(first, sorted[0]);
+  ASSERT_EQ(second, sorted[1]);
+  ASSERT_EQ(third, sorted[2]);
+  ASSERT_EQ(instant, sorted[3]);
+  ASSERT_EQ(unreachable, sorted[4]);
+}
+
+TEST_F(MutantScheduling, longestFirst_ranksShortTestsByCpuTime) {
+  /// Both finished within a millisecond
+  auto shortTest = testRunningFor(0, 20);
+  auto longerTest = testRunningFor(0, 700);
+  /// Measured before the CPU time was recorded
+  auto oldTest = testRunningFor(1);
+
+  MutationPoint *cheap = createMutationPoint(0);
+  cheap->addReachableTest(shortTest.get(), 1);
+  MutationPoint *expensive = createMutationPoint(1);
+  expensive->addReachableTest(longerTest.get(), 1);
+  MutationPoint *old = createMutationPoint(2);
+  old->addReachableTest(oldTest.get(), 1);
+
+  auto sorted = Driver::longestFirst({ cheap, expensive, old });
+
+  ASSERT_EQ(3U, sorted.size());
+  ASSERT_EQ(old, sorted[0]);
+  ASSERT_EQ(expensive, sorted[1]);
+  ASSERT_EQ(cheap, sorted[2]);
+}
+
+TEST_F(MutantScheduling, orderedReachableTests_keepsOrderWithoutFailFast) {
+  auto slowTest = testRunningFor(100);
+  auto fastTest = testRunningFor(1);
+
+  MutationPoint *point = createMutationPoint(0);
+  point->addReachableTest(slowTest.get(), 1);
+  point->addReachableTest(fastTest.get(), 1);
+
+  auto tests = MutantExecutionTask::orderedReachableTests(point, false);
+
+  ASSERT_EQ(2U, tests.size());
+  ASSERT_EQ(slowTest.get(), tests[0].first);
+  ASSERT_EQ(fastTest.get(), tests[1].first);
+}
+
+TEST_F(MutantScheduling, orderedReachableTests_sortsByTimeAndDistance) {
+  auto slowTest = testRunningFor(100);
+  auto fastTest = testRunningFor(10);
+  auto distantTest = testRunningFor(10);
+  auto tiedTest = testRunningFor(5);
+
+  /// Scores are milliseconds * (distance + 1): 200, 20, 110, and 20
+  MutationPoint *point = createMutationPoint(0);
+  point->addReachableTest(slowTest.get(), 1);
+  point->addReachableTest(fastTest.get(), 1);
+  point->addReachableTest(distantTest.get(), 10);
+  point->addReachableTest(tiedTest.get(), 3);
+
+  auto tests = MutantExecutionTask::orderedReachableTests(point, true);
+
+  ASSERT_EQ(4U, tests.size());
+  ASSERT_EQ(fastTest.get(), tests[0].first);
+  ASSERT_EQ(tiedTest.get(), tests[1].first);
+  ASSERT_EQ(distantTest.get(), tests[2].first);
+  ASSERT_EQ(slowTest.get(), tests[3].first);
+  ASSERT_EQ(10, tests[2].second);
+}
+
+TEST_F(MutantScheduling, orderedReachableTests_ranksShortTestsByCpuTime) {
+  auto slowerTest = testRunningFor(0, 900);
+  auto fasterTest = testRunningFor(0, 30);
+
+  MutationPoint *point = createMutationPoint(0);
+  point->addReachableTest(slowerTest.get(), 1);
+  point->addReachableTest(fasterTest.get(), 1);
+
+  auto tests = MutantExecutionTask::orderedReachableTests(point, true);
+
+  ASSERT_EQ(2U, tests.size());
+  ASSERT_EQ(fasterTest.get(), tests[0].first);
+  ASSERT_EQ(slowerTest.get(), tests[1].first);
+}
@@ -0,0 +1,160 @@
+#include "MutationHistory.h"
+#include "MullModule.h"
+#include "MutationPoint.h"
+#include "Mutators/MathSubMutator.h"
+#include "SimpleTest/SimpleTest_Test.h"
+#include "SourceLocation.h"
+#include "TestModuleFactory.h"
+
+#include <llvm/AsmParser/Parser.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/SourceMgr.h>
+
+#include "gtest/gtest.h"
+
+using namespace llvm;
+using namespace mull;
+
+static std::string temporaryDatabase() {
+  SmallString<128> path;
+  sys::fs::createTemporaryFile("mull-history", "sqlite", path);
+  return path.str().str();
+}
+
+static std::unique_ptr<Module> parseModule(const char *source, LLVMContext &context) {
+  SMDiagnostic error;
+  auto module = parseAssemblyString(source, error, context);
+  assert(module && "Cannot parse the test module");
+  return module;
+}
+
+static std::string testKey(const char *source) {
+  LLVMContext context;
+  auto module = parseModule(source, context);
+  Function *test = module->getFunction("test_sum");
+
+  SimpleTest_Test simpleTest(test);
+  simpleTest.setExecutedFunctions({ test, module->getFunction("sum") });
+
+  MutationHistory history("");
+  return history.testKey(simpleTest);
+}
+
+TEST(MutationHistory, reusesSavedResults) {
+  std::string path = temporaryDatabase();
+
+  ExecutionResult result;
+  result.status = ExecutionStatus::Failed;
+  result.exitStatus = 1;
+  result.runningTime = 42;
+  result.stdoutOutput = "out";
+  result.stderrOutput = "err";
+
+  {
+    MutationHistory history(path);
+    ASSERT_TRUE(history.isEnabled());
+    history.record("mutant", "test", result);
+    history.save();
+  }
+
+  MutationHistory history(path);
+  ExecutionResult previous;
+  ASSERT_TRUE(history.lookup("mutant", "test", previous));
+  ASSERT_EQ(ExecutionStatus::Failed, previous.status);
+  ASSERT_EQ(1, previous.exitStatus);
+  ASSERT_EQ(42, previous.runningTime);
+  ASSERT_EQ("out", previous.stdoutOutput);
+  ASSERT_EQ("err", previous.stderrOutput);
+
+  ASSERT_FALSE(history.lookup("mutant", "another test", previous));
+
+  sys::fs::remove(path);
+}
+
+TEST(MutationHistory, dropsUnusedResults) {
+  std::string path = temporaryDatabase();
+  ExecutionResult result;
+  result.status = ExecutionStatus::Passed;
+
+  {
+    MutationHistory history(path);
+    history.record("first", "test", result);
+    history.record("second", "test", result);
+    history.save();
+  }
+
+  {
+    MutationHistory history(path);
+    ExecutionResult previous;
+    ASSERT_TRUE(history.lookup("first", "test", previous));
+    history.save();
+  }
+
+  MutationHistory history(path);
+  ExecutionResult previous;
+  ASSERT_TRUE(history.lookup("first", "test", previous));
+  ASSERT_FALSE(history.lookup("second", "test", previous));
+
+  sys::fs::remove(path);
+}
+
+TEST(MutationHistory, testKeyDependsOnCodeOnly) {
+  const char *original = R"(
+    define i32 @sum(i32 %a, i32 %b) {
+    entry:
+      %result = add i32 %a, %b
+      ret i32 %result
+    }
+    define i32 @test_sum() {
+      %value = call i32 @sum(i32 2, i32 3)
+      ret i32 %value
+    }
+  )";
+
+  const char *renamed = R"(
+    define i32 @sum(i32 %x, i32 %y) {
+    start:
+      %sum = add i32 %x, %y
+      ret i32 %sum
+    }
+    define i32 @test_sum() {
+      %1 = call i32 @sum(i32 2, i32 3)
+      ret i32 %1
+    }
+  )";
+
+  const char *changed = R"(
+    define i32 @sum(i32 %a, i32 %b) {
+    entry:
+      %result = sub i32 %a, %b
+      ret i32 %result
+    }
+    define i32 @test_sum() {
+      %value = call i32 @sum(i32 2, i32 3)
+      ret i32 %value
+    }
+  )";
+
+  ASSERT_EQ(testKey(original), testKey(renamed));
+  ASSERT_NE(testKey(original), testKey(changed));
+}
+
+TEST(MutationHistory, mutantKeyDependsOnSettings) {
+  TestModuleFactory factory;
+  auto module = factory.create_SimpleTest_MathSub_Module();
+  Function *mathSub = module->getModule()->getFunction("math_sub");
+
+  MutationPointAddress address(MutationPointAddress::getFunctionIndex(mathSub), 0, 0);
+  MathSubMutator mutator;
+  MutationPoint point(&mutator, address, nullptr, module.get(), "diagnostics",
+                      SourceLocation::nullSourceLocation());
+
+  MutationHistory history("", "fail_fast=0");
+  MutationHistory sameSettings("", "fail_fast=0");
+  MutationHistory failFast("", "fail_fast=1");
+
+  ASSERT_EQ(history.mutantKey(point), sameSettings.mutantKey(point));
+  ASSERT_NE(history.mutantKey(point), failFast.mutantKey(point));
+}
@@ -0,0 +1,98 @@
+#include "MutationJournal.h"
+
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include "gtest/gtest.h"
+
+using namespace llvm;
+using namespace mull;
+
+static std::string temporaryJournal() {
+  SmallString<128> path;
+  sys::fs::createTemporaryFile("mull-journal", "txt", path);
+  return path.str().str();
+}
+
+static ExecutionResult failedResult() {
+  ExecutionResult result;
+  result.status = ExecutionStatus::Failed;
+  result.exitStatus = 1;
+  result.runningTime = 42;
+  result.stdoutOutput = "line\nanother line";
+  result.stderrOutput = "err";
+  return result;
+}
+
+TEST(MutationJournal, resumesRecordedResults) {
+  std::string path = temporaryJournal();
+
+  {
+    MutationJournal journal(path, false);
+    ASSERT_TRUE(journal.isEnabled());
+    journal.record("mutant", "test", failedResult());
+  }
+
+  MutationJournal journal(path, true);
+  ASSERT_EQ(1U, journal.size());
+
+  ExecutionResult result;
+  ASSERT_TRUE(journal.lookup("mutant", "test", result));
+  ASSERT_EQ(ExecutionStatus::Failed, result.status);
+  ASSERT_EQ(1, result.exitStatus);
+  ASSERT_EQ(42, result.runningTime);
+  ASSERT_EQ("line\nanother line", result.stdoutOutput);
+  ASSERT_EQ("err", result.stderrOutput);
+  ASSERT_FALSE(journal.lookup("mutant", "another test", result));
+
+  sys::fs::remove(path);
+}
+
+TEST(MutationJournal, startsOverWithoutResume) {
+  std::string path = temporaryJournal();
+
+  {
+    MutationJournal journal(path, false);
+    journal.record("mutant", "test", failedResult());
+  }
+
+  {
+    MutationJournal journal(path, false);
+    ASSERT_EQ(0U, journal.size());
+  }
+
+  MutationJournal journal(path, true);
+  ExecutionResult result;
+  ASSERT_FALSE(journal.lookup("mutant", "test", result));
+
+  sys::fs::remove(path);
+}
+
+TEST(MutationJournal, dropsIncompleteRecord) {
+  std::string path = temporaryJournal();
+
+  {
+    MutationJournal journal(path, false);
+    journal.record("mutant", "test", failedResult());
+  }
+
+  {
+    std::error_code error;
+    raw_fd_ostream stream(path, error, sys::fs::F_Append);
+    stream << "6:mutant 4:te";
+  }
+
+  {
+    MutationJournal journal(path, true);
+    ASSERT_EQ(1U, journal.size());
+    journal.record("mutant", "another test", failedResult());
+  }
+
+  MutationJournal journal(path, true);
+  ExecutionResult result;
+  ASSERT_EQ(2U, journal.size());
+  ASSERT_TRUE(journal.lookup("mutant", "test", result));
+  ASSERT_TRUE(journal.lookup("mutant", "another test", result));
+
+  sys::fs::remove(path);
+}
@@ -1,4 +1,9 @@
 #include "Mutators/MutatorsFactory.h"
+#include "MutationPoint.h"
+#include "SourceLocation.h"
+#include "TestModuleFactory.h"
+
+#include <llvm/IR/InstIterator.h>
 
 #include "gtest/gtest.h"
 
@@ -255,3 +260,45 @@ TEST(MutatorsFactory, UniqueMutators) {
     ASSERT_NE(searchResult, mutators.end());
   }
 }
+
+TEST(MutatorsFactory, CanMutateOpcode) {
+  /// The search only passes instructions with the opcodes a mutator claims,
+  /// mutation points must never be found in other instructions
+  TestModuleFactory testModuleFactory;
+  std::vector<std::unique_ptr<MullModule>> modules;
+  modules.push_back(testModuleFactory.create_SimpleTest_CountLetters_Module());
+  modules.push_back(testModuleFactory.create_SimpleTest_MathSub_Module());
+  modules.push_back(testModuleFactory.create_SimpleTest_MathMul_Module());
+  modules.push_back(testModuleFactory.create_SimpleTest_MathDiv_Module());
+  modules.push_back(testModuleFactory.create_SimpleTest_NegateCondition_Testee_Module());
+  modules.push_back(testModuleFactory.create_SimpleTest_RemoveVoidFunction_Testee_Module());
+  modules.push_back(testModuleFactory.create_SimpleTest_ANDORReplacement_Module());
+  modules.push_back(testModuleFactory.create_SimpleTest_ScalarValue_Module());
+  modules.push_back(testModuleFactory.create_SimpleTest_ReplaceAssignment_Module());
+  modules.push_back(testModuleFactory.create_SimpleTest_ReplaceCall_Module());
+  modules.push_back(testModuleFactory.create_ConditionalsBoundaryMutator_Module());
+
+  MutatorsFactory factory;
+  vector<unique_ptr<Mutator>> mutators = factory.mutators({ "all" });
+  ASSERT_FALSE(mutators.empty());
+
+  for (auto &module : modules) {
+    for (auto &function : *module->getModule()) {
+      int functionIndex = MutationPointAddress::getFunctionIndex(&function);
+      for (auto &instruction : instructions(function)) {
+        MutationPointAddress address(functionIndex, 0, 0);
+        SourceLocation location = SourceLocation::nullSourceLocation();
+
+        for (auto &mutator : mutators) {
+          unique_ptr<MutationPoint> point(
+            mutator->getMutationPoint(module.get(), address, &instruction, location));
+          if (point) {
+            EXPECT_TRUE(mutator->canMutateOpcode(instruction.getOpcode()))
+              << mutator->getUniqueIdentifier() << ": "
+              << instruction.getOpcodeName();
+          }
+        }
+      }
+    }
+  }
+}
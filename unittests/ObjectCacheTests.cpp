@@ -0,0 +1,193 @@
+#include "Instrumentation/CallTreeCache.h"
+#include "SimpleTest/SimpleTest_Test.h"
+#include "Toolchain/Compiler.h"
+#include "Toolchain/ObjectCache.h"
+#include "Toolchain/ObjectFileMapping.h"
+#include "Config.h"
+#include "Context.h"
+#include "Testee.h"
+#include "TestModuleFactory.h"
+
+#include <llvm/ExecutionEngine/ExecutionEngine.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/TargetSelect.h>
+
+#include "gtest/gtest.h"
+
+#include <unistd.h>
+#include <utime.h>
+
+using namespace llvm;
+using namespace llvm::object;
+using namespace mull;
+
+static TestModuleFactory TestModuleFactory;
+
+static std::unique_ptr<TargetMachine> nativeTargetMachine() {
+  InitializeNativeTarget();
+  InitializeNativeTargetAsmPrinter();
+  InitializeNativeTargetAsmParser();
+
+  return std::unique_ptr<TargetMachine>(
+    EngineBuilder().selectTarget(Triple(), "", "", SmallVector<std::string, 1>()));
+}
+
+static std::vector<std::string> cachedFiles(const std::string &directory) {
+  std::vector<std::string> files;
+  std::error_code error;
+  for (sys::fs::directory_iterator it(directory, error), end;
+       it != end && !error;
+       it.increment(error)) {
+    files.push_back(it->path());
+  }
+  return files;
+}
+
+static uint64_t fileSize(const std::string &path) {
+  uint64_t size = 0;
+  sys::fs::file_size(path, size);
+  return size;
+}
+
+class ObjectCacheTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    SmallString<128> path;
+    ASSERT_FALSE(sys::fs::createUniqueDirectory("mull-object-cache", path));
+    directory = path.str().str();
+    machine = nativeTargetMachine();
+    module = TestModuleFactory.create_SimpleTest_CountLettersTest_Module();
+    object = compiler.compileModule(module->getModule(), *machine);
+    ASSERT_NE(nullptr, object.getBinary());
+  }
+
+  void TearDown() override {
+    sys::fs::remove_directories(directory);
+  }
+
+  std::string directory;
+  std::unique_ptr<TargetMachine> machine;
+  std::unique_ptr<MullModule> module;
+  Compiler compiler;
+  OwningBinary<ObjectFile> object;
+};
+
+TEST_F(ObjectCacheTest, sharedBetweenInstances) {
+  mull::ObjectCache writer(true, directory, 0, *machine);
+  ASSERT_EQ(nullptr, writer.getInstrumentedObject(*module, 0).getBinary());
+  writer.putInstrumentedObject(object, *module, 0);
+
+  mull::ObjectCache reader(true, directory, 0, *machine);
+  auto cached = reader.getInstrumentedObject(*module, 0);
+  ASSERT_NE(nullptr, cached.getBinary());
+  ASSERT_EQ(object.getBinary()->getData(), cached.getBinary()->getData());
+
+  /// A different offset is a different object
+  ASSERT_EQ(nullptr, reader.getInstrumentedObject(*module, 1).getBinary());
+
+  ASSERT_EQ(1U, writer.statistics().misses);
+  ASSERT_EQ(1U, writer.statistics().writes);
+  ASSERT_EQ(1U, reader.statistics().hits);
+  ASSERT_EQ(1U, reader.statistics().misses);
+}
+
+TEST_F(ObjectCacheTest, rejectsTruncatedObject) {
+  mull::ObjectCache cache(true, directory, 0, *machine);
+  cache.putInstrumentedObject(object, *module, 0);
+
+  auto files = cachedFiles(directory);
+  ASSERT_EQ(1U, files.size());
+  ASSERT_EQ(0, truncate(files.front().c_str(), fileSize(files.front()) / 2));
+
+  ASSERT_EQ(nullptr, cache.getInstrumentedObject(*module, 0).getBinary());
+  ASSERT_EQ(1U, cache.statistics().corrupted);
+  ASSERT_TRUE(cachedFiles(directory).empty());
+}
+
+TEST_F(ObjectCacheTest, evictsLeastRecentlyUsed) {
+  {
+    mull::ObjectCache cache(true, directory, 0, *machine);
+    cache.putInstrumentedObject(object, *module, 0);
+  }
+
+  auto files = cachedFiles(directory);
+  ASSERT_EQ(1U, files.size());
+  std::string oldest = files.front();
+  uint64_t size = fileSize(oldest);
+
+  struct utimbuf lastUse;
+  lastUse.actime = 1;
+  lastUse.modtime = 1;
+  ASSERT_EQ(0, utime(oldest.c_str(), &lastUse));
+
+  mull::ObjectCache cache(true, directory, size + size / 2, *machine);
+  cache.putInstrumentedObject(object, *module, 1);
+
+  files = cachedFiles(directory);
+  ASSERT_EQ(1U, files.size());
+  ASSERT_NE(oldest, files.front());
+  ASSERT_EQ(1U, cache.statistics().evictions);
+  ASSERT_NE(nullptr, cache.getInstrumentedObject(*module, 1).getBinary());
+}
+
+TEST(ObjectFileMapping, residentSize) {
+  std::string data(3 * 4096 + 17, 'x');
+  ASSERT_EQ(data.size(), ObjectFileMapping::residentSize(data));
+  ASSERT_EQ(0U, ObjectFileMapping::residentSize(StringRef()));
+}
+
+TEST_F(ObjectCacheTest, restoresCallTrees) {
+  Config config;
+  Context context;
+  context.addModule(TestModuleFactory.create_SimpleTest_CountLettersTest_Module());
+  Module *program = context.getModules().front()->getModule();
+
+  std::vector<Function *> functions;
+  for (auto &function : *program) {
+    if (!function.isDeclaration()) {
+      functions.push_back(&function);
+    }
+  }
+  ASSERT_LE(2U, functions.size());
+
+  ExecutionResult result;
+  result.status = ExecutionStatus::Passed;
+  result.runningTime = 42;
+  result.stdoutOutput = "out";
+
+  std::vector<std::unique_ptr<mull::Test>> tests;
+  tests.emplace_back(make_unique<SimpleTest_Test>(functions[0]));
+  tests.front()->setExecutionResult(result);
+  tests.front()->setExecutedFunctions({ functions[0], functions[1] });
+
+  std::vector<std::unique_ptr<Testee>> testees;
+  testees.emplace_back(make_unique<Testee>(functions[0], tests.front().get(), 0));
+  testees.emplace_back(make_unique<Testee>(functions[1], tests.front().get(), 1));
+
+  mull::ObjectCache cache(true, directory, 0, *machine);
+  CallTreeCache callTreeCache(cache, context, config);
+  callTreeCache.store(tests, testees);
+
+  std::vector<std::unique_ptr<mull::Test>> foundTests;
+  foundTests.emplace_back(make_unique<SimpleTest_Test>(functions[0]));
+  std::vector<std::unique_ptr<Testee>> restoredTestees;
+  ASSERT_TRUE(callTreeCache.load(foundTests, restoredTestees));
+
+  mull::Test *test = foundTests.front().get();
+  ASSERT_EQ(ExecutionStatus::Passed, test->getExecutionResult().status);
+  ASSERT_EQ(42, test->getExecutionResult().runningTime);
+  ASSERT_EQ("out", test->getExecutionResult().stdoutOutput);
+  ASSERT_EQ(2U, test->getExecutedFunctions().size());
+
+  ASSERT_EQ(2U, restoredTestees.size());
+  ASSERT_EQ(functions[1], restoredTestees[1]->getTesteeFunction());
+  ASSERT_EQ(test, restoredTestees[1]->getTest());
+  ASSERT_EQ(1, restoredTestees[1]->getDistance());
+
+  /// Another set of tests is run from scratch
+  std::vector<std::unique_ptr<mull::Test>> otherTests;
+  otherTests.emplace_back(make_unique<SimpleTest_Test>(functions[1]));
+  std::vector<std::unique_ptr<Testee>> otherTestees;
+  ASSERT_FALSE(callTreeCache.load(otherTests, otherTestees));
+  ASSERT_TRUE(otherTestees.empty());
+}
@@ -0,0 +1,66 @@
+#include "Reporters/ResultStream.h"
+#include "MutationResult.h"
+
+#include <llvm/ADT/STLExtras.h>
+
+#include "gtest/gtest.h"
+
+#include <thread>
+#include <vector>
+
+using namespace mull;
+using namespace llvm;
+
+TEST(ResultStream, consumesEveryResultInOrder) {
+  std::vector<std::unique_ptr<MutationResult>> results;
+  for (int i = 0; i < 100; i++) {
+    ExecutionResult executionResult;
+    executionResult.runningTime = i;
+    results.emplace_back(make_unique<MutationResult>(executionResult, nullptr, 0, nullptr));
+  }
+
+  std::vector<long long> consumed;
+  ResultStream stream([&](MutationResult &result) {
+    consumed.push_back(result.getExecutionResult().runningTime);
+  }, 4);
+
+  for (auto &result : results) {
+    stream.push(result.get());
+  }
+  stream.finish();
+
+  ASSERT_EQ(100U, consumed.size());
+  for (int i = 0; i < 100; i++) {
+    ASSERT_EQ(i, consumed[i]);
+  }
+}
+
+TEST(ResultStream, acceptsResultsFromSeveralThreads) {
+  const int threadsCount = 4;
+  const int resultsPerThread = 250;
+
+  std::vector<std::unique_ptr<MutationResult>> results;
+  for (int i = 0; i < threadsCount * resultsPerThread; i++) {
+    results.emplace_back(make_unique<MutationResult>(ExecutionResult(), nullptr, 0, nullptr));
+  }
+
+  int consumed = 0;
+  ResultStream stream([&](MutationResult &result) {
+    consumed++;
+  }, 8);
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < threadsCount; t++) {
+    threads.emplace_back([&, t]() {
+      for (int i = 0; i < resultsPerThread; i++) {
+        stream.push(results[t * resultsPerThread + i].get());
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  stream.finish();
+
+  ASSERT_EQ(threadsCount * resultsPerThread, consumed);
+}
@@ -1,4 +1,5 @@
 #include "Config.h"
+#include "ConfigParser.h"
 #include "Context.h"
 #include "Reporters/SQLiteReporter.h"
 #include "Result.h"
@@ -13,10 +14,13 @@
 
 #include "gtest/gtest.h"
 
+#include <algorithm>
+#include <chrono>
 #include <cstring>
 #include <llvm/IR/LLVMContext.h>
 #include <llvm/IR/Module.h>
 #include <llvm/IR/Type.h>
+#include <llvm/Support/FileSystem.h>
 #include <sqlite3.h>
 
 using namespace mull;
@@ -120,7 +124,7 @@ TEST(SQLiteReporter, integrationTest) {
   sqlite3_open(databasePath.c_str(), &database);
 
   {
-    std::string selectQuery = "SELECT * FROM execution_result";
+    std::string selectQuery = "SELECT * FROM execution_result_with_output";
     sqlite3_stmt *selectStmt;
     sqlite3_prepare(database, selectQuery.c_str(), selectQuery.size(), &selectStmt, NULL);
 
@@ -692,3 +696,167 @@ TEST(SQLiteReporter, do_not_emitDebugInfo) {
   sqlite3_close(database);
 }
 
+
+static long long countRows(const std::string &databasePath, const char *query) {
+  sqlite3 *database;
+  sqlite3_open(databasePath.c_str(), &database);
+
+  sqlite3_stmt *selectStmt;
+  sqlite3_prepare(database, query, -1, &selectStmt, NULL);
+
+  long long rows = 0;
+  while (sqlite3_step(selectStmt) == SQLITE_ROW) {
+    rows++;
+  }
+
+  sqlite3_finalize(selectStmt);
+  sqlite3_close(database);
+  return rows;
+}
+
+TEST(SQLiteReporter, storesEachOutputOnce) {
+  TestModuleFactory testModuleFactory;
+
+  Context context;
+  context.addModule(testModuleFactory.create_SimpleTest_CountLettersTest_Module());
+  context.addModule(testModuleFactory.create_SimpleTest_CountLetters_Module());
+
+  llvm::yaml::Input input("report_output: killed\n");
+  Config config = ConfigParser().loadConfig(input);
+  config.normalizeParallelizationConfig();
+
+  std::vector<std::unique_ptr<Mutator>> mutators;
+  mutators.emplace_back(make_unique<MathAddMutator>());
+  MutationsFinder mutationsFinder(std::move(mutators), config);
+  Filter filter;
+
+  SimpleTestFinder testFinder;
+  auto tests = testFinder.findTests(context, filter);
+  mull::Test *test = tests.front().get();
+
+  ExecutionResult testExecutionResult;
+  testExecutionResult.status = Passed;
+  testExecutionResult.stdoutOutput = "banner";
+  test->setExecutionResult(testExecutionResult);
+
+  std::vector<std::unique_ptr<Testee>> testees;
+  testees.emplace_back(make_unique<Testee>(context.lookupDefinedFunction("count_letters"), nullptr, 1));
+  auto mergedTestees = mergeTestees(testees);
+
+  std::vector<MutationPoint *> mutationPoints =
+    mutationsFinder.getMutationPoints(context, mergedTestees, filter);
+  ASSERT_EQ(1U, mutationPoints.size());
+
+  ExecutionResult survived;
+  survived.status = Passed;
+  survived.stdoutOutput = "survived";
+
+  ExecutionResult killed;
+  killed.status = Failed;
+  killed.stdoutOutput = "banner";
+  killed.stderrOutput = "assertion failed";
+
+  std::vector<std::unique_ptr<MutationResult>> mutationResults;
+  mutationResults.push_back(make_unique<MutationResult>(survived, mutationPoints.front(), 1, test));
+  mutationResults.push_back(make_unique<MutationResult>(killed, mutationPoints.front(), 1, test));
+  mutationResults.push_back(make_unique<MutationResult>(killed, mutationPoints.front(), 1, test));
+
+  Result result(std::move(tests), std::move(mutationResults), mutationPoints);
+  SQLiteReporter reporter("outputs");
+  reporter.reportResults(result, config, Metrics());
+
+  /// "banner" and "assertion failed", the output of the survived mutant is dropped
+  ASSERT_EQ(2, countRows(reporter.getDatabasePath(), "select * from output"));
+  ASSERT_EQ(3, countRows(reporter.getDatabasePath(),
+                         "select * from execution_result_with_output where stdout = 'banner'"));
+  ASSERT_EQ(1, countRows(reporter.getDatabasePath(),
+                         "select * from execution_result where stdout_id is null"));
+
+  llvm::sys::fs::remove(reporter.getDatabasePath());
+}
+
+/// Not a regression test, only reports the throughput
+/// of writing and querying a large report.
+/// Run with --gtest_also_run_disabled_tests
+TEST(SQLiteReporter, DISABLED_benchmark_manyExecutionResults) {
+  const int NumberOfResults = 100000;
+
+  TestModuleFactory testModuleFactory;
+
+  Context context;
+  context.addModule(testModuleFactory.create_SimpleTest_CountLettersTest_Module());
+  context.addModule(testModuleFactory.create_SimpleTest_CountLetters_Module());
+  Config config;
+  config.normalizeParallelizationConfig();
+
+  std::vector<std::unique_ptr<Mutator>> mutators;
+  mutators.emplace_back(make_unique<MathAddMutator>());
+  MutationsFinder mutationsFinder(std::move(mutators), config);
+  Filter filter;
+
+  SimpleTestFinder testFinder;
+  auto tests = testFinder.findTests(context, filter);
+  mull::Test *test = tests.front().get();
+
+  std::vector<std::unique_ptr<Testee>> testees;
+  testees.emplace_back(make_unique<Testee>(context.lookupDefinedFunction("count_letters"), nullptr, 1));
+  auto mergedTestees = mergeTestees(testees);
+
+  std::vector<MutationPoint *> mutationPoints =
+    mutationsFinder.getMutationPoints(context, mergedTestees, filter);
+  ASSERT_EQ(1U, mutationPoints.size());
+
+  ExecutionResult executionResult;
+  executionResult.status = Passed;
+  executionResult.runningTime = 1;
+  executionResult.stdoutOutput = std::string(256, 'o');
+  executionResult.stderrOutput = std::string(256, 'e');
+
+  std::vector<std::unique_ptr<MutationResult>> mutationResults;
+  for (int i = 0; i < NumberOfResults; i++) {
+    mutationResults.push_back(make_unique<MutationResult>(executionResult,
+                                                          mutationPoints.front(),
+                                                          1, test));
+  }
+  Result result(std::move(tests), std::move(mutationResults), mutationPoints);
+  Metrics metrics;
+
+  typedef std::chrono::steady_clock Clock;
+  auto rowsPerSecond = [](Clock::time_point begin, long long rows) {
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - begin);
+    return rows * 1000 / std::max(1LL, (long long)elapsed.count());
+  };
+
+  SQLiteReporter streamingReporter("benchmark streamed");
+  auto begin = Clock::now();
+  streamingReporter.beginResults(result.getTests(), result.getMutationPoints(), config);
+  for (auto &mutationResult : result.getMutationResults()) {
+    streamingReporter.reportMutationResult(*mutationResult);
+  }
+  streamingReporter.reportResults(result, config, metrics);
+  llvm::outs() << "Streamed: " << rowsPerSecond(begin, NumberOfResults) << " results/sec\n";
+
+  SQLiteReporter bulkReporter("benchmark bulk");
+  begin = Clock::now();
+  bulkReporter.reportResults(result, config, metrics);
+  llvm::outs() << "Bulk: " << rowsPerSecond(begin, NumberOfResults) << " results/sec\n";
+
+  /// The queries of mull-reporter
+  begin = Clock::now();
+  long long rows = countRows(bulkReporter.getDatabasePath(), R"query(
+    select t.unique_id, ex.status, mp.diagnostics
+    from test as t
+    join execution_result as ex on t.unique_id = ex.test_id
+    join mutation_point as mp on ex.mutation_point_id = mp.unique_id
+    where mutation_point_id <> "";
+  )query");
+  llvm::outs() << "Queried: " << rowsPerSecond(begin, rows) << " results/sec\n";
+  ASSERT_EQ(NumberOfResults, rows);
+
+  ASSERT_EQ(NumberOfResults + 1,
+            countRows(streamingReporter.getDatabasePath(),
+                      "select * from execution_result"));
+
+  llvm::sys::fs::remove(streamingReporter.getDatabasePath());
+  llvm::sys::fs::remove(bulkReporter.getDatabasePath());
+}
@@ -0,0 +1,180 @@
+#include "Driver.h"
+#include "Toolchain/Compiler.h"
+#include "Toolchain/JITEngine.h"
+#include "Toolchain/Mangler.h"
+#include "Toolchain/Resolvers/NativeResolver.h"
+
+#include <llvm/AsmParser/Parser.h>
+#include <llvm/ExecutionEngine/ExecutionEngine.h>
+#include <llvm/ExecutionEngine/SectionMemoryManager.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Support/SourceMgr.h>
+#include <llvm/Support/TargetSelect.h>
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+
+using namespace llvm;
+using namespace mull;
+
+class StableObjectFiles : public ::testing::Test {
+protected:
+  void SetUp() override {
+    InitializeNativeTarget();
+    InitializeNativeTargetAsmPrinter();
+    InitializeNativeTargetAsmParser();
+
+    targetMachine.reset(EngineBuilder().selectTarget(Triple(), "", "",
+                                                     SmallVector<std::string, 1>()));
+    mangler = make_unique<mull::Mangler>(targetMachine->createDataLayout());
+  }
+
+  object::ObjectFile *compile(const char *source) {
+    SMDiagnostic error;
+    auto module = parseAssemblyString(source, error, context);
+    assert(module && "Cannot parse the test module");
+    objects.push_back(compiler.compileModule(module.get(), *targetMachine));
+    return objects.back().getBinary();
+  }
+
+  void *symbolAddress(JITEngine &jit, const std::string &name) {
+    auto &symbol = jit.getSymbol(mangler->getNameWithPrefix(name));
+    auto address = llvm_compat::JITSymbolAddress(symbol);
+    return reinterpret_cast<void *>(static_cast<uintptr_t>(address));
+  }
+
+  LLVMContext context;
+  std::unique_ptr<TargetMachine> targetMachine;
+  std::unique_ptr<mull::Mangler> mangler;
+  Compiler compiler;
+  std::vector<object::OwningBinary<object::ObjectFile>> objects;
+};
+
+TEST_F(StableObjectFiles, withoutUnstableDependencies_excludesChains) {
+  auto mutated = compile(R"(
+    define i32 @mutated() {
+      ret i32 1
+    }
+  )");
+  /// Depends on the mutated module through 'direct'
+  auto indirect = compile(R"(
+    declare i32 @direct()
+    define i32 @indirect() {
+      %value = call i32 @direct()
+      ret i32 %value
+    }
+  )");
+  auto direct = compile(R"(
+    declare i32 @mutated()
+    define i32 @direct() {
+      %value = call i32 @mutated()
+      ret i32 %value
+    }
+  )");
+  auto independent = compile(R"(
+    define i32 @independent() {
+      ret i32 2
+    }
+  )");
+
+  /// 'indirect' comes first, so it is only excluded on the second pass
+  auto stable = Driver::withoutUnstableDependencies({ indirect, direct, independent },
+                                                    { mutated });
+
+  ASSERT_EQ(1U, stable.size());
+  ASSERT_EQ(independent, stable.front());
+}
+
+TEST_F(StableObjectFiles, addObjectFiles_resolvesMutantAgainstStableLayer) {
+  auto stable = compile(R"(
+    define i32 @helper() {
+      ret i32 40
+    }
+  )");
+  auto firstMutant = compile(R"(
+    declare i32 @helper()
+    define i32 @compute() {
+      %value = call i32 @helper()
+      %result = add i32 %value, 2
+      ret i32 %result
+    }
+  )");
+  auto secondMutant = compile(R"(
+    declare i32 @helper()
+    define i32 @compute() {
+      %value = call i32 @helper()
+      %result = add i32 %value, 3
+      ret i32 %result
+    }
+  )");
+
+  orc::LocalCXXRuntimeOverrides overrides([&](const char *name) {
+    return mangler->getNameWithPrefix(name);
+  });
+  NativeResolver resolver(overrides);
+  JITEngine jit;
+  jit.setStableObjectFiles({ stable });
+
+  std::vector<object::ObjectFile *> firstObjects({ stable, firstMutant });
+  jit.addObjectFiles(firstObjects, resolver, make_unique<SectionMemoryManager>());
+  void *helper = symbolAddress(jit, "helper");
+  auto compute = (int (*)())symbolAddress(jit, "compute");
+  ASSERT_NE(nullptr, helper);
+  ASSERT_NE(nullptr, compute);
+  ASSERT_EQ(42, compute());
+
+  /// The stable layer is not linked again
+  std::vector<object::ObjectFile *> secondObjects({ stable, secondMutant });
+  jit.addObjectFiles(secondObjects, resolver, make_unique<SectionMemoryManager>());
+  ASSERT_EQ(helper, symbolAddress(jit, "helper"));
+  compute = (int (*)())symbolAddress(jit, "compute");
+  ASSERT_NE(nullptr, compute);
+  ASSERT_EQ(43, compute());
+}
+
+/// A mutant of an inline function defines its own copy, which must be
+/// the one used by the mutant and returned by the engine
+TEST_F(StableObjectFiles, addObjectFiles_prefersMutantLayerForWeakSymbols) {
+  auto stable = compile(R"(
+    define weak_odr i32 @shared() {
+      ret i32 1
+    }
+    define i32 @stable_caller() {
+      %value = call i32 @shared()
+      ret i32 %value
+    }
+  )");
+  auto mutant = compile(R"(
+    define weak_odr i32 @shared() {
+      ret i32 2
+    }
+    define i32 @mutant_caller() {
+      %value = call i32 @shared()
+      ret i32 %value
+    }
+  )");
+
+  orc::LocalCXXRuntimeOverrides overrides([&](const char *name) {
+    return mangler->getNameWithPrefix(name);
+  });
+  NativeResolver resolver(overrides);
+  JITEngine jit;
+  jit.setStableObjectFiles({ stable });
+
+  std::vector<object::ObjectFile *> objectFiles({ stable, mutant });
+  jit.addObjectFiles(objectFiles, resolver, make_unique<SectionMemoryManager>());
+
+  auto shared = (int (*)())symbolAddress(jit, "shared");
+  auto mutantCaller = (int (*)())symbolAddress(jit, "mutant_caller");
+  auto stableCaller = (int (*)())symbolAddress(jit, "stable_caller");
+  ASSERT_NE(nullptr, shared);
+  ASSERT_NE(nullptr, mutantCaller);
+  ASSERT_NE(nullptr, stableCaller);
+
+  ASSERT_EQ(2, shared());
+  ASSERT_EQ(2, mutantCaller());
+  /// Stable object files are linked before any mutant and keep their own copy
+  ASSERT_EQ(1, stableCaller());
+}
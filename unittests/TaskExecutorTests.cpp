@@ -109,3 +109,32 @@ TEST(TaskExecutor, SequentialExecution_EmptyTask_MoreWorkers) {
 
   ASSERT_EQ(expected, out);
 }
+
+TEST(TaskExecutor, ParallelExecution_AddNumber_PreservesOrder) {
+  int workers = 4;
+  std::vector<AddNumberTask> tasks;
+  for (int i = 0; i < workers; i++) {
+    tasks.emplace_back(AddNumberTask());
+  }
+
+  std::vector<int> in;
+  std::vector<int> expected;
+  for (int i = 0; i < 1000; i++) {
+    in.push_back(i);
+    expected.push_back(i + 1);
+  }
+  std::vector<int> out;
+
+  TaskExecutor<AddNumberTask> executor("increment numbers", in, out, std::move(tasks));
+  executor.execute();
+
+  ASSERT_EQ(size_t(1000), out.size());
+  ASSERT_EQ(expected, out);
+}
+
+TEST(TaskExecutor, DynamicBatchSize) {
+  ASSERT_EQ(size_t(1), dynamicBatchSize(1, 4));
+  ASSERT_EQ(size_t(1), dynamicBatchSize(15, 4));
+  ASSERT_EQ(size_t(6), dynamicBatchSize(100, 4));
+  ASSERT_EQ(size_t(62), dynamicBatchSize(1000, 4));
+}
@@ -74,6 +74,7 @@ createModuleFromBitcode(const char *fixtureName,
   }
 
   auto module = make_unique<MullModule>(std::move(llvmModule.get()),
+                                        std::move(bufferOrError.get()),
                                         "fake_hash",
                                         fixtureFullPath);
   return module;
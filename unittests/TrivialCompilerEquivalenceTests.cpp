@@ -0,0 +1,205 @@
+#include "Toolchain/TrivialCompilerEquivalence.h"
+#include "Toolchain/Compiler.h"
+#include "Toolchain/Toolchain.h"
+#include "ConfigParser.h"
+#include "Driver.h"
+#include "ExecutionResult.h"
+#include "Filter.h"
+#include "JunkDetection/JunkDetector.h"
+#include "Metrics/Metrics.h"
+#include "MullModule.h"
+#include "MutationResult.h"
+#include "MutationsFinder.h"
+#include "Mutators/MathAddMutator.h"
+#include "Result.h"
+#include "SimpleTest/SimpleTestFinder.h"
+#include "SimpleTest/SimpleTestRunner.h"
+#include "TestModuleFactory.h"
+
+#include <llvm/AsmParser/Parser.h>
+#if LLVM_VERSION_MAJOR < 4
+#include <llvm/Bitcode/ReaderWriter.h>
+#else
+#include <llvm/Bitcode/BitcodeWriter.h>
+#endif
+#include <llvm/ExecutionEngine/ExecutionEngine.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/SourceMgr.h>
+#include <llvm/Support/TargetSelect.h>
+#include <llvm/Support/YAMLTraits.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+
+using namespace llvm;
+using namespace mull;
+
+/// The first addition in 'sum' is never used, so the code generator drops it
+/// along with any mutation of it
+static const char *SumModule = R"(
+  define i32 @sum(i32 %a, i32 %b) {
+  entry:
+    %unused = add i32 %a, %b
+    %result = add i32 %a, %b
+    ret i32 %result
+  }
+
+  define i32 @test_sum() {
+  entry:
+    %value = call i32 @sum(i32 2, i32 3)
+    %passed = icmp eq i32 %value, 5
+    %result = zext i1 %passed to i32
+    ret i32 %result
+  }
+)";
+
+/// Mutants are cloned from the bitcode of the original module
+static std::unique_ptr<MullModule> moduleFromIR(const char *source,
+                                                LLVMContext &context) {
+  SMDiagnostic error;
+  auto module = parseAssemblyString(source, error, context);
+  assert(module && "Cannot parse the test module");
+  module->setModuleIdentifier("trivial_compiler_equivalence");
+
+  SmallVector<char, 0> bitcode;
+  raw_svector_ostream stream(bitcode);
+  WriteBitcodeToFile(module.get(), stream);
+  auto buffer = MemoryBuffer::getMemBufferCopy(StringRef(bitcode.data(), bitcode.size()),
+                                               "trivial_compiler_equivalence");
+
+  return make_unique<MullModule>(std::move(module), std::move(buffer),
+                                 "fake_hash", "trivial_compiler_equivalence.bc");
+}
+
+/// The mutation points are only compared, never dereferenced
+static MutationPoint *fakeMutationPoint(int &storage) {
+  return reinterpret_cast<MutationPoint *>(&storage);
+}
+
+TEST(TrivialCompilerEquivalence, hash) {
+  ASSERT_EQ(TrivialCompilerEquivalence::hash("object"),
+            TrivialCompilerEquivalence::hash("object"));
+  ASSERT_NE(TrivialCompilerEquivalence::hash("object"),
+            TrivialCompilerEquivalence::hash("another object"));
+}
+
+TEST(TrivialCompilerEquivalence, classify) {
+  int first = 0;
+  int second = 0;
+  int third = 0;
+
+  TrivialCompilerEquivalence equivalence;
+  ASSERT_FALSE(equivalence.hasOriginal("module:1"));
+  equivalence.setOriginal("module:1", "original");
+  ASSERT_TRUE(equivalence.hasOriginal("module:1"));
+
+  ASSERT_EQ(TrivialCompilerEquivalence::Verdict::Equivalent,
+            equivalence.classify("module:1", "original", fakeMutationPoint(first)));
+  ASSERT_EQ(TrivialCompilerEquivalence::Verdict::Unique,
+            equivalence.classify("module:1", "mutant", fakeMutationPoint(second)));
+  ASSERT_EQ(TrivialCompilerEquivalence::Verdict::Duplicate,
+            equivalence.classify("module:1", "mutant", fakeMutationPoint(third)));
+
+  /// The same mutant compiled again, e.g. when its results are recomputed
+  ASSERT_EQ(TrivialCompilerEquivalence::Verdict::Unique,
+            equivalence.classify("module:1", "mutant", fakeMutationPoint(second)));
+
+  ASSERT_EQ(1U, equivalence.equivalentCount());
+  ASSERT_EQ(1U, equivalence.duplicateCount());
+}
+
+TEST(TrivialCompilerEquivalence, classify_ScopesAreSeparate) {
+  int first = 0;
+  int second = 0;
+
+  TrivialCompilerEquivalence equivalence;
+  equivalence.setOriginal("module:1", "original");
+  equivalence.setOriginal("module:2", "another original");
+
+  ASSERT_EQ(TrivialCompilerEquivalence::Verdict::Unique,
+            equivalence.classify("module:2", "original", fakeMutationPoint(first)));
+  ASSERT_EQ(TrivialCompilerEquivalence::Verdict::Unique,
+            equivalence.classify("module:1", "mutant", fakeMutationPoint(first)));
+  ASSERT_EQ(TrivialCompilerEquivalence::Verdict::Unique,
+            equivalence.classify("module:2", "mutant", fakeMutationPoint(second)));
+
+  ASSERT_EQ(0U, equivalence.equivalentCount());
+  ASSERT_EQ(0U, equivalence.duplicateCount());
+}
+
+TEST(TrivialCompilerEquivalence, hash_SameForUnmutatedCode) {
+  InitializeNativeTarget();
+  InitializeNativeTargetAsmPrinter();
+  InitializeNativeTargetAsmParser();
+
+  std::unique_ptr<TargetMachine> targetMachine(
+                                  EngineBuilder().selectTarget(Triple(), "", "",
+                                  SmallVector<std::string, 1>()));
+  Compiler compiler;
+
+  LLVMContext context;
+  auto module = moduleFromIR(SumModule, context);
+
+  LLVMContext firstContext;
+  auto first = module->clone(firstContext);
+  auto firstObject = compiler.compileModule(*first, *targetMachine);
+
+  LLVMContext secondContext;
+  auto second = module->clone(secondContext);
+  auto secondObject = compiler.compileModule(*second, *targetMachine);
+
+  ASSERT_EQ(TrivialCompilerEquivalence::hash(firstObject.getBinary()->getData()),
+            TrivialCompilerEquivalence::hash(secondObject.getBinary()->getData()));
+}
+
+TEST(TrivialCompilerEquivalence, driver_skipsMutantsOptimizedAway) {
+  const char *configYAML = R"(
+test_framework: SimpleTest
+fork: false
+use_cache: false
+trivial_compiler_equivalence: true
+)";
+  yaml::Input input(configYAML);
+  ConfigParser parser;
+  Config config = parser.loadConfig(input);
+
+  LLVMContext context;
+  std::function<std::vector<std::unique_ptr<MullModule>> ()> modules = [&]() {
+    std::vector<std::unique_ptr<MullModule>> modules;
+    modules.push_back(moduleFromIR(SumModule, context));
+    return modules;
+  };
+  FakeModuleLoader loader(context, modules);
+
+  std::vector<std::unique_ptr<Mutator>> mutators;
+  mutators.emplace_back(make_unique<MathAddMutator>());
+  MutationsFinder finder(std::move(mutators), config);
+  SimpleTestFinder testFinder;
+
+  Toolchain toolchain(config);
+  SimpleTestRunner runner(toolchain.mangler());
+  Filter filter;
+  Metrics metrics;
+  NullJunkDetector junkDetector;
+
+  Driver driver(config, loader, testFinder, runner, toolchain, filter, finder, metrics, junkDetector);
+  auto result = driver.Run();
+
+  auto &mutants = result->getMutationResults();
+  ASSERT_EQ(2U, mutants.size());
+
+  std::vector<ExecutionStatus> statuses;
+  for (auto &mutant : mutants) {
+    statuses.push_back(mutant->getExecutionResult().status);
+  }
+  std::sort(statuses.begin(), statuses.end());
+
+  /// The mutant of the unused addition is skipped,
+  /// the other one is run and killed
+  ASSERT_EQ(ExecutionStatus::Failed, statuses[0]);
+  ASSERT_EQ(ExecutionStatus::Equivalent, statuses[1]);
+}